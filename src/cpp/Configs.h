@@ -114,6 +114,8 @@ struct PlotOptions
     int heightMarginSize;
     int initWidth;
     int initHeight;
+    // Resolved from PlotterArgs::programBinaryCache, empty if disabled
+    std::string programBinaryCacheDir = "";
 };
 
 struct BackendCandlestickSettings
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+template <typename Function>
+void parallelFor(std::size_t size, std::size_t minChunkSize, Function function)
+/*
+    Call `function(startIdx, endIdx)` on contiguous chunks covering [0, size), in
+    parallel. Chunks are at least `minChunkSize` so small inputs (the common case
+    when streaming) run on the calling thread, without starting any threads.
+
+    Used for the per-datapoint preparation when a plot is added (interleaving,
+    min / max indexing, LOD levels) and for parsing in readCandleDataCSV. Each
+    thread writes only its own range of the (already allocated) output. The calling
+    thread runs the first chunk. Exceptions are re-thrown on the calling thread.
+ */
+{
+    std::size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t numChunks = std::max<std::size_t>(1, std::min(numThreads, size / std::max<std::size_t>(minChunkSize, 1)));
+
+    if (numChunks == 1)
+    {
+        function(std::size_t(0), size);
+        return;
+    }
+
+    std::size_t chunkSize = (size + numChunks - 1) / numChunks;
+
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(numChunks);
+
+    for (std::size_t i = 1; i < numChunks; i++)
+    {
+        threads.emplace_back([&, i]()
+        {
+            try
+            {
+                function(std::min(i * chunkSize, size), std::min((i + 1) * chunkSize, size));
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+
+    try
+    {
+        function(std::size_t(0), std::min(chunkSize, size));
+    }
+    catch (...)
+    {
+        errors[0] = std::current_exception();
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    for (std::exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -1,16 +1,30 @@
 #include "include/Plotter.h"
 #include "structure/SharedXData.h"
+#include <cmath>
 #include <iostream>
 #include <qboxlayout.h>
 #include <QLibrary>
 #include <QApplication>
-#include <csv.h>
 #include <stdexcept>
 #include <string>
 #include <qapplication.h>
 #include <qwidget.h>
 #include <QPointer>
+#include <QEvent>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <future>
+#include <mutex>
+#include <thread>
 #include "structure/PlotWrapperWidget.h"
+#include "charts/plots/CandlestickPlot.h"
+#include "charts/shaders/ProgramBinaryCache.h"
+#include "charts/plots/ScatterMarkerImages.h"
+#include "charts/GlyphAtlasCache.h"
+#include <QScreen>
+#include <chrono>
 
 
 void checkStringIsValid(std::string str)
@@ -27,6 +41,15 @@ void checkStringIsValid(std::string str)
 }
 
 
+void checkAppendSizes(std::size_t openSize, std::size_t highSize, std::size_t lowSize, std::size_t closeSize)
+{
+    if (!(openSize == closeSize && openSize == lowSize && openSize == highSize))
+    {
+        throw std::invalid_argument("Appended open, high, low, close vectors are not all the same size.");
+    }
+}
+
+
 struct SubKey
 /*
     Used as std::unordered map index, to index active subplot.
@@ -57,6 +80,32 @@ namespace std {
 };
 
 
+class WindowCloseFilter : public QObject
+/*
+    Calls `onClose` when the watched window is closed.
+ */
+{
+public:
+    WindowCloseFilter(std::function<void()> onClose, QObject* parent)
+        : QObject(parent),
+        m_onClose(std::move(onClose))
+    {
+    }
+
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() == QEvent::Close)
+        {
+            m_onClose();
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    std::function<void()> m_onClose;
+};
+
+
 class Plotter::Impl
 /*
 
@@ -65,7 +114,8 @@ class Plotter::Impl
 public:
 
     Impl(PlotterArgs plotterArgs)
-        : m_defaultConfigs(
+        : m_headless(useOffscreenPlatformIfHeadless(plotterArgs.headless)),
+          m_defaultConfigs(
               {plotterArgs.colorMode,
                plotterArgs.axisTickLabelFont,
                plotterArgs.axisTickLabelFontSize,
@@ -77,10 +127,48 @@ public:
           }
         )
     {
+        m_applicationReadyTime = std::chrono::steady_clock::now();
 
         m_passedPlotterArgs = plotterArgs;
 
+        // Decode the marker textures and rasterise the tick label glyphs on worker
+        // threads while the window and OpenGL context are setup (see startupStats()).
+        Q_INIT_RESOURCE(resources);
+
+        ScatterMarkerImages::prefetch();
+
+        QScreen* screen = QGuiApplication::primaryScreen();
+        Font tickLabelFont = m_defaultConfigs.m_plotOptions.axisTickLabelFont;
+        int tickLabelPixelSize = static_cast<int>(
+            m_defaultConfigs.m_plotOptions.axisTickLabelFontSize * (screen ? screen->devicePixelRatio() : 1.0)
+        );
+        m_startupTasks.push_back(std::async(std::launch::async, [tickLabelFont, tickLabelPixelSize]()
+        {
+            std::string printableAscii;
+            for (char c = 0x20; c < 0x7F; c++)
+            {
+                printableAscii.push_back(c);
+            }
+            GlyphAtlasCache::rasteriseGlyphs(tickLabelFont, tickLabelPixelSize, printableAscii);
+        }));
+
+        // Before the main widget is setup, as its subplots copy the configs
+        if (m_passedPlotterArgs.programBinaryCache)
+        {
+            m_defaultConfigs.m_plotOptions.programBinaryCacheDir = m_passedPlotterArgs.programBinaryCacheDir.empty()
+                ? ProgramBinaryCache::defaultDirectory()
+                : m_passedPlotterArgs.programBinaryCacheDir;
+        }
+
+        if (m_passedPlotterArgs.uiThread)
+        {
+            // Closing the window only hides it, the UI thread runs until the Plotter is destroyed.
+            m_application.setQuitOnLastWindowClosed(false);
+        }
+
         setupMainWidget();
+
+        m_windowSetupTime = std::chrono::steady_clock::now();
     }
 
     void setupMainWidget()
@@ -91,7 +179,8 @@ public:
         openGLFormat.setStencilBufferSize(8);
         openGLFormat.setVersion(3, 3);
         openGLFormat.setProfile(QSurfaceFormat::CoreProfile);
-        openGLFormat.setSwapInterval(1);
+        // No vsync when headless, frames are never presented.
+        openGLFormat.setSwapInterval(m_headless ? 0 : 1);
         openGLFormat.setSamples(m_passedPlotterArgs.antiAliasingSamples);
         QSurfaceFormat::setDefaultFormat(openGLFormat);
 
@@ -117,6 +206,16 @@ public:
         // Set background for light or dark mode.
         QString stylesheet = utils_glmBackgroundColorToQtStylesheet(m_defaultConfigs.m_backgroundColor);
         m_mainWidget->setStyleSheet(stylesheet);
+
+        if (m_passedPlotterArgs.uiThread)
+        {
+            m_mainWidget->installEventFilter(new WindowCloseFilter([this]()
+            {
+                std::lock_guard<std::mutex> lock(m_windowOpenMutex);
+                m_isWindowOpen = false;
+                m_windowClosedCondition.notify_all();
+            }, m_mainWidget));
+        }
     }
 
 
@@ -128,10 +227,33 @@ public:
 
         m_application.quit();
 
+        for (std::future<void>& task : m_startupTasks)
+        {
+            task.wait();
+        }
+
+    }
+
+    static bool useOffscreenPlatformIfHeadless(bool headless)
+    /*
+        Must be called before the QApplication is constructed. The platform is
+        only set if not already chosen by the user (e.g. "eglfs" or "xcb" + Xvfb).
+     */
+    {
+        if (headless && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+        return headless;
     }
 
     void start()
     {
+        if (m_headless)
+        {
+            throw std::invalid_argument("`start()` cannot be called on a headless Plotter. Use `renderToImage()` or `savePng()`.");
+        }
+
         // We must do some tear-down after exec() so that when the window is closed
         // in interactive python, all existing plots are cleaned up and the widgets
         // refreshed. This means the plotter object can continue to be used without seg
@@ -144,6 +266,9 @@ public:
 
         m_application.exec();
 
+        // Kept so startupStats() still reports the closed window
+        m_lastStartupStats = startupStats();
+
         m_mainwindowSubplots.clear();
 
         delete m_mainWidget;
@@ -151,9 +276,44 @@ public:
         setupMainWidget();
     }
 
+    void startAsync()
+    /*
+        Show the window, on the UI thread which is already running
+        the event loop (PlotterArgs::uiThread). The plots are kept when
+        the window is closed, so unlike start() there is no tear-down.
+     */
+    {
+        if (m_headless)
+        {
+            throw std::invalid_argument("`startAsync()` cannot be called on a headless Plotter. Use `renderToImage()` or `savePng()`.");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_windowOpenMutex);
+            m_isWindowOpen = true;
+        }
+
+        m_mainWidget->hide();
+        m_mainWidget->setAttribute(Qt::WA_DontShowOnScreen, false);
+        m_mainWidget->show();
+        m_mainWidget->raise();
+    }
+
+    void waitForWindowClose()
+    /*
+        Called from the thread that called Plotter::start(), not the UI thread.
+     */
+    {
+        std::unique_lock<std::mutex> lock(m_windowOpenMutex);
+        m_windowClosedCondition.wait(lock, [this] { return !m_isWindowOpen; });
+    }
+
     PlotWrapperWidget* activeSubplot()
     {
+        // Any access through the API may change the plots, so
+        // the cached plot layer must be re-rendered.
         m_mainwindowSubplots[SubKey{m_activeRow, m_activeCol}]->m_centralOpenGlWidget->makeCurrent();
+        m_mainwindowSubplots[SubKey{m_activeRow, m_activeCol}]->m_centralOpenGlWidget->markPlotLayerDirty();
         return m_mainwindowSubplots[SubKey{m_activeRow, m_activeCol}];
     }
 
@@ -175,6 +335,7 @@ public:
         }
         checkActiveSubplotExists(row.value(), col.value());
 
+        m_mainwindowSubplots[SubKey{row.value(), col.value()}]->m_centralOpenGlWidget->markPlotLayerDirty();
         QImage rgba  = m_mainwindowSubplots[SubKey{row.value(), col.value()}]->m_centralOpenGlWidget->grabFramebuffer();
 
         std::vector<uint8_t> tight(rgba.width() * rgba.height() * 4);
@@ -188,6 +349,84 @@ public:
         return {tight, rgba .size().width(), rgba .size().height()};
     }
 
+    QImage renderToImage(int width, int height, int dpi)
+    /*
+        Render the main widget (all subplots, legends and labels) into
+        a QImage. QWidget::render() draws each QOpenGLWidget from its
+        framebuffer, so nothing is presented to the window system.
+
+        The main widget is resized for the render and the layout applied
+        immediately (rather than on the next event loop iteration), then
+        restored to its original size.
+     */
+    {
+        if (width <= 0 || height <= 0)
+        {
+            throw std::invalid_argument("`width` and `height` must be greater than zero.");
+        }
+        if (dpi <= 0)
+        {
+            throw std::invalid_argument("`dpi` must be greater than zero.");
+        }
+
+        QSize originalSize = m_mainWidget->size();
+        qreal dpr = m_mainWidget->devicePixelRatioF();
+
+        m_mainWidget->resize(
+            static_cast<int>(std::round(width / dpr)), static_cast<int>(std::round(height / dpr))
+        );
+        m_centralLayout->activate();
+
+        for (auto& [key, subplot] : m_mainwindowSubplots)
+        {
+            subplot->m_centralOpenGlWidget->markPlotLayerDirty();
+        }
+
+        QImage image(width, height, QImage::Format_RGBA8888);
+        image.setDevicePixelRatio(dpr);
+        image.fill(Qt::transparent);
+
+        m_mainWidget->render(&image);
+
+        // Dots per meter, as stored in the .png pHYs chunk.
+        int dotsPerMeter = static_cast<int>(std::round(dpi / 0.0254));
+        image.setDotsPerMeterX(dotsPerMeter);
+        image.setDotsPerMeterY(dotsPerMeter);
+
+        m_mainWidget->resize(originalSize);
+        m_centralLayout->activate();
+
+        return image;
+    }
+
+    std::tuple<std::vector<std::uint8_t>, int, int> renderToBuffer(int width, int height, int dpi)
+    {
+        QImage image = renderToImage(width, height, dpi);
+
+        std::vector<uint8_t> tight(image.width() * image.height() * 4);
+
+        for (int y = 0; y < image.height(); ++y) {
+            std::memcpy(tight.data() + y * image.width() * 4, image.constScanLine(y), image.width() * 4);
+        }
+        return {tight, image.width(), image.height()};
+    }
+
+    void savePng(const std::string& filepath, std::optional<int> width, std::optional<int> height, int dpi)
+    {
+        qreal dpr = m_mainWidget->devicePixelRatioF();
+
+        QImage image = renderToImage(
+            width.value_or(static_cast<int>(std::round(m_mainWidget->width() * dpr))),
+            height.value_or(static_cast<int>(std::round(m_mainWidget->height() * dpr))),
+            dpi
+        );
+
+        if (!image.save(QString::fromStdString(filepath), "PNG"))
+        {
+            throw std::invalid_argument("Could not save the image to " + filepath + ".");
+        }
+    }
+
     std::string formatToString(QImage::Format format)
     {
         switch (format) {
@@ -204,6 +443,126 @@ public:
         m_mainWidget->resize(width, height);
     }
 
+    void moveCamera(CameraOperation operation, double amount)
+    {
+        for (const std::unique_ptr<LinkedSubplot>& subplot : activeSubplot()->allLinkedSubplots())
+        {
+            Camera& camera = subplot->camera();
+
+            switch (operation)
+            {
+            case CameraOperation::zoomX:
+                camera.zoomX(amount, (camera.getLeft() + camera.getRight()) / 2.0, -1.0);
+                break;
+            case CameraOperation::panX:
+                camera.leftMouseMove(amount, 0.0, false);
+                break;
+            case CameraOperation::wheelZoom:
+                camera.wheelScrollZoom(amount, 0.5, std::nullopt);
+                break;
+            default:
+                throw std::runtime_error("CRITICAL ERROR: CameraOperation not recognised.");
+            }
+        }
+        activeSubplot()->openGlWidget()->markPlotLayerDirty();
+    }
+
+    void enableProfiler(bool enabled)
+    {
+        for (auto& [key, subplot] : m_mainwindowSubplots)
+        {
+            subplot->openGlWidget()->m_rm->m_profiler.setEnabled(enabled);
+        }
+    }
+
+    std::vector<ProfilerStageStats> profilerStats()
+    {
+        return activeSubplot()->openGlWidget()->m_rm->m_profiler.stats();
+    }
+
+    StartupStats startupStats()
+    /*
+        Times are from the construction of the Plotter. The first frame is the first
+        drawn by any subplot, the deferred work is summed over all subplots and is
+        done when every subplot's queue is empty.
+     */
+    {
+        using Clock = std::chrono::steady_clock;
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+        auto msSinceConstruction = [this](Clock::time_point time)
+        {
+            return std::chrono::duration<double, std::milli>(time - m_constructionStart).count();
+        };
+
+        std::optional<Clock::time_point> firstFrameTime;
+        double firstFrameDrawMs = nan;
+        double deferredWorkMs = 0.0;
+        bool deferredWorkPending = false;
+        std::optional<Clock::time_point> deferredWorkDoneTime;
+
+        for (auto& [key, subplot] : m_mainwindowSubplots)
+        {
+            CentralOpenGlWidget* widget = subplot->openGlWidget();
+
+            if (widget->firstFrameTime().has_value()
+                && (!firstFrameTime.has_value() || widget->firstFrameTime().value() < firstFrameTime.value()))
+            {
+                firstFrameTime = widget->firstFrameTime();
+                firstFrameDrawMs = widget->firstFrameDrawMs();
+            }
+
+            const DeferredWorkQueue& deferredWork = widget->m_rm->m_deferredWork;
+
+            deferredWorkMs += deferredWork.totalRunMs();
+            deferredWorkPending = deferredWorkPending || !deferredWork.empty();
+
+            if (deferredWork.doneTime().has_value()
+                && (!deferredWorkDoneTime.has_value() || deferredWork.doneTime().value() > deferredWorkDoneTime.value()))
+            {
+                deferredWorkDoneTime = deferredWork.doneTime();
+            }
+        }
+
+        if (!firstFrameTime.has_value())
+        {
+            // No frame drawn since the window was re-created, report the last window shown (if any)
+            if (m_lastStartupStats.has_value())
+            {
+                return m_lastStartupStats.value();
+            }
+        }
+
+        StartupStats stats;
+        stats.applicationMs = msSinceConstruction(m_applicationReadyTime);
+        stats.windowSetupMs = msSinceConstruction(m_windowSetupTime);
+        stats.firstFrameMs = firstFrameTime.has_value() ? msSinceConstruction(firstFrameTime.value()) : nan;
+        stats.firstFrameDrawMs = firstFrameDrawMs;
+        stats.deferredWorkMs = deferredWorkMs;
+
+        if (deferredWorkPending || !firstFrameTime.has_value())
+        {
+            stats.deferredWorkDoneMs = nan;
+        }
+        else
+        {
+            stats.deferredWorkDoneMs = msSinceConstruction(deferredWorkDoneTime.value_or(firstFrameTime.value()));
+        }
+
+        return stats;
+    }
+
+    void saveProfilerTrace(const std::string& filepath)
+    {
+        std::ofstream file(filepath);
+
+        if (!file)
+        {
+            throw std::invalid_argument("Could not open " + filepath + " for writing.");
+        }
+        file << activeSubplot()->openGlWidget()->m_rm->m_profiler.chromeTrace();
+    }
+
     /* -----------------------------------------------------------------------------------
      *  Settings
      * -----------------------------------------------------------------------------------
@@ -627,7 +986,8 @@ public:
         const float* closePtr, std::size_t closeSize,
         OptionalDateVector dates,
         std::optional<CandlestickSettings> candlestickSettings,
-        int linkedSubplotIdx
+        int linkedSubplotIdx,
+        std::optional<PrecomputedBlockMinMax> blockMinMax = std::nullopt
     )
     {
         if (!(openSize == closeSize && openSize == lowSize && openSize == highSize))
@@ -653,7 +1013,94 @@ public:
             lowPtr, lowSize,
             closePtr, closeSize,
             dates,
-            backendSettings
+            backendSettings,
+            blockMinMax
+        );
+    }
+
+    void appendCandles(
+        const float* openPtr,
+        const float* highPtr,
+        const float* lowPtr,
+        const float* closePtr,
+        std::size_t size,
+        OptionalDateVector dates,
+        int linkedSubplotIdx
+    )
+    {
+        throwExceptionForFailedStreamingChecks(linkedSubplotIdx);
+
+        if (size == 0)
+        {
+            return;
+        }
+
+        DateType dateType = activeSubplot()->linkedSubplot(linkedSubplotIdx)->sharedXData().getDateType();
+
+        if (dates.has_value())
+        {
+            if (dateType == DateType::NoDate)
+            {
+                throw std::invalid_argument("The candlestick plot was created without dates, so dates cannot be appended.");
+            }
+            if (dateType == DateType::Timepoint && std::holds_alternative<StringVectorRef>(dates.value()))
+            {
+                throw std::invalid_argument("Dates are already set with timepoint labels. Cannot append string dates.");
+            }
+            if (dateType == DateType::String && !std::holds_alternative<StringVectorRef>(dates.value()))
+            {
+                throw std::invalid_argument("Dates are already set with string labels. Cannot append timepoint dates.");
+            }
+
+            int datesSize = getDatesSize(dates);
+            if (size != static_cast<std::size_t>(datesSize))
+            {
+                throw std::invalid_argument("Size of dates: " + std::to_string(datesSize) + " is different from the data size: " + std::to_string(size));
+            }
+        }
+        else if (dateType != DateType::NoDate)
+        {
+            throw std::invalid_argument("The candlestick plot has dates, so `dates` must be passed when appending candles.");
+        }
+
+        activeSubplot()->linkedSubplot(linkedSubplotIdx)->appendCandles(
+            openPtr, highPtr, lowPtr, closePtr, size, dates
+        );
+
+        activeSubplot()->openGlWidget()->update();
+    }
+
+    void updateLastCandle(float open, float high, float low, float close, int linkedSubplotIdx)
+    {
+        throwExceptionForFailedStreamingChecks(linkedSubplotIdx);
+
+        activeSubplot()->linkedSubplot(linkedSubplotIdx)->updateLastCandle(open, high, low, close);
+
+        activeSubplot()->openGlWidget()->update();
+    }
+
+    std::shared_ptr<CandleStream> candleStream(int linkedSubplotIdx, std::optional<CandleStreamSettings> streamSettings)
+    /*
+        The stream is keyed by the linked subplot index, which is
+        what the GUI thread resolves when draining the queue.
+     */
+    {
+        throwExceptionForFailedStreamingChecks(linkedSubplotIdx);
+
+        DateType dateType = activeSubplot()->linkedSubplot(linkedSubplotIdx)->sharedXData().getDateType();
+
+        if (dateType == DateType::String)
+        {
+            throw std::invalid_argument("Candles cannot be streamed to a plot with string dates, only timepoint dates are supported.");
+        }
+
+        int linkedIdx = activeSubplot()->accountForNegativeIdx(linkedSubplotIdx);
+
+        return std::make_shared<CandleStream>(
+            activeSubplot()->openGlWidget()->updateQueue(),
+            linkedIdx,
+            dateType != DateType::NoDate,
+            streamSettings.value_or(CandleStreamSettings{})
         );
     }
 
@@ -722,7 +1169,7 @@ public:
                 throw std::invalid_argument("The x-axis data must always be string, index or chrono timepoint. Currently it is an index, but string data was passed.");
             }
         }
-        else if (std::holds_alternative<TimepointVectorRef>(xData))
+        else if (std::holds_alternative<TimepointVectorRef>(xData) || std::holds_alternative<EpochNsVector>(xData))
         {
             if (dateType == DateType::String)
             {
@@ -781,6 +1228,10 @@ public:
         {
             return std::get<TimepointVectorRef>(dates.value()).get().size();
         }
+        else if (std::holds_alternative<EpochNsVector>(dates.value()))
+        {
+            return std::get<EpochNsVector>(dates.value()).size();
+        }
         else
         {
             throw std::invalid_argument("Dates type not recognised.");
@@ -849,7 +1300,7 @@ public:
                     std::cerr << "Warning: string dates already exist on the plot. Dates will be updated." << std::endl;
                 }
             }
-            else if (std::holds_alternative<TimepointVectorRef>(dates.value()))
+            else
             {
                 if (dateType == DateType::String)
                 {
@@ -864,6 +1315,28 @@ public:
         }
     }
 
+    void throwExceptionForFailedStreamingChecks(int linkedSubplotIdx)
+    {
+        int numLinkedSubplots = activeSubplot()->allLinkedSubplots().size();
+
+        if (linkedSubplotIdx >= numLinkedSubplots)
+        {
+            throw std::invalid_argument(
+                "linkedSubplotIdx: " + std::to_string(linkedSubplotIdx) +
+                " is larger than the number of plots: " + std::to_string(numLinkedSubplots)
+            );
+        }
+
+        const JointPlotData& jointPlotData = activeSubplot()->linkedSubplot(linkedSubplotIdx)->jointPlotData();
+
+        if (jointPlotData.numPlots() != 1 || !dynamic_cast<CandlestickPlot*>(jointPlotData.plotVector()[0].get()))
+        {
+            throw std::invalid_argument(
+                "Candles can only be streamed to a linked subplot that contains a single candlestick plot."
+            );
+        }
+    }
+
     /* -----------------------------------------------------------------------------------
      *  Read from disk
      * ----------------------------------------------------------------------------------- */
@@ -871,44 +1344,22 @@ public:
     CandleDataCSV _readDataFromCSV(const std::string& dataFilepath) const
     /*
     Read a .csv with columns (open, close, low, high) and optionally
-    (dates) into the candleData structure.
+    (dates) into the candleData structure. The dates are always
+    returned as strings in `dates`, as before readCandleDataCSV()
+    could parse ISO-8601 dates.
  */
     {
-        CandleDataCSV candleData;
-
-        float open, close, low, high;
-        std::string dates;
-
-        try {
-            // Attempt to read the header with the "Date" column
-            io::CSVReader<5> in(dataFilepath);
-            in.read_header(io::ignore_extra_column, "Open", "Close", "Low", "High", "Date");
-
-            while (in.read_row(open, close, low, high, dates)) {
-                candleData.open.push_back(open);
-                candleData.close.push_back(close);
-                candleData.low.push_back(low);
-                candleData.high.push_back(high);
-                candleData.dates.push_back(dates);
-            }
-
-        } catch (const std::exception& e) {
-            // If "Date" column is missing, fall back to reading without it
-            io::CSVReader<4> in(dataFilepath);
-            in.read_header(io::ignore_extra_column, "Open", "Close", "Low", "High");
-
-            while (in.read_row(open, close, low, high)) {
-                candleData.open.push_back(open);
-                candleData.close.push_back(close);
-                candleData.low.push_back(low);
-                candleData.high.push_back(high);
-            }
-        }
-        return candleData;
+        return readCandleDataCSV(dataFilepath, 0, false);
     }
 
 private:
 
+    // Declared first, so the time to construct the QApplication is included in startupStats()
+    std::chrono::steady_clock::time_point m_constructionStart = std::chrono::steady_clock::now();
+
+    // Declared before the QApplication, which reads the platform set on construction.
+    bool m_headless;
+
     int m_argc = 0;
     std::vector<char*> m_argv{ const_cast<char*>("") };
     QApplication m_application{m_argc, m_argv.data()};
@@ -926,9 +1377,147 @@ private:
     QGridLayout* m_centralLayout;  // owned by m_mainWidget
 
     PlotterArgs m_passedPlotterArgs;
+
+    std::chrono::steady_clock::time_point m_applicationReadyTime;
+    std::chrono::steady_clock::time_point m_windowSetupTime;
+    std::optional<StartupStats> m_lastStartupStats;
+    std::vector<std::future<void>> m_startupTasks;  // waited for on destruction
+
+    // Set by the UI thread when the window is closed (PlotterArgs::uiThread)
+    std::mutex m_windowOpenMutex;
+    std::condition_variable m_windowClosedCondition;
+    bool m_isWindowOpen = false;
+};
+
+
+class Plotter::UiThread
+/*
+    Runs the Qt event loop on a dedicated thread (PlotterArgs::uiThread).
+    Qt widgets may only be used on the thread that created the QApplication,
+    so the Impl (which owns the QApplication) is constructed, used and
+    destroyed on this thread.
+
+    Calls from other threads are queued to the event loop and the caller
+    waits for them to finish (so references passed to the call stay valid).
+    Exceptions are re-thrown in the calling thread.
+
+    On destruction, calls already queued are waited for before the event loop
+    is stopped (a queued call would otherwise never run and its caller wait
+    forever), and later calls are rejected.
+ */
+{
+public:
+    UiThread(std::unique_ptr<Impl>& pImpl, PlotterArgs plotterArgs)
+    {
+        std::future<void> started = m_started.get_future();
+
+        m_thread = std::thread([this, &pImpl, plotterArgs]()
+        {
+            try
+            {
+                pImpl = std::make_unique<Impl>(plotterArgs);
+            }
+            catch (...)
+            {
+                m_started.set_exception(std::current_exception());
+                return;
+            }
+            m_started.set_value();
+
+            QApplication::exec();
+
+            pImpl.reset();
+        });
+
+        try
+        {
+            started.get();
+        }
+        catch (...)
+        {
+            m_thread.join();
+            throw;
+        }
+    }
+
+    ~UiThread()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_callsMutex);
+            m_stopping = true;
+            m_callsDone.wait(lock, [this]() { return m_numPendingCalls == 0; });
+        }
+
+        QMetaObject::invokeMethod(QCoreApplication::instance(), []() { QCoreApplication::quit(); }, Qt::QueuedConnection);
+        m_thread.join();
+    }
+
+    UiThread(const UiThread&) = delete;
+    UiThread& operator=(const UiThread&) = delete;
+    UiThread(UiThread&&) = delete;
+    UiThread& operator=(UiThread&&) = delete;
+
+    template <typename Func>
+    auto run(Func&& func)
+    {
+        using Result = decltype(func());
+
+        if (std::this_thread::get_id() == m_thread.get_id())
+        {
+            return func();
+        }
+
+        std::packaged_task<Result()> task(std::forward<Func>(func));
+        std::future<Result> result = task.get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(m_callsMutex);
+
+            if (m_stopping)
+            {
+                throw std::invalid_argument("The Plotter cannot be used while it is being destroyed.");
+            }
+            m_numPendingCalls++;
+        }
+
+        // The task stores any exception in `result`, so this always returns once the task has run
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [&task]() { task(); }, Qt::BlockingQueuedConnection);
+
+        {
+            std::lock_guard<std::mutex> lock(m_callsMutex);
+            m_numPendingCalls--;
+        }
+        m_callsDone.notify_all();
+
+        return result.get();
+    }
+
+private:
+    std::thread m_thread;
+    std::promise<void> m_started;
+
+    std::mutex m_callsMutex;
+    std::condition_variable m_callsDone;
+    std::size_t m_numPendingCalls = 0;
+    bool m_stopping = false;
 };
 
 
+template <typename Func>
+auto Plotter::runOnUiThread(Func&& func)
+/*
+    Run a call on the Impl on the UI thread if there is one,
+    otherwise (the default) on the calling thread.
+ */
+{
+    if (m_uiThread)
+    {
+        return m_uiThread->run(std::forward<Func>(func));
+    }
+    return func();
+}
+
+
 /* ---------------------------------------------------------------------------------
   Plotter
  ----------------------------------------------------------------------------------- */
@@ -937,95 +1526,130 @@ Plotter::Plotter(
     std::optional<PlotterArgs> plotterArgs
 )
 {
-    if (plotterArgs.has_value())
+    PlotterArgs usedPlotterArgs = plotterArgs.value_or(PlotterArgs{});
+
+    if (usedPlotterArgs.uiThread)
     {
-        pImpl = std::make_unique<Impl>(
-            plotterArgs.value()
-        );
+#ifdef __APPLE__
+        throw std::invalid_argument("`uiThread` is not supported on macOS, where Qt must run on the main thread.");
+#endif
+        if (QCoreApplication::instance() != nullptr)
+        {
+            throw std::invalid_argument("`uiThread` cannot be used while another Plotter exists.");
+        }
+        m_uiThread = std::make_unique<UiThread>(pImpl, usedPlotterArgs);
     }
     else
     {
-        PlotterArgs defaultPlotArgs{};
-
         pImpl = std::make_unique<Impl>(
-            defaultPlotArgs
+            usedPlotterArgs
         );
     }
 };
 
 
-Plotter::~Plotter() = default;
+Plotter::~Plotter()
+{
+    // The UI thread destroys the Impl once its event loop has quit
+    m_uiThread.reset();
+}
 
 void Plotter::start()
 {
+    if (m_uiThread)
+    {
+        runOnUiThread([&] { pImpl->startAsync(); });
+        pImpl->waitForWindowClose();
+        return;
+    }
     pImpl->start();
 };
 
+bool Plotter::hasUiThread() const
+{
+    return m_uiThread != nullptr;
+}
+
+void Plotter::startAsync()
+{
+    if (!m_uiThread)
+    {
+        throw std::invalid_argument("`startAsync()` requires the Plotter to be created with `uiThread`.");
+    }
+    runOnUiThread([&] { pImpl->startAsync(); });
+}
+
 void Plotter::setBackgroundColor(const std::vector<float> backgroundColor)
 {
-    pImpl->setBackgroundColor(backgroundColor.data(), backgroundColor.size());
+    runOnUiThread([&] { pImpl->setBackgroundColor(backgroundColor.data(), backgroundColor.size()); });
 }
 
 void Plotter::setCameraSettings(CameraSettings cameraSettings, std::optional<int> linkedSubplotIdx)
 {
-    pImpl->setCameraSettings(cameraSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->setCameraSettings(cameraSettings, linkedSubplotIdx); });
 }
 
 void Plotter::pinYAxis(bool on, std::optional<int> linkedSubplotIdx)
 {
-    pImpl->pinYAxis(on, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->pinYAxis(on, linkedSubplotIdx); });
 }
 
 void Plotter::linkYAxis(bool on)
 {
-    pImpl->linkYAxis(on);
+    runOnUiThread([&] { pImpl->linkYAxis(on); });
 }
 
 void Plotter::setYLimits(std::optional<double> min, std::optional<double> max, std::optional<int> linkedSubplotIdx)
 {
-    pImpl->setYLimits(min, max, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->setYLimits(min, max, linkedSubplotIdx); });
 }
 
 void Plotter::setXLimits(
     std::optional<std::variant<int, std::string, std::chrono::system_clock::time_point>> min,
     std::optional<std::variant<int, std::string, std::chrono::system_clock::time_point>> max)
 {
-    pImpl->setXLimits(min, max);
+    runOnUiThread([&] { pImpl->setXLimits(min, max); });
 }
 
 void Plotter::setXLabel(std::string text, std::optional<AxisLabelSettings> settings)
 {
-    pImpl->setXLabel(text, settings);
+    runOnUiThread([&] { pImpl->setXLabel(text, settings); });
 }
 
 void Plotter::setYLabel(std::string text, std::optional<AxisLabelSettings> settings)
 {
-    pImpl->setYLabel(text, settings);
+    runOnUiThread([&] { pImpl->setYLabel(text, settings); });
 }
 
 void Plotter::setTitle(std::string text, std::optional<TitleLabelSettings> settings)
 {
-    pImpl->setTitle(text, settings);
+    runOnUiThread([&] { pImpl->setTitle(text, settings); });
 }
 
 void Plotter::setXAxisSettings(XAxisSettings xAxisSettings, std::optional<int> linkedSubplotIdx)
 {
-    pImpl->setXAxisSettings(
-        xAxisSettings, linkedSubplotIdx
-    );
+    runOnUiThread([&]
+    {
+        pImpl->setXAxisSettings(
+            xAxisSettings, linkedSubplotIdx
+        );
+    });
 }
 
 void Plotter::setYAxisSettings(YAxisSettings yAxisSettings, std::optional<int> linkedSubplotIdx)
 {
-    pImpl->setYAxisSettings(
-        yAxisSettings, linkedSubplotIdx
-    );
+    runOnUiThread([&]
+    {
+        pImpl->setYAxisSettings(
+            yAxisSettings, linkedSubplotIdx
+        );
+    });
 }
 
 
 void Plotter::resize(int width, int height)
 {
-    pImpl->resize(width, height);
+    runOnUiThread([&] { pImpl->resize(width, height); });
 }
 
 
@@ -1039,15 +1663,18 @@ void Plotter::candlestick(
     int linkedSubplotIdx
 )
 {
-    pImpl->candlestick(
-        open.data(), open.size(),
-        high.data(), high.size(),
-        low.data(), low.size(),
-        close.data(), close.size(),
-        dates,
-        candlestickSettings,
-        linkedSubplotIdx
-    );
+    runOnUiThread([&]
+    {
+        pImpl->candlestick(
+            open.data(), open.size(),
+            high.data(), high.size(),
+            low.data(), low.size(),
+            close.data(), close.size(),
+            dates,
+            candlestickSettings,
+            linkedSubplotIdx
+        );
+    });
 }
 
 
@@ -1061,15 +1688,18 @@ void Plotter::candlestick(
     int linkedSubplotIdx
 )
 {
-    pImpl->candlestick(
-        open.data(), open.size(),
-        high.data(), high.size(),
-        low.data(), low.size(),
-        close.data(), close.size(),
-        dates,
-        candlestickSettings,
-        linkedSubplotIdx
-    );
+    runOnUiThread([&]
+    {
+        pImpl->candlestick(
+            open.data(), open.size(),
+            high.data(), high.size(),
+            low.data(), low.size(),
+            close.data(), close.size(),
+            dates,
+            candlestickSettings,
+            linkedSubplotIdx
+        );
+    });
 }
 
 
@@ -1082,15 +1712,18 @@ void Plotter::candlestick(
     int linkedSubplotIdx
     )
 {
-    pImpl->candlestick(
-        open.data(), open.size(),
-        high.data(), high.size(),
-        low.data(), low.size(),
-        close.data(), close.size(),
-        std::nullopt,
-        candlestickSettings,
-        linkedSubplotIdx
-    );
+    runOnUiThread([&]
+    {
+        pImpl->candlestick(
+            open.data(), open.size(),
+            high.data(), high.size(),
+            low.data(), low.size(),
+            close.data(), close.size(),
+            std::nullopt,
+            candlestickSettings,
+            linkedSubplotIdx
+        );
+    });
 }
 
 void Plotter::candlestick(
@@ -1103,15 +1736,142 @@ void Plotter::candlestick(
     int linkedSubplotIdx
 )
 {
-    pImpl->candlestick(
-        openPtr, openSize,
-        highPtr, highSize,
-        lowPtr, lowSize,
-        closePtr, closeSize,
-        dates,
-        candlestickSettings,
-        linkedSubplotIdx
-    );
+    runOnUiThread([&]
+    {
+        pImpl->candlestick(
+            openPtr, openSize,
+            highPtr, highSize,
+            lowPtr, lowSize,
+            closePtr, closeSize,
+            dates,
+            candlestickSettings,
+            linkedSubplotIdx
+        );
+    });
+}
+
+void Plotter::candlestick(
+    const CandleColumnFile& file,
+    std::optional<CandlestickSettings> candlestickSettings,
+    int linkedSubplotIdx
+)
+{
+    StdPtrVector<float> open = file.column(CandleColumn::open);
+    StdPtrVector<float> high = file.column(CandleColumn::high);
+    StdPtrVector<float> low = file.column(CandleColumn::low);
+    StdPtrVector<float> close = file.column(CandleColumn::close);
+
+    OptionalDateVector dates = std::nullopt;
+    if (file.hasDates())
+    {
+        dates = file.dates();
+    }
+
+    // The zone maps can stand in for the y-range index blocks if the block sizes match
+    std::optional<PrecomputedBlockMinMax> blockMinMax = std::nullopt;
+    if (file.blockSize() == RangeMinMaxIndex::blockSize)
+    {
+        blockMinMax = PrecomputedBlockMinMax{file.blockMin(CandleColumn::low), file.blockMax(CandleColumn::high)};
+    }
+
+    runOnUiThread([&]
+    {
+        pImpl->candlestick(
+            open.data(), open.size(),
+            high.data(), high.size(),
+            low.data(), low.size(),
+            close.data(), close.size(),
+            dates,
+            candlestickSettings,
+            linkedSubplotIdx,
+            blockMinMax
+        );
+    });
+}
+
+void Plotter::appendCandles(
+    const std::vector<float>& open,
+    const std::vector<float>& high,
+    const std::vector<float>& low,
+    const std::vector<float>& close,
+    int linkedSubplotIdx
+)
+{
+    checkAppendSizes(open.size(), high.size(), low.size(), close.size());
+
+    runOnUiThread([&]
+    {
+        pImpl->appendCandles(
+            open.data(), high.data(), low.data(), close.data(), open.size(),
+            std::nullopt,
+            linkedSubplotIdx
+        );
+    });
+}
+
+void Plotter::appendCandles(
+    const std::vector<float>& open,
+    const std::vector<float>& high,
+    const std::vector<float>& low,
+    const std::vector<float>& close,
+    const std::vector<std::string>& dates,
+    int linkedSubplotIdx
+)
+{
+    checkAppendSizes(open.size(), high.size(), low.size(), close.size());
+
+    runOnUiThread([&]
+    {
+        pImpl->appendCandles(
+            open.data(), high.data(), low.data(), close.data(), open.size(),
+            dates,
+            linkedSubplotIdx
+        );
+    });
+}
+
+void Plotter::appendCandles(
+    const std::vector<float>& open,
+    const std::vector<float>& high,
+    const std::vector<float>& low,
+    const std::vector<float>& close,
+    const std::vector<std::chrono::system_clock::time_point>& dates,
+    int linkedSubplotIdx
+)
+{
+    checkAppendSizes(open.size(), high.size(), low.size(), close.size());
+
+    runOnUiThread([&]
+    {
+        pImpl->appendCandles(
+            open.data(), high.data(), low.data(), close.data(), open.size(),
+            dates,
+            linkedSubplotIdx
+        );
+    });
+}
+
+void Plotter::appendCandles(
+    const float* openPtr,
+    const float* highPtr,
+    const float* lowPtr,
+    const float* closePtr,
+    std::size_t size,
+    const OptionalDateVector dates,
+    int linkedSubplotIdx
+)
+{
+    runOnUiThread([&] { pImpl->appendCandles(openPtr, highPtr, lowPtr, closePtr, size, dates, linkedSubplotIdx); });
+}
+
+void Plotter::updateLastCandle(float open, float high, float low, float close, int linkedSubplotIdx)
+{
+    runOnUiThread([&] { pImpl->updateLastCandle(open, high, low, close, linkedSubplotIdx); });
+}
+
+std::shared_ptr<CandleStream> Plotter::candleStream(int linkedSubplotIdx, std::optional<CandleStreamSettings> streamSettings)
+{
+    return runOnUiThread([&] { return pImpl->candleStream(linkedSubplotIdx, streamSettings); });
 }
 
 void Plotter::line(
@@ -1121,7 +1881,7 @@ void Plotter::line(
     int linkedSubplotIdx
 )
 {
-    pImpl->line(yData.data(), yData.size(), dates, lineSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->line(yData.data(), yData.size(), dates, lineSettings, linkedSubplotIdx); });
 }
 
 void Plotter::line(
@@ -1131,7 +1891,7 @@ void Plotter::line(
     int linkedSubplotIdx
     )
 {
-    pImpl->line(yPtr, ySize, dates, lineSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->line(yPtr, ySize, dates, lineSettings, linkedSubplotIdx); });
 }
 
 void Plotter::line(
@@ -1140,7 +1900,7 @@ void Plotter::line(
     int linkedSubplotIdx
     )
 {
-    pImpl->line(yData.data(), yData.size(), std::nullopt, lineSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->line(yData.data(), yData.size(), std::nullopt, lineSettings, linkedSubplotIdx); });
 }
 
 void Plotter::bar(
@@ -1150,7 +1910,7 @@ void Plotter::bar(
     int linkedSubplotIdx
 )
 {
-    pImpl->bar(yData.data(), yData.size(), dates, barSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->bar(yData.data(), yData.size(), dates, barSettings, linkedSubplotIdx); });
 }
 
 void Plotter::bar(
@@ -1159,7 +1919,7 @@ void Plotter::bar(
     int linkedSubplotIdx
 )
 {
-    pImpl->bar(yData.data(), yData.size(), std::nullopt, barSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->bar(yData.data(), yData.size(), std::nullopt, barSettings, linkedSubplotIdx); });
 }
 
 void Plotter::bar(
@@ -1169,7 +1929,7 @@ void Plotter::bar(
     int linkedSubplotIdx
 )
 {
-    pImpl->bar(yPtr, ySize, dates, barSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->bar(yPtr, ySize, dates, barSettings, linkedSubplotIdx); });
 }
 
 
@@ -1182,7 +1942,7 @@ void Plotter::scatter(
 {
     StdPtrVector<int> xDataVector = StdPtrVector<int>(xData.data(), xData.size());  // passed by value down to ScatterPlotData where it is stored
 
-    pImpl->scatter(xDataVector, yData.data(), yData.size(), scatterSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->scatter(xDataVector, yData.data(), yData.size(), scatterSettings, linkedSubplotIdx); });
 }
 
 
@@ -1193,7 +1953,7 @@ void Plotter::scatter(
     int linkedSubplotIdx
 )
 {
-    pImpl->scatter(xData, yPtr, ySize, scatterSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->scatter(xData, yPtr, ySize, scatterSettings, linkedSubplotIdx); });
 }
 
 
@@ -1204,8 +1964,19 @@ void Plotter::scatter(
     int linkedSubplotIdx
 )
 {
-    pImpl->scatter(xData, yPtr, ySize, scatterSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->scatter(xData, yPtr, ySize, scatterSettings, linkedSubplotIdx); });
+
+}
 
+
+void Plotter::scatter(
+    const EpochNsVector& xData,
+    const float* yPtr, std::size_t ySize,
+    std::optional<ScatterSettings> scatterSettings,
+    int linkedSubplotIdx
+)
+{
+    runOnUiThread([&] { pImpl->scatter(xData, yPtr, ySize, scatterSettings, linkedSubplotIdx); });
 }
 
 
@@ -1216,7 +1987,7 @@ void Plotter::scatter(
     int linkedSubplotIdx
 )
 {
-    pImpl->scatter(xData, yData.data(), yData.size(), scatterSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->scatter(xData, yData.data(), yData.size(), scatterSettings, linkedSubplotIdx); });
 
 }
 
@@ -1228,7 +1999,7 @@ void Plotter::scatter(
     int linkedSubplotIdx
     )
 {
-    pImpl->scatter(xData, yData.data(), yData.size(), scatterSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->scatter(xData, yData.data(), yData.size(), scatterSettings, linkedSubplotIdx); });
 
 }
 
@@ -1242,26 +2013,26 @@ void Plotter::scatter(
 {
     StdPtrVector<int> xDataVector = StdPtrVector<int>(xPtr, xSize);  // passed by value down to ScatterPlotData where it is stored
 
-    pImpl->scatter(xDataVector, yPtr, ySize, scatterSettings, linkedSubplotIdx);
+    runOnUiThread([&] { pImpl->scatter(xDataVector, yPtr, ySize, scatterSettings, linkedSubplotIdx); });
 }
 
 void Plotter::addLinkedSubplot(
     double heightAsProportion
 )
 {
-    pImpl->addLinkedSubplot(heightAsProportion);
+    runOnUiThread([&] { pImpl->addLinkedSubplot(heightAsProportion); });
 }
 
 
 void Plotter::resizeLinkedSubplots(std::vector<double> yHeights)
 {
-    pImpl->resizeLinkedSubplots(yHeights);
+    runOnUiThread([&] { pImpl->resizeLinkedSubplots(yHeights); });
 }
 
 
 void Plotter::setActiveSubplot(int row, int col)
 {
-    pImpl->setActiveSubplot(row, col);
+    runOnUiThread([&] { pImpl->setActiveSubplot(row, col); });
 }
 
 
@@ -1284,7 +2055,7 @@ void Plotter::setLegend(
         legendSettings.value_or(LegendSettings{})
     };
 
-    pImpl->setLegend(labelNames, linkedSubplotIdx, usedSettings);
+    runOnUiThread([&] { pImpl->setLegend(labelNames, linkedSubplotIdx, usedSettings); });
 }
 
 void Plotter::setLegend(
@@ -1300,31 +2071,73 @@ void Plotter::setLegend(
         legendSettings.value_or(LegendSettings{})
     };
 
-    pImpl->setLegend(labelItems, linkedSubplotIdx, usedSettings);
+    runOnUiThread([&] { pImpl->setLegend(labelItems, linkedSubplotIdx, usedSettings); });
 }
 
 
 void Plotter::setCrosshairSettings(CrosshairSettings crosshairSettings)
 {
-    pImpl->setCrosshairSettings(crosshairSettings);
+    runOnUiThread([&] { pImpl->setCrosshairSettings(crosshairSettings); });
 }
 
 
 void Plotter::setDrawLineSettings(DrawLineSettings drawLineSettings)
 {
-    pImpl->setDrawLineSettings(drawLineSettings);
+    runOnUiThread([&] { pImpl->setDrawLineSettings(drawLineSettings); });
 }
 
 
 void Plotter::setHoverValueSettings(HoverValueSettings hoverValueSettings)
 {
-    pImpl->setHoverValueSettings(hoverValueSettings);
+    runOnUiThread([&] { pImpl->setHoverValueSettings(hoverValueSettings); });
 }
 
 
 void Plotter::addSubplot(int row, int col, int rowSpan, int colSpan)
 {
-    pImpl->addSubplot(row, col, rowSpan, colSpan);
+    runOnUiThread([&] { pImpl->addSubplot(row, col, rowSpan, colSpan); });
+}
+
+
+std::tuple<std::vector<uint8_t>, int, int> Plotter::renderToImage(int width, int height, int dpi)
+{
+    return runOnUiThread([&] { return pImpl->renderToBuffer(width, height, dpi); });
+}
+
+
+void Plotter::savePng(const std::string& filepath, std::optional<int> width, std::optional<int> height, int dpi)
+{
+    runOnUiThread([&] { pImpl->savePng(filepath, width, height, dpi); });
+}
+
+
+void Plotter::_moveCamera(CameraOperation operation, double amount)
+{
+    runOnUiThread([&] { pImpl->moveCamera(operation, amount); });
+}
+
+
+void Plotter::enableProfiler(bool enabled)
+{
+    runOnUiThread([&] { pImpl->enableProfiler(enabled); });
+}
+
+
+std::vector<ProfilerStageStats> Plotter::profilerStats()
+{
+    return runOnUiThread([&] { return pImpl->profilerStats(); });
+}
+
+
+StartupStats Plotter::startupStats()
+{
+    return runOnUiThread([&] { return pImpl->startupStats(); });
+}
+
+
+void Plotter::saveProfilerTrace(const std::string& filepath)
+{
+    runOnUiThread([&] { pImpl->saveProfilerTrace(filepath); });
 }
 
 
@@ -1332,5 +2145,5 @@ std::tuple<std::vector<uint8_t>, int, int> Plotter::_grabFrameBuffer(
     std::optional<int> row, std::optional<int> col
 )
 {
-    return pImpl->grabFrameBuffer(row, col);
+    return runOnUiThread([&] { return pImpl->grabFrameBuffer(row, col); });
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <glm.hpp>
 #include <QLabel>
 #include <stdexcept>
@@ -21,6 +23,19 @@ int utils_getSign(T value)
 }
 
 
+inline bool utils_isLittleEndianHost()
+/*
+    Used by the readers that load values in place or 8 bytes at a
+    time (CandleColumnFile, readCandleDataCSV()).
+*/
+{
+    std::uint16_t value = 1;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &value, 1);
+    return firstByte == 1;
+}
+
+
 inline QString utils_glmBackgroundColorToQtStylesheet(glm::vec4 color)
 /*
     Convert a glm::vec4 to a Qt color stylesheet format.
@@ -121,6 +136,66 @@ inline std::string utils_fontEnumToStr(Font font)
 }
 
 
+inline char32_t utils_nextUtf8Codepoint(const std::string& text, std::size_t& pos)
+/*
+    Decode the UTF-8 character starting at `pos` and advance `pos`
+    past it. Invalid sequences are returned as U+FFFD (one byte at a time).
+*/
+{
+    unsigned char lead = static_cast<unsigned char>(text[pos]);
+
+    int numContinuation;
+    char32_t codepoint;
+
+    if (lead < 0x80)
+    {
+        pos += 1;
+        return lead;
+    }
+    else if (lead >= 0xC0 && lead < 0xE0)
+    {
+        numContinuation = 1;
+        codepoint = lead & 0x1F;
+    }
+    else if (lead >= 0xE0 && lead < 0xF0)
+    {
+        numContinuation = 2;
+        codepoint = lead & 0x0F;
+    }
+    else if (lead >= 0xF0 && lead < 0xF8)
+    {
+        numContinuation = 3;
+        codepoint = lead & 0x07;
+    }
+    else
+    {
+        pos += 1;
+        return 0xFFFD;
+    }
+
+    if (pos + numContinuation >= text.size())
+    {
+        pos += 1;
+        return 0xFFFD;
+    }
+
+    for (int i = 1; i <= numContinuation; i++)
+    {
+        unsigned char next = static_cast<unsigned char>(text[pos + i]);
+
+        if ((next & 0xC0) != 0x80)
+        {
+            pos += 1;
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) | (next & 0x3F);
+    }
+
+    pos += numContinuation + 1;
+    return codepoint;
+}
+
+
 inline std::string utils_scatterShapeEnumToStr(ScatterShape shape)
 {
     if (shape == ScatterShape::circle)
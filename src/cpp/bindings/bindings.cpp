@@ -128,6 +128,56 @@ ScatterShape scatterShapeStrToEnum(std::string shape)
     }
 }
 
+
+CandleColumn candleColumnStrToEnum(std::string column)
+{
+    if (column == "open")
+    {
+        return CandleColumn::open;
+    }
+    else if (column == "high")
+    {
+        return CandleColumn::high;
+    }
+    else if (column == "low")
+    {
+        return CandleColumn::low;
+    }
+    else if (column == "close")
+    {
+        return CandleColumn::close;
+    }
+    else if (column == "volume")
+    {
+        return CandleColumn::volume;
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid candle column, must be \"open\", \"high\", \"low\", \"close\" or \"volume\".");
+    }
+}
+
+
+BackpressurePolicy backpressurePolicyStrToEnum(std::string policy)
+{
+    if (policy == "drop")
+    {
+        return BackpressurePolicy::drop;
+    }
+    else if (policy == "merge")
+    {
+        return BackpressurePolicy::merge;
+    }
+    else if (policy == "block")
+    {
+        return BackpressurePolicy::block;
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid backpressure policy, must be \"drop\", \"merge\" or \"block\".");
+    }
+}
+
 auto arr_copy = [](const std::vector<float>& v) {
     // Allocate a new NumPy array of the same length (owned by Python)
     py::array_t<float> a(v.size());
@@ -136,20 +186,83 @@ auto arr_copy = [](const std::vector<float>& v) {
     return a;  // No base/capsule -> Python owns memory
 };
 
+template <typename T>
+py::array_t<T> arr_view(const StdPtrVector<T>& v, py::handle base)
+{
+    // Read-only array viewing the data (no copy), `base` is kept alive by the array
+    py::array_t<T> a(v.size(), v.data(), base);
+    a.attr("setflags")(py::arg("write") = false);
+    return a;
+}
+
+template <typename T>
+py::array_t<T> arr_move(std::vector<T>&& v)
+{
+    // Move the vector to the heap and hand it to NumPy, which frees it with the array (no copy)
+    auto* owned = new std::vector<T>(std::move(v));
+    py::capsule base(owned, [](void* ptr) { delete static_cast<std::vector<T>*>(ptr); });
+    return py::array_t<T>(owned->size(), owned->data(), base);
+}
+
 // Central Plotting Functions
+// -----------------------------------------------------------------------------
+// Datetimes passed as NumPy datetime64[ns] (viewed as int64 nanoseconds since the
+// epoch) are wrapped in this type, so they are not confused with integer index arrays.
+// The array is referenced not copied, so every function taking these must keep_alive
+// the argument.
+
+struct EpochNsDates
+{
+    py::array_t<std::int64_t, py::array::c_style | py::array::forcecast> array;
+
+    EpochNsVector vector() const
+    {
+        return EpochNsVector(array.data(), static_cast<std::size_t>(array.size()));
+    }
+};
+
+using EpochNsDatesRef = std::reference_wrapper<const EpochNsDates>;
+
+
+OptionalDateVector epochNsDatesToDateVector(std::optional<EpochNsDatesRef> dates)
+{
+    if (!dates.has_value())
+    {
+        return std::nullopt;
+    }
+    return dates.value().get().vector();
+}
+
+
+// With a UI thread every Plotter call is marshalled to it and blocks until it has run. The
+// GIL is released while waiting, so other Python threads (e.g. feeding a CandleStream) are
+// not stalled behind the UI thread. Everything the call reads must already be converted
+// to C++ (settings, pointers into NumPy buffers the caller holds), as Python objects cannot
+// be touched without the GIL. Without a UI thread the call runs here and keeps the GIL.
+template <typename Func>
+decltype(auto) callPlotter(Plotter& self, Func&& func)
+{
+    if (self.hasUiThread())
+    {
+        py::gil_scoped_release release;
+        return func();
+    }
+    return func();
+}
+
+
 // -----------------------------------------------------------------------------
 // Unfortunately std::optional<std::variant< ref wrapper const str vector, ref wrapper const datetime vector>> does not work
 // due to the nesting of optional variant ref wrapper. The only workable solution that I could think of is to
 // overload and have central functions here. Obviously this is not ideal at al!
 
-template <typename T>
 void callCandlestickPlot(
     Plotter& self,
     py::array_t<float> open,
     py::array_t<float> high,
     py::array_t<float> low,
     py::array_t<float> close,
-    std::optional<std::reference_wrapper<const std::vector<T>>> dates,
+    OptionalDateVector dates,
     int linkedSubplotIdx,
     std::vector<float> upColor,
     std::vector<float> downColor,
@@ -189,23 +302,62 @@ void callCandlestickPlot(
         lineModeBasicLine
     };
 
-    self.candlestick(
-        openPtr, openSize,
-        highPtr, highSize,
-        lowPtr, lowSize,
-        closePtr, closeSize,
-        dates,
-        settings,
-        linkedSubplotIdx
+    callPlotter(self, [&]
+    {
+        self.candlestick(
+            openPtr, openSize,
+            highPtr, highSize,
+            lowPtr, lowSize,
+            closePtr, closeSize,
+            dates,
+            settings,
+            linkedSubplotIdx
+            );
+    });
+}
+
+
+void callAppendCandles(
+    Plotter& self,
+    py::array_t<float> open,
+    py::array_t<float> high,
+    py::array_t<float> low,
+    py::array_t<float> close,
+    OptionalDateVector dates,
+    int linkedSubplotIdx
+)
+{
+    py::buffer_info bufferOpen = open.request();
+    py::buffer_info bufferHigh = high.request();
+    py::buffer_info bufferLow = low.request();
+    py::buffer_info bufferClose = close.request();
+
+    std::size_t size = bufferOpen.shape[0];
+
+    if (!(bufferHigh.shape[0] == size && bufferLow.shape[0] == size && bufferClose.shape[0] == size))
+    {
+        throw std::invalid_argument("Appended open, high, low, close arrays are not all the same size.");
+    }
+
+    callPlotter(self, [&]
+    {
+        self.appendCandles(
+            static_cast<float*>(bufferOpen.ptr),
+            static_cast<float*>(bufferHigh.ptr),
+            static_cast<float*>(bufferLow.ptr),
+            static_cast<float*>(bufferClose.ptr),
+            size,
+            dates,
+            linkedSubplotIdx
         );
+    });
 }
 
 
-template <typename T>
 void callBarPlot(
     Plotter& self,
     py::array_t<float> yData,
-    std::optional<std::reference_wrapper<const std::vector<T>>> dates,
+    OptionalDateVector dates,
     int linkedSubplotIdx,
     std::vector<float> color,
     double widthRatio,
@@ -222,15 +374,14 @@ void callBarPlot(
         minValue
     };
 
-    self.bar(yPtr, ySize, dates, settings, linkedSubplotIdx);
+    callPlotter(self, [&] { self.bar(yPtr, ySize, dates, settings, linkedSubplotIdx); });
 }
 
 
-template <typename T>
 void callLinePlot(
     Plotter& self,
     py::array_t<float> yData,
-    std::optional<std::reference_wrapper<const std::vector<T>>> dates,
+    OptionalDateVector dates,
     int linkedSubplotIdx,
     std::vector<float> color,
     double width,
@@ -244,7 +395,7 @@ void callLinePlot(
 
     LineSettings settings{ color, width, miterLimit, basicLine};
 
-    self.line(yPtr, ySize, dates, settings, linkedSubplotIdx);
+    callPlotter(self, [&] { self.line(yPtr, ySize, dates, settings, linkedSubplotIdx); });
 }
 
 // -----------------------------------------------------------------------------
@@ -277,6 +428,61 @@ PYBIND11_MODULE(pythonBindings, m)
             return vec;
         }));
 
+    py::class_<EpochNsDates>(m, "EpochNsDates")
+        .def(py::init([](py::array_t<std::int64_t, py::array::c_style | py::array::forcecast> array) {
+            if (array.ndim() != 1)
+            {
+                throw std::invalid_argument("Dates must be a one-dimensional array.");
+            }
+            return EpochNsDates{array};
+        }));
+
+    py::class_<CandleColumnFile>(m, "CandleColumnFile")
+        .def(py::init<const std::string&>(), py::arg("filepath"))
+        .def("__len__", &CandleColumnFile::size)
+        .def_property_readonly("block_size", &CandleColumnFile::blockSize)
+        .def("has_column", [](const CandleColumnFile& self, std::string column) { return self.hasColumn(candleColumnStrToEnum(column)); }, py::arg("column"))
+        .def("has_dates", &CandleColumnFile::hasDates)
+        // Views of the mapped file, each keeps the file open
+        .def("column",
+             [](py::object self, std::string column) { return arr_view(self.cast<const CandleColumnFile&>().column(candleColumnStrToEnum(column)), self); },
+             py::arg("column"))
+        .def("block_min",
+             [](py::object self, std::string column) { return arr_view(self.cast<const CandleColumnFile&>().blockMin(candleColumnStrToEnum(column)), self); },
+             py::arg("column"))
+        .def("block_max",
+             [](py::object self, std::string column) { return arr_view(self.cast<const CandleColumnFile&>().blockMax(candleColumnStrToEnum(column)), self); },
+             py::arg("column"))
+        .def("dates_epoch_ns",
+             [](py::object self) { return arr_view(self.cast<const CandleColumnFile&>().dates(), self); });
+
+    // The GIL is released so producer threads run in parallel (and a blocked push does not stall the GUI thread)
+    py::class_<CandleStream, std::shared_ptr<CandleStream>>(m, "CandleStream")
+        .def("append_candle",
+             [](CandleStream& self, float open, float high, float low, float close, std::optional<std::int64_t> dateEpochNs)
+             {
+                 py::gil_scoped_release release;
+                 self.appendCandle(open, high, low, close, dateEpochNs);
+             },
+             py::arg("open"),
+             py::arg("high"),
+             py::arg("low"),
+             py::arg("close"),
+             py::arg("date_epoch_ns") = py::none()
+        )
+        .def("update_last_candle",
+             [](CandleStream& self, float open, float high, float low, float close)
+             {
+                 py::gil_scoped_release release;
+                 self.updateLastCandle(open, high, low, close);
+             },
+             py::arg("open"),
+             py::arg("high"),
+             py::arg("low"),
+             py::arg("close")
+        )
+        .def("num_dropped", &CandleStream::numDropped);
+
     py::class_<Plotter>(m, "Plotter")
         .def(
             py::init(
@@ -289,7 +495,11 @@ PYBIND11_MODULE(pythonBindings, m)
                     int axisTickLabelFontSize,
                     bool axisRight,
                     int widthMarginSize,
-                    int heightMarginSize
+                    int heightMarginSize,
+                    bool headless,
+                    bool uiThread,
+                    bool programBinaryCache,
+                    std::optional<std::string> programBinaryCacheDir
                    )
                 {
                     // TODO: centralise this conversion properly
@@ -306,6 +516,10 @@ PYBIND11_MODULE(pythonBindings, m)
                         axisRight,
                         widthMarginSize,
                         heightMarginSize,
+                        headless,
+                        uiThread,
+                        programBinaryCache,
+                        programBinaryCacheDir.value_or(""),
                     };
 
                     return std::make_unique<Plotter>(plotterArgs);
@@ -319,14 +533,23 @@ PYBIND11_MODULE(pythonBindings, m)
             py::arg("axis_tick_label_font_size") = defaultPlotterArgs.axisTickLabelFontSize,
             py::arg("axis_right") = defaultPlotterArgs.axisRight,
             py::arg("width_margin_size") = defaultPlotterArgs.widthMarginSize,
-            py::arg("height_margin_size") = defaultPlotterArgs.heightMarginSize
+            py::arg("height_margin_size") = defaultPlotterArgs.heightMarginSize,
+            py::arg("headless") = defaultPlotterArgs.headless,
+            py::arg("ui_thread") = defaultPlotterArgs.uiThread,
+            py::arg("program_binary_cache") = defaultPlotterArgs.programBinaryCache,
+            py::arg("program_binary_cache_dir") = py::none()
         )
-        .def("start", [](Plotter& self){ self.start(); })
+        // With a UI thread, waiting for the window to close does not need the GIL, so other
+        // Python threads (e.g. feeding a CandleStream) keep running. Otherwise the event loop
+        // runs on this thread, and the GIL is kept so no other thread can call the Plotter
+        // while it runs (calls are only marshalled to the event loop with a UI thread).
+        .def("start", [](Plotter& self){ callPlotter(self, [&] { self.start(); }); })
+        .def("start_async", [](Plotter& self){ self.startAsync(); }, py::call_guard<py::gil_scoped_release>())
         .def("set_background_color",
              [](Plotter& self,
                 std::vector<float> backgroundColor)
              {
-                 self.setBackgroundColor(backgroundColor);
+                 callPlotter(self, [&] { self.setBackgroundColor(backgroundColor); });
              },
              py::arg("color")
              )
@@ -352,7 +575,7 @@ PYBIND11_MODULE(pythonBindings, m)
                     lockMostRecentDate,
                     fixZoomAtEdge
                 };
-                self.setCameraSettings(cameraSettings);
+                callPlotter(self, [&] { self.setCameraSettings(cameraSettings); });
             },
             py::arg("key_zoom_speed") = defaultCameraSettings.keyZoomSpeed,
             py::arg("mouse_zoom_speed") = defaultCameraSettings.mouseZoomSpeed,
@@ -384,7 +607,7 @@ PYBIND11_MODULE(pythonBindings, m)
                     backgroundColor,
                     fontColor
                 };
-                self.setCrosshairSettings(crosshairSettings);
+                callPlotter(self, [&] { self.setCrosshairSettings(crosshairSettings); });
             },
             py::arg("on") = defaultCrosshairSettings.on,
             py::arg("font") = "arial",
@@ -398,7 +621,7 @@ PYBIND11_MODULE(pythonBindings, m)
             [](Plotter& self, double linewidth, std::optional<std::vector<float>> color)
             {
                DrawLineSettings drawLineSettings {static_cast<float>(linewidth), color};
-               self.setDrawLineSettings(drawLineSettings);
+               callPlotter(self, [&] { self.setDrawLineSettings(drawLineSettings); });
             },
             py::arg("linewidth") = defaultDrawLineSettings.linewidth,
             py::arg("color") = defaultDrawLineSettings.color
@@ -424,7 +647,7 @@ PYBIND11_MODULE(pythonBindings, m)
                 hoverValueSettings.backgroundColor = backgroundColor;
                 hoverValueSettings.borderColor = borderColor;
 
-                self.setHoverValueSettings(hoverValueSettings);
+                callPlotter(self, [&] { self.setHoverValueSettings(hoverValueSettings); });
              },
 
              py::arg("display_mode") = "always_show",
@@ -468,7 +691,7 @@ PYBIND11_MODULE(pythonBindings, m)
                 axisSettings.axisColor = axisColor;
                 axisSettings.fontColor = fontColor;
 
-                self.setXAxisSettings(axisSettings, linkedSubplotIdx);
+                callPlotter(self, [&] { self.setXAxisSettings(axisSettings, linkedSubplotIdx); });
              },
              py::arg("min_num_ticks") = defaultXAxisSettings.minNumTicks,
              py::arg("max_num_ticks") = defaultXAxisSettings.maxNumTicks,
@@ -518,7 +741,7 @@ PYBIND11_MODULE(pythonBindings, m)
                 axisSettings.axisColor = axisColor;
                 axisSettings.fontColor = fontColor;
 
-                self.setYAxisSettings(axisSettings, linkedSubplotIdx);
+                callPlotter(self, [&] { self.setYAxisSettings(axisSettings, linkedSubplotIdx); });
              },
              py::arg("min_num_ticks") = defaultYAxisSettings.minNumTicks,
              py::arg("max_num_ticks") = defaultYAxisSettings.maxNumTicks,
@@ -536,14 +759,14 @@ PYBIND11_MODULE(pythonBindings, m)
              py::arg("linked_subplot_idx") = py::none()
         )
 
-        .def("pin_y_axis", [](Plotter& self, bool on, std::optional<int> linkedSubplotIdx){ self.pinYAxis(on, linkedSubplotIdx ); },py::arg("on") = true, py::arg("linked_subplot_idx") = std::nullopt)
+        .def("pin_y_axis", [](Plotter& self, bool on, std::optional<int> linkedSubplotIdx){ callPlotter(self, [&] { self.pinYAxis(on, linkedSubplotIdx ); }); },py::arg("on") = true, py::arg("linked_subplot_idx") = std::nullopt)
         .def("set_y_limits",
              [](
                  Plotter& self,
                 std::optional<float> min,
                 std::optional<float> max,
                 std::optional<int> linkedSubplotIdx
-            ) { self.setYLimits(min, max, linkedSubplotIdx); },
+            ) { callPlotter(self, [&] { self.setYLimits(min, max, linkedSubplotIdx); }); },
              py::arg("min") = py::none(),
              py::arg("max") = py::none(),
              py::arg("linked_subplot_idx") = py::none()
@@ -553,11 +776,11 @@ PYBIND11_MODULE(pythonBindings, m)
                  Plotter& self,
                  std::optional<std::variant<int, std::string, std::chrono::system_clock::time_point>> min,
                  std::optional<std::variant<int, std::string, std::chrono::system_clock::time_point>> max
-               ) { self.setXLimits(min, max); },
+               ) { callPlotter(self, [&] { self.setXLimits(min, max); }); },
              py::arg("min") = py::none(),
              py::arg("max") = py::none()
         )
-        .def("link_y_axes", [](Plotter& self, bool on) { self.linkYAxis(on); }, py::arg("on") = true)
+        .def("link_y_axes", [](Plotter& self, bool on) { callPlotter(self, [&] { self.linkYAxis(on); }); }, py::arg("on") = true)
         .def("set_y_label",
             []
             (Plotter& self, std::string text, std::string font, std::string weight, int font_size, std::optional<std::vector<float>> color)
@@ -567,7 +790,7 @@ PYBIND11_MODULE(pythonBindings, m)
                     fontStrToEnum(font), weight, font_size, color
                 };
 
-                self.setYLabel(text, axisLabelSettings);
+                callPlotter(self, [&] { self.setYLabel(text, axisLabelSettings); });
             },
             py::arg("text"),
             py::arg("font") = "arial",
@@ -583,7 +806,7 @@ PYBIND11_MODULE(pythonBindings, m)
                      {
                          fontStrToEnum(font), weight, font_size, color
                      };
-                 self.setXLabel(text, axisLabelSettings);
+                 callPlotter(self, [&] { self.setXLabel(text, axisLabelSettings); });
             },
             py::arg("text"),
             py::arg("font") = "arial",
@@ -599,7 +822,7 @@ PYBIND11_MODULE(pythonBindings, m)
                      {
                          fontStrToEnum(font), weight, font_size, color
                      };
-                 self.setTitle(text, titleLabelSettings);
+                 callPlotter(self, [&] { self.setTitle(text, titleLabelSettings); });
              },
              py::arg("text"),
              py::arg("font") = "arial",
@@ -645,7 +868,7 @@ PYBIND11_MODULE(pythonBindings, m)
                     fontColor,
                     boxColor
                 };
-                self.setLegend(labelNames, legendSettings, linkedSubplotIdx);
+                callPlotter(self, [&] { self.setLegend(labelNames, legendSettings, linkedSubplotIdx); });
             },
 
 
@@ -672,21 +895,21 @@ PYBIND11_MODULE(pythonBindings, m)
                 int col,
                 int rowSpan,
                 int colSpan
-             ){ self.addSubplot(row, col, rowSpan, colSpan); },
+             ){ callPlotter(self, [&] { self.addSubplot(row, col, rowSpan, colSpan); }); },
              py::arg("row"),
              py::arg("col"),
              py::arg("row_span"),
              py::arg("col_span"))
-        .def("set_active_subplot", [](Plotter& self, int row, int col){ self.setActiveSubplot(row, col); }, py::arg("row"), py::arg("col"))
-        .def("resize_linked_subplots", [](Plotter& self, std::vector<double> yHeights){ self.resizeLinkedSubplots(yHeights); }, py::arg("y_heights"))
-        .def("add_linked_subplot", [](Plotter& self, float heightAsProportion) { self.addLinkedSubplot(heightAsProportion); }, py::arg("height_as_proportion"))
+        .def("set_active_subplot", [](Plotter& self, int row, int col){ callPlotter(self, [&] { self.setActiveSubplot(row, col); }); }, py::arg("row"), py::arg("col"))
+        .def("resize_linked_subplots", [](Plotter& self, std::vector<double> yHeights){ callPlotter(self, [&] { self.resizeLinkedSubplots(yHeights); }); }, py::arg("y_heights"))
+        .def("add_linked_subplot", [](Plotter& self, float heightAsProportion) { callPlotter(self, [&] { self.addLinkedSubplot(heightAsProportion); }); }, py::arg("height_as_proportion"))
         .def("_grab_frame_buffer",
              [](Plotter& self,
                 std::optional<int> row,
                 std::optional<int> col
             ){
 
-               std::tuple<std::vector<std::uint8_t>, int, int> frameBufferOutput = self._grabFrameBuffer(row, col);
+               std::tuple<std::vector<std::uint8_t>, int, int> frameBufferOutput = callPlotter(self, [&] { return self._grabFrameBuffer(row, col); });
                std::vector<std::uint8_t> buffer = std::get<0>(frameBufferOutput);
                int width = std::get<1>(frameBufferOutput);
                int height = std::get<2>(frameBufferOutput);
@@ -701,9 +924,90 @@ PYBIND11_MODULE(pythonBindings, m)
         py::arg("col") = py::none()
         )
         .def("resize",
-             [](Plotter& self, int width, int height){ self.resize(width, height); },
+             [](Plotter& self, int width, int height){ callPlotter(self, [&] { self.resize(width, height); }); },
              py::arg("width"), py::arg("height")
         )
+        .def("render_to_image",
+             [](Plotter& self, int width, int height, int dpi)
+            {
+               std::tuple<std::vector<std::uint8_t>, int, int> imageOutput = callPlotter(self, [&] { return self.renderToImage(width, height, dpi); });
+               const std::vector<std::uint8_t>& buffer = std::get<0>(imageOutput);
+
+               py::array_t<std::uint8_t> pyImage({std::get<2>(imageOutput), std::get<1>(imageOutput), 4});
+               std::memcpy(pyImage.mutable_data(), buffer.data(), buffer.size());
+
+               return pyImage;
+            },
+            py::arg("width"), py::arg("height"), py::arg("dpi") = 96
+        )
+        .def("save_png",
+             [](Plotter& self, std::string filepath, std::optional<int> width, std::optional<int> height, int dpi)
+            {
+               callPlotter(self, [&] { self.savePng(filepath, width, height, dpi); });
+            },
+            py::arg("filepath"), py::arg("width") = py::none(), py::arg("height") = py::none(), py::arg("dpi") = 96
+        )
+        .def("enable_profiler",
+             [](Plotter& self, bool enabled)
+            {
+               callPlotter(self, [&] { self.enableProfiler(enabled); });
+            },
+            py::arg("enabled") = true
+        )
+        .def("profiler_stats",
+             [](Plotter& self)
+            {
+               std::vector<ProfilerStageStats> stats = callPlotter(self, [&] { return self.profilerStats(); });
+
+               py::dict out;
+               py::list stage, numFrames, cpuP50, cpuP95, cpuP99, gpuP50, gpuP95, gpuP99;
+
+               for (const ProfilerStageStats& stageStats : stats)
+               {
+                   stage.append(stageStats.stage);
+                   numFrames.append(stageStats.numFrames);
+                   cpuP50.append(stageStats.cpuP50Ms);
+                   cpuP95.append(stageStats.cpuP95Ms);
+                   cpuP99.append(stageStats.cpuP99Ms);
+                   gpuP50.append(stageStats.gpuP50Ms);
+                   gpuP95.append(stageStats.gpuP95Ms);
+                   gpuP99.append(stageStats.gpuP99Ms);
+               }
+               out["stage"] = stage;
+               out["num_frames"] = numFrames;
+               out["cpu_p50_ms"] = cpuP50;
+               out["cpu_p95_ms"] = cpuP95;
+               out["cpu_p99_ms"] = cpuP99;
+               out["gpu_p50_ms"] = gpuP50;
+               out["gpu_p95_ms"] = gpuP95;
+               out["gpu_p99_ms"] = gpuP99;
+
+               return out;
+            }
+        )
+        .def("startup_stats",
+             [](Plotter& self)
+            {
+               StartupStats stats = callPlotter(self, [&] { return self.startupStats(); });
+
+               py::dict out;
+               out["application_ms"] = stats.applicationMs;
+               out["window_setup_ms"] = stats.windowSetupMs;
+               out["first_frame_ms"] = stats.firstFrameMs;
+               out["first_frame_draw_ms"] = stats.firstFrameDrawMs;
+               out["deferred_work_ms"] = stats.deferredWorkMs;
+               out["deferred_work_done_ms"] = stats.deferredWorkDoneMs;
+
+               return out;
+            }
+        )
+        .def("save_profiler_trace",
+             [](Plotter& self, std::string filepath)
+            {
+               callPlotter(self, [&] { self.saveProfilerTrace(filepath); });
+            },
+            py::arg("filepath")
+        )
 
         /* ----------------------------------------------------------------------------------------------------------------
             Plots
@@ -796,6 +1100,168 @@ PYBIND11_MODULE(pythonBindings, m)
              py::keep_alive<1, 5>(),  // self keeps close
              py::keep_alive<1, 6>()   // self keeps dates
         )
+        .def("candlestick",
+             [](Plotter& self,
+                py::array_t<float> open,
+                py::array_t<float> high,
+                py::array_t<float> low,
+                py::array_t<float> close,
+                std::optional<EpochNsDatesRef> dates,
+                int linkedSubplotIdx,
+                std::vector<float> upColor,
+                std::vector<float> downColor,
+                std::string mode,
+                double candleWidthRatio,
+                double capWidthRatio,
+                double lineModeLinewidth,
+                double lineModeMiterLimit,
+                bool lineModeBasicLine
+                )
+             {
+                callCandlestickPlot(
+                    self, open, high, low, close, epochNsDatesToDateVector(dates), linkedSubplotIdx, upColor, downColor, mode, candleWidthRatio, capWidthRatio, lineModeLinewidth, lineModeMiterLimit, lineModeBasicLine
+                );
+             },
+             py::arg("open"),
+             py::arg("high"),
+             py::arg("low"),
+             py::arg("close"),
+             py::arg("dates") = py::none(),
+             py::arg("linked_subplot_idx") = 0,
+             py::arg("up_color") = defaultCandlestickSettings.upColor,
+             py::arg("down_color") = defaultCandlestickSettings.downColor,
+             py::arg("mode") = "full",
+             py::arg("candle_width_ratio") = defaultCandlestickSettings.candleWidthRatio,
+             py::arg("cap_width_ratio") = defaultCandlestickSettings.capWidthRatio,
+             py::arg("line_mode_linewidth") = defaultCandlestickSettings.lineModeLinewidth,
+             py::arg("line_mode_miter_limit") = defaultCandlestickSettings.lineModeMiterLimit,
+             py::arg("line_mode_basic_line") = defaultCandlestickSettings.lineModeBasicLine,
+             py::keep_alive<1, 2>(),  // self keeps open
+             py::keep_alive<1, 3>(),  // self keeps high
+             py::keep_alive<1, 4>(),  // self keeps low
+             py::keep_alive<1, 5>(),  // self keeps close
+             py::keep_alive<1, 6>()   // self keeps dates
+        )
+        .def("candlestick_from_file",
+             [](Plotter& self,
+                const CandleColumnFile& file,
+                int linkedSubplotIdx,
+                std::vector<float> upColor,
+                std::vector<float> downColor,
+                std::string mode,
+                double candleWidthRatio,
+                double capWidthRatio,
+                double lineModeLinewidth,
+                double lineModeMiterLimit,
+                bool lineModeBasicLine
+                )
+             {
+                 CandlestickSettings settings{
+                     upColor,
+                     downColor,
+                     candlestickModeStrToEnum(mode),
+                     candleWidthRatio,
+                     capWidthRatio,
+                     lineModeLinewidth,
+                     lineModeMiterLimit,
+                     lineModeBasicLine
+                 };
+
+                 callPlotter(self, [&] { self.candlestick(file, settings, linkedSubplotIdx); });
+             },
+             py::arg("file"),
+             py::arg("linked_subplot_idx") = 0,
+             py::arg("up_color") = defaultCandlestickSettings.upColor,
+             py::arg("down_color") = defaultCandlestickSettings.downColor,
+             py::arg("mode") = "full",
+             py::arg("candle_width_ratio") = defaultCandlestickSettings.candleWidthRatio,
+             py::arg("cap_width_ratio") = defaultCandlestickSettings.capWidthRatio,
+             py::arg("line_mode_linewidth") = defaultCandlestickSettings.lineModeLinewidth,
+             py::arg("line_mode_miter_limit") = defaultCandlestickSettings.lineModeMiterLimit,
+             py::arg("line_mode_basic_line") = defaultCandlestickSettings.lineModeBasicLine,
+             py::keep_alive<1, 2>()  // self keeps the file (mapped data)
+        )
+
+        // Appended data is copied on the C++ side, so no keep_alive is required.
+        .def("append_candles",
+             [](Plotter& self,
+                py::array_t<float> open,
+                py::array_t<float> high,
+                py::array_t<float> low,
+                py::array_t<float> close,
+                std::optional<StringVectorRef> dates,
+                int linkedSubplotIdx
+                )
+             {
+                 callAppendCandles(self, open, high, low, close, dates, linkedSubplotIdx);
+             },
+             py::arg("open"),
+             py::arg("high"),
+             py::arg("low"),
+             py::arg("close"),
+             py::arg("dates") = py::none(),
+             py::arg("linked_subplot_idx") = -1
+        )
+        .def("append_candles",
+             [](Plotter& self,
+                py::array_t<float> open,
+                py::array_t<float> high,
+                py::array_t<float> low,
+                py::array_t<float> close,
+                std::optional<TimepointVectorRef> dates,
+                int linkedSubplotIdx
+                )
+             {
+                 callAppendCandles(self, open, high, low, close, dates, linkedSubplotIdx);
+             },
+             py::arg("open"),
+             py::arg("high"),
+             py::arg("low"),
+             py::arg("close"),
+             py::arg("dates") = py::none(),
+             py::arg("linked_subplot_idx") = -1
+        )
+        .def("append_candles",
+             [](Plotter& self,
+                py::array_t<float> open,
+                py::array_t<float> high,
+                py::array_t<float> low,
+                py::array_t<float> close,
+                std::optional<EpochNsDatesRef> dates,
+                int linkedSubplotIdx
+                )
+             {
+                 callAppendCandles(self, open, high, low, close, epochNsDatesToDateVector(dates), linkedSubplotIdx);
+             },
+             py::arg("open"),
+             py::arg("high"),
+             py::arg("low"),
+             py::arg("close"),
+             py::arg("dates") = py::none(),
+             py::arg("linked_subplot_idx") = -1
+        )
+        .def("update_last_candle",
+             [](Plotter& self, float open, float high, float low, float close, int linkedSubplotIdx)
+             {
+                 callPlotter(self, [&] { self.updateLastCandle(open, high, low, close, linkedSubplotIdx); });
+             },
+             py::arg("open"),
+             py::arg("high"),
+             py::arg("low"),
+             py::arg("close"),
+             py::arg("linked_subplot_idx") = -1
+        )
+        .def("candle_stream",
+             [](Plotter& self, int linkedSubplotIdx, std::string backpressure)
+             {
+                 CandleStreamSettings streamSettings;
+                 streamSettings.backpressure = backpressurePolicyStrToEnum(backpressure);
+
+                 return callPlotter(self, [&] { return self.candleStream(linkedSubplotIdx, streamSettings); });
+             },
+             py::arg("linked_subplot_idx") = -1,
+             py::arg("backpressure") = "merge"
+        )
 
         .def("line",
             [](Plotter& self,
@@ -843,6 +1309,29 @@ PYBIND11_MODULE(pythonBindings, m)
             py::keep_alive<1, 2>(),  // self keeps yData
             py::keep_alive<1, 3>()
         )
+        .def("line",
+            [](Plotter& self,
+               py::array_t<float> yData,
+               std::optional<EpochNsDatesRef> dates,
+               int linkedSubplotIdx,
+               std::vector<float> color,
+               double width,
+               double miterLimit,
+               bool basicLine
+               )
+            {
+               callLinePlot(self, yData, epochNsDatesToDateVector(dates), linkedSubplotIdx, color, width, miterLimit, basicLine);
+            },
+            py::arg("y"),
+            py::arg("dates") = py::none(),
+            py::arg("linked_subplot_idx") = 0,
+            py::arg("color") = defaultLineSettings.color,
+            py::arg("width") = defaultLineSettings.width,
+            py::arg("miter_limit") = defaultLineSettings.miterLimit,
+            py::arg("basic_line") = defaultLineSettings.basicLine,
+            py::keep_alive<1, 2>(),  // self keeps yData
+            py::keep_alive<1, 3>()
+        )
 
         .def("bar",
              [](Plotter& self,
@@ -886,11 +1375,32 @@ PYBIND11_MODULE(pythonBindings, m)
              py::keep_alive<1, 2>(),  // self keeps yData
              py::keep_alive<1, 3>()
         )
+        .def("bar",
+             [](Plotter& self,
+                py::array_t<float> yData,
+                std::optional<EpochNsDatesRef> dates,
+                int linkedSubplotIdx,
+                std::vector<float> color,
+                double widthRatio,
+                std::optional<float> minValue
+                )
+             {
+                 callBarPlot(self, yData, epochNsDatesToDateVector(dates), linkedSubplotIdx, color, widthRatio, minValue);
+             },
+             py::arg("y"),
+             py::arg("dates") = py::none(),
+             py::arg("linked_subplot_idx") = 0,
+             py::arg("color") = defaultBarSettings.color,
+             py::arg("width_ratio") = defaultBarSettings.widthRatio,
+             py::arg("min_value") = py::none(),
+             py::keep_alive<1, 2>(),  // self keeps yData
+             py::keep_alive<1, 3>()
+        )
 
         // Scatter variant is okay because its not within an optional
         .def("scatter",
              [](Plotter& self,
-                std::variant<py::array_t<int>, StringVectorRef, TimepointVectorRef> xData,
+                std::variant<py::array_t<int>, StringVectorRef, TimepointVectorRef, EpochNsDatesRef> xData,
                 py::array_t<float> yData,
                 int linkedSubplotIdx,
                 std::string shape,
@@ -915,12 +1425,17 @@ PYBIND11_MODULE(pythonBindings, m)
                  if (std::holds_alternative<StringVectorRef>(xData))
                  {
                      StringVectorRef x = std::get<StringVectorRef>(xData);
-                     self.scatter(x, yPtr, ySize, settings, linkedSubplotIdx);
+                     callPlotter(self, [&] { self.scatter(x, yPtr, ySize, settings, linkedSubplotIdx); });
                  }
                  else if (std::holds_alternative<TimepointVectorRef>(xData))
                  {
                      TimepointVectorRef x = std::get<TimepointVectorRef>(xData);
-                    self.scatter(x, yPtr, ySize, settings, linkedSubplotIdx);
+                    callPlotter(self, [&] { self.scatter(x, yPtr, ySize, settings, linkedSubplotIdx); });
+                 }
+                 else if (std::holds_alternative<EpochNsDatesRef>(xData))
+                 {
+                     EpochNsVector x = std::get<EpochNsDatesRef>(xData).get().vector();
+                     callPlotter(self, [&] { self.scatter(x, yPtr, ySize, settings, linkedSubplotIdx); });
                  }
                  else
                  {
@@ -930,7 +1445,7 @@ PYBIND11_MODULE(pythonBindings, m)
                      int* xPtr = static_cast<int*>(bufferX.ptr);
                      std::size_t xSize = bufferX.shape[0];
 
-                     self.scatter(xPtr, xSize, yPtr, ySize, settings, linkedSubplotIdx);
+                     callPlotter(self, [&] { self.scatter(xPtr, xSize, yPtr, ySize, settings, linkedSubplotIdx); });
 
                  }
              },
@@ -1004,5 +1519,80 @@ PYBIND11_MODULE(pythonBindings, m)
           py::arg("volume_min") = defaultToyCandleStickdataSettings.volumeMin,
           py::arg("seed") = defaultToyCandleStickdataSettings.seed
         );
+
+    /* Read from disk
+   -------------------------------------------------------------------------*/
+
+    m.def("read_csv",
+          [](const std::string& filepath, unsigned int numThreads)
+          {
+              CandleDataCSV candleData;
+              {
+                  py::gil_scoped_release release;
+                  candleData = readCandleDataCSV(filepath, numThreads);
+              }
+
+              py::dict out;
+              out["open"]  = arr_move(std::move(candleData.open));
+              out["high"]  = arr_move(std::move(candleData.high));
+              out["low"]   = arr_move(std::move(candleData.low));
+              out["close"] = arr_move(std::move(candleData.close));
+
+              // ISO-8601 dates as int64 ns since the epoch, other dates as strings, or None
+              if (!candleData.datesEpochNs.empty())
+              {
+                  out["dates_epoch_ns"] = arr_move(std::move(candleData.datesEpochNs));
+              }
+              else if (!candleData.dates.empty())
+              {
+                  py::list dates;
+                  for (const std::string& date : candleData.dates)
+                  {
+                      dates.append(date);
+                  }
+                  out["dates"] = std::move(dates);
+              }
+              return out;
+          },
+          py::arg("filepath"),
+          py::arg("num_threads") = 0
+        );
+
+    m.def("write_candle_column_file",
+          [](const std::string& filepath,
+             py::array_t<float, py::array::c_style | py::array::forcecast> open,
+             py::array_t<float, py::array::c_style | py::array::forcecast> high,
+             py::array_t<float, py::array::c_style | py::array::forcecast> low,
+             py::array_t<float, py::array::c_style | py::array::forcecast> close,
+             std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> volume,
+             std::optional<EpochNsDates> dates)
+          {
+              auto view = [](const py::array_t<float, py::array::c_style | py::array::forcecast>& array) {
+                  return StdPtrVector<float>(array.data(), array.size());
+              };
+
+              std::optional<StdPtrVector<float>> volumeView = std::nullopt;
+              if (volume.has_value())
+              {
+                  volumeView = view(volume.value());
+              }
+
+              std::optional<EpochNsVector> datesView = std::nullopt;
+              if (dates.has_value())
+              {
+                  datesView = dates->vector();
+              }
+
+              py::gil_scoped_release release;
+              writeCandleColumnFile(filepath, view(open), view(high), view(low), view(close), volumeView, datesView);
+          },
+          py::arg("filepath"),
+          py::arg("open"),
+          py::arg("high"),
+          py::arg("low"),
+          py::arg("close"),
+          py::arg("volume") = py::none(),
+          py::arg("dates") = py::none()
+        );
 };
 
@@ -170,6 +170,8 @@ void AxesObject::initXTicks(int numDataPoints)
     double range = m_linkedSubplot.camera().getViewWidth() / initNumTicks;
 
     m_XTickDelta = roundToCandleWidth(range);
+
+    m_xTickLabelKey = std::nullopt;
 }
 
 
@@ -194,6 +196,7 @@ void AxesObject::initYTicks()
     m_firstYTick = yTicks.lmin;
     m_YTickDelta = yTicks.lstep;
 
+    m_yTickLabelKey = std::nullopt;
 }
 
 
@@ -208,16 +211,22 @@ void AxesObject::drawYAxesAndTicks(
     Coordinate drawing of all axes, ticks, labels and gridlines.
 */
 {
-    updateYTicksZoom();
-    updateYTicksPan();
+    {
+        ProfileScope scope(m_linkedSubplot.profiler(), ProfileStage::ticks);
+        updateYTicksZoom();
+        updateYTicksPan();
+    }
     drawYTicks(viewportTransform, NDCMatrix, yHeightProportion);
 }
 
 
 void AxesObject::drawXAxesAndTicks(glm::mat4& viewportTransform)
 {
-    updateXTicksZoom();
-    updateXTicksPan();
+    {
+        ProfileScope scope(m_linkedSubplot.profiler(), ProfileStage::ticks);
+        updateXTicksZoom();
+        updateXTicksPan();
+    }
     drawXTicks(viewportTransform);
 }
 
@@ -290,25 +299,33 @@ void AxesObject::drawXTicks(glm::mat4& viewportTransform)
 
     float axisPos = -1.0f;
 
-    drawTicksAndGridlines(
-        viewportTransform,
-        tickStartView,
-        tickDeltaView,
-        startAtLowestIdx,
-        1,  // isX,
-        axisPos,
-        m_linkedSubplot.xAxisSettings()
-    );
+    {
+        ProfileScope scope(m_linkedSubplot.profiler(), ProfileStage::ticks);
+
+        drawTicksAndGridlines(
+            viewportTransform,
+            tickStartView,
+            tickDeltaView,
+            startAtLowestIdx,
+            1,  // isX,
+            axisPos,
+            m_linkedSubplot.xAxisSettings()
+        );
+    }
 
     axisPos -= m_linkedSubplot.yAxisSettings().tickSize;
 
-    drawXTickLabels(
-        viewportTransform,
-        tickStartView,
-        tickDeltaView,
-        startAtLowestIdx,
-        axisPos
-    );
+    {
+        ProfileScope scope(m_linkedSubplot.profiler(), ProfileStage::tickLabels);
+
+        drawXTickLabels(
+            viewportTransform,
+            tickStartView,
+            tickDeltaView,
+            startAtLowestIdx,
+            axisPos
+        );
+    }
 }
 
 
@@ -328,28 +345,36 @@ void AxesObject::drawYTicks(glm::mat4& viewportTransform, glm::mat4 NDCMatrix, d
     int startAtLowestIdx = 1;
     int isX = 0;
 
-    drawTicksAndGridlines(
-        viewportTransform,
-        tickStartView,
-        tickDeltaView,
-        startAtLowestIdx,   
-        isX,                 
-        axisPos,
-        m_linkedSubplot.yAxisSettings()
-    );
+    {
+        ProfileScope scope(m_linkedSubplot.profiler(), ProfileStage::ticks);
+
+        drawTicksAndGridlines(
+            viewportTransform,
+            tickStartView,
+            tickDeltaView,
+            startAtLowestIdx,   
+            isX,                 
+            axisPos,
+            m_linkedSubplot.yAxisSettings()
+        );
+    }
 
     // Make a small offset to move the label away from the axis (i.e. in positive
     // or negative direction depending on the axis x-position (-1 or +1)
     axisPos += axisPos * m_linkedSubplot.yAxisSettings().tickSize / 2;
 
-    drawYTickLabels(
-        viewportTransform,
-        tickStartView,
-        tickDeltaView,
-        startAtLowestIdx,
-        axisPos,
-        yHeightProportion
-    );
+    {
+        ProfileScope scope(m_linkedSubplot.profiler(), ProfileStage::tickLabels);
+
+        drawYTickLabels(
+            viewportTransform,
+            tickStartView,
+            tickDeltaView,
+            startAtLowestIdx,
+            axisPos,
+            yHeightProportion
+        );
+    }
 }
 
 
@@ -370,6 +395,10 @@ void AxesObject::drawXTickLabels(
     One the list of tick labels is generated, we write them to the 
     vertex array buffer draw them. `drawXTickLabels` handles the
     low-level shader uniform setup and drawing.
+
+    The labels are only generated and written when the tick indices shown
+    change. Otherwise the buffer from the last frame is drawn, with the
+    tick positions set by uniform.
 */
 {
     float direction = (startAtLowestIdx) ? 1.0f : -1.0f;
@@ -398,30 +427,38 @@ void AxesObject::drawXTickLabels(
         tickIndicesVector.push_back(tickIndex);
     }
 
-    std::vector<std::string> allTickLabels;
-    int numChars = 0;
+    // Only format the labels and rebuild their glyphs if the ticks shown have changed
+    XTickLabelKey labelKey{tickIndicesVector, m_sharedXData.xDataVersion()};
 
-    bool isDatetime = m_sharedXData.getDateType() == DateType::Timepoint;
-
-    if (!isDatetime)
+    if (!m_xTickLabelKey.has_value() || !(m_xTickLabelKey.value() == labelKey))
     {
-        for (int i = 0; i < tickIndicesVector.size(); i++)
+        std::vector<std::string> allTickLabels;
+        int numChars = 0;
+
+        bool isDatetime = m_sharedXData.getDateType() == DateType::Timepoint;
+
+        if (!isDatetime)
         {
-            std::string label = m_sharedXData.getXTickLabelStr(tickIndicesVector[i]);
-            allTickLabels.push_back(label);
-            numChars += label.size();
+            for (int i = 0; i < tickIndicesVector.size(); i++)
+            {
+                std::string label = m_sharedXData.getXTickLabelStr(tickIndicesVector[i]);
+                allTickLabels.push_back(label);
+                numChars += label.size();
+            }
         }
-    }
-    else
-    {
-        allTickLabels = m_sharedXData.getXTickLabelDatetime(tickIndicesVector);
-        for (int i = 0; i < allTickLabels.size(); i++)
+        else
         {
-            numChars += allTickLabels[i].size();  // TODO: sort this out!
+            allTickLabels = m_sharedXData.getXTickLabelDatetime(tickIndicesVector);
+            for (int i = 0; i < allTickLabels.size(); i++)
+            {
+                numChars += allTickLabels[i].size();  // TODO: sort this out!
+            }
         }
-    }
 
-    m_linkedSubplot.axisTickLabels().xWriteTextToBuffer(allTickLabels, numChars);
+        m_xTickLabelKey = std::move(labelKey);
+        m_xTickLabelNumChars = m_linkedSubplot.axisTickLabels().xWriteTextToBuffer(allTickLabels, numChars);
+    }
+    int numChars = m_xTickLabelNumChars;
 
     m_linkedSubplot.axisTickLabels().drawXTickLabels(
         viewportTransform,
@@ -455,17 +492,26 @@ void AxesObject::drawYTickLabels(
 */
 {
     int numTicksShown = getNumTicksShown("y");
+    int decimalPlaces = m_linkedSubplot.yAxisSettings().tickLabelDecimalPlaces.value();
 
-    int numChars = 0;
-    std::vector<std::string> allTickLabels;
-    for (int i = 0; i < numTicksShown; i++)
+    YTickLabelKey labelKey{m_firstYTick, m_YTickDelta, numTicksShown, decimalPlaces};
+
+    if (!m_yTickLabelKey.has_value() || !(m_yTickLabelKey.value() == labelKey))
     {
-        std::string tickValue = fmt::format("{:.{}f}", (float)m_firstYTick + i * (float)m_YTickDelta, m_linkedSubplot.yAxisSettings().tickLabelDecimalPlaces.value());
-        numChars += tickValue.length();
-        allTickLabels.push_back(tickValue);
+        int numChars = 0;
+        std::vector<std::string> allTickLabels;
+        for (int i = 0; i < numTicksShown; i++)
+        {
+            std::string tickValue = fmt::format("{:.{}f}", (float)m_firstYTick + i * (float)m_YTickDelta, decimalPlaces);
+            numChars += tickValue.length();
+            allTickLabels.push_back(tickValue);
+        }
+
+        m_yTickLabelKey = labelKey;
+        m_yTickLabelNumChars = m_linkedSubplot.axisTickLabels().yWriteTextToBuffer(allTickLabels, numChars);
     }
+    int numChars = m_yTickLabelNumChars;
 
-    m_linkedSubplot.axisTickLabels().yWriteTextToBuffer(allTickLabels, numChars);
     m_linkedSubplot.axisTickLabels().drawYTickLabels(
         viewportTransform,
         tickStartView,
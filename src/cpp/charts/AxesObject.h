@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <optional>
+#include <vector>
 #include <glm.hpp>
 #include <gtc/matrix_transform.hpp>
 #include <QOpenGLFunctions_3_3_Core>
@@ -62,6 +65,9 @@ public:
 
     int getNumTicksShown(std::string axisName);
 
+    // (first x tick, x tick delta, first y tick, y tick delta)
+    std::array<double, 4> tickState() const { return {m_firstXTick, m_XTickDelta, m_firstYTick, m_YTickDelta}; };
+
 private:
 
     Configs& m_configs;
@@ -88,6 +94,39 @@ private:
 	double m_firstYTick;
 	double m_YTickDelta;
 
+    // The tick labels are only regenerated (and their glyphs re-written to the
+    // buffer) when the set of ticks shown changes, see drawXTickLabels().
+    // Pans that only move the ticks change the tick position uniforms only.
+    struct XTickLabelKey
+    {
+        std::vector<int> tickIndices;
+        std::size_t xDataVersion;
+
+        bool operator==(const XTickLabelKey& other) const
+        {
+            return tickIndices == other.tickIndices && xDataVersion == other.xDataVersion;
+        }
+    };
+
+    struct YTickLabelKey
+    {
+        double firstTick;
+        double tickDelta;
+        int numTicks;
+        int decimalPlaces;
+
+        bool operator==(const YTickLabelKey& other) const
+        {
+            return firstTick == other.firstTick && tickDelta == other.tickDelta &&
+                   numTicks == other.numTicks && decimalPlaces == other.decimalPlaces;
+        }
+    };
+
+    std::optional<XTickLabelKey> m_xTickLabelKey;
+    std::optional<YTickLabelKey> m_yTickLabelKey;
+    int m_xTickLabelNumChars = 0;
+    int m_yTickLabelNumChars = 0;
+
 	std::vector<std::string> m_yTickLabels;
 	int m_numYDigits;
 
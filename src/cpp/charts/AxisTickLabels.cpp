@@ -10,6 +10,7 @@
 #include "../opengl/VertexArrayObject.h"
 #include "shaders/Program.h"
 #include "../Configs.h"
+#include "../Utils.h"
 
 
 AxisTickLabels::AxisTickLabels(Configs& configs, LinkedSubplot& subplot, QOpenGLFunctions_3_3_Core& glFunctions)
@@ -23,7 +24,9 @@ AxisTickLabels::AxisTickLabels(Configs& configs, LinkedSubplot& subplot, QOpenGL
     ),
     m_xTickLabelVAO(m_gl),
     m_yTickLabelVAO(m_gl),
-    m_charTextureAtlas(glFunctions, GL_TEXTURE0, configs.m_plotOptions.axisTickLabelFont, configs.m_plotOptions.axisTickLabelFontSize * subplot.pixelRatio())
+    m_charTextureAtlas(GlyphAtlasCache::getAtlas(
+        configs.m_plotOptions.axisTickLabelFont, configs.m_plotOptions.axisTickLabelFontSize * subplot.pixelRatio(), glFunctions
+    ))
 {
     m_fontProgram.setupAndBindProgram();
 
@@ -99,29 +102,78 @@ void AxisTickLabels::setupVAO(unsigned int& VBO, std::vector<float>& fontBuffer)
 ----------------------------------------------------------------------------------------------------------*/
 
 
-void AxisTickLabels::yWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits)
+int AxisTickLabels::yWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits)
 {
-    writeTextToBuffer(allTickText, numDigits, m_yLabelVBO, m_yTickLabelVAO, false);
+    return writeTextToBuffer(allTickText, numDigits, m_yLabelVBO, m_yTickLabelVAO, false);
 }
 
 
-void AxisTickLabels::xWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits)
+int AxisTickLabels::xWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits)
 {
-    writeTextToBuffer(allTickText, numDigits, m_xLabelVBO, m_xTickLabelVAO, true);
+    return writeTextToBuffer(allTickText, numDigits, m_xLabelVBO, m_xTickLabelVAO, true);
 }
 
 
-void AxisTickLabels::writeTextToBuffer(const std::vector<std::string>& allTickText, int numDigits, unsigned int labelVBO, VertexArrayObject& labelVAO, bool isXAxis)
+int AxisTickLabels::writeTextToBuffer(const std::vector<std::string>& allTickText, int numDigits, unsigned int labelVBO, VertexArrayObject& labelVAO, bool isXAxis)
 /*
 	Each render loop interation, we need to update the tick labels that are drawn. First, the character
 	positions and texture atlas position are written to the VERTEX_ARRAY_BUFFER here (one for x axis, one for y-axis).
 
 	This function is shared between x and y axis, so the VBO identifier axis type must be passed.
+	Returns the number of characters written (`numDigits` counts bytes, which differ for non-ASCII text).
 */
 {
+    for (const std::string& tickText : allTickText)
+    {
+        m_charTextureAtlas->addCharacters(tickText);
+    }
+
     std::vector<float> vertices;
     vertices.reserve(numDigits);
 
+    layoutTickLabelVertices(
+        allTickText,
+        m_charTextureAtlas->chars(),
+        m_charTextureAtlas->textYSize(),
+        isXAxis,
+        m_configs.m_plotOptions.axisRight,
+        vertices
+    );
+
+    // Store the array in the buffer.
+    labelVAO.bind();
+
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, labelVBO);
+
+    m_gl.glBufferSubData(
+        GL_ARRAY_BUFFER,
+        0,
+        vertices.size() * sizeof(float),
+        vertices.data()
+    );
+
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+    labelVAO.unBind();
+
+    return vertices.size() / (6 * 5);
+}
+
+
+void AxisTickLabels::layoutTickLabelVertices(
+    const std::vector<std::string>& allTickText,
+    const std::unordered_map<char32_t, Character>& chars,
+    int textYSize,
+    bool isXAxis,
+    bool axisRight,
+    std::vector<float>& vertices
+)
+/*
+	Compute the vertices of the tick label glyphs, appended to `vertices`. Each (UTF-8) character
+	is two triangles of (x pos, y pos, tick index, texture x, texture y) vertices, texture positions
+	are in texels. All characters must be in `chars` (see CharTextureAtlas::addCharacters()). Kept
+	free of GL calls so it can be benchmarked without a context (see bench_cpu_hot_paths.cpp).
+*/
+{
     int numTicks = allTickText.size();
 
     // Cycle through each tick (for each tick, we have a multi-character label)
@@ -135,18 +187,20 @@ void AxisTickLabels::writeTextToBuffer(const std::vector<std::string>& allTickTe
         // adjusting position to center / left edge
         int tickLabelWidth = 0;
         {
-            for (const char& c : tickLabel)
+            std::size_t pos = 0;
+            while (pos < tickLabel.size())
             {
-                Character ch = m_charTextureAtlas.chars().at(c);
+                const Character& ch = chars.at(utils_nextUtf8Codepoint(tickLabel, pos));
 
                 tickLabelWidth += ch.size.x;
             }
         }
 
         // For each character, compute the offsets and store in the buffer
-        for (const char& c : tickLabel)
+        std::size_t pos = 0;
+        while (pos < tickLabel.size())
         {
-            Character ch =  m_charTextureAtlas.chars().at(c);
+            const Character& ch = chars.at(utils_nextUtf8Codepoint(tickLabel, pos));
 
             // Compute alignments that require length of the word at this stage. If
             // we are on the x-axis, shift y position down by 1 numeric glyph  so it
@@ -159,11 +213,11 @@ void AxisTickLabels::writeTextToBuffer(const std::vector<std::string>& allTickTe
             if (isXAxis)
             {
                 xpos = charXOffset + ch.bearing.x - (float)tickLabelWidth / 2;
-                ypos = 0 - (ch.size.y - ch.bearing.y) - m_charTextureAtlas.textYSize();
+                ypos = 0 - (ch.size.y - ch.bearing.y) - textYSize;
             }
             else
             {
-                if (m_configs.m_plotOptions.axisRight)
+                if (axisRight)
                 {
                     xpos = charXOffset + ch.bearing.x;
                 }
@@ -171,47 +225,29 @@ void AxisTickLabels::writeTextToBuffer(const std::vector<std::string>& allTickTe
                 {
                     xpos = charXOffset + ch.bearing.x - (float)tickLabelWidth;
                 }
-                ypos = 0.0f - (ch.size.y - ch.bearing.y) - (float)m_charTextureAtlas.textYSize() / 2.0f;
+                ypos = 0.0f - (ch.size.y - ch.bearing.y) - (float)textYSize / 2.0f;
             }
 
-            // Compute the position of this characters texture in the texture atlas.
-            float texelWidth = 1.0f / (float)m_charTextureAtlas.atlasWidth();
-            float texLeft = (float)ch.xTexturePos / (float)m_charTextureAtlas.atlasWidth();;
-            float texRight = ((float)ch.xTexturePos + (float)ch.size.x) / (float)m_charTextureAtlas.atlasWidth();;
-
-            texLeft += 0.5 * texelWidth;
-            texRight -= 0.5 * texelWidth;
+            // Compute the position of this characters texture in the texture atlas (texels).
+            float texLeft = (float)ch.xTexturePos + 0.5f;
+            float texRight = (float)(ch.xTexturePos + ch.size.x) - 0.5f;
+            float texTop = (float)ch.yTexturePos;
+            float texBottom = (float)(ch.yTexturePos + ch.size.y);
 
             // Store everything in the buffer to
             // be passed to font_vertex_shader
-            //                                x pos world              y pos world             tick             texture x pos (NDC)     texture y pos (NDC)
-            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)tick,       texLeft,                (float)((double)ch.size.y / (double)m_charTextureAtlas.atlasHeight()) });
-            vertices.insert(vertices.end(), { xpos,                    ypos + ch.size.y,     (float)tick,       texLeft,                0.0f });
-            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)tick,       texRight,               0.0f });
+            //                                x pos world              y pos world             tick             texture x pos           texture y pos
+            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)tick,       texLeft,                texBottom });
+            vertices.insert(vertices.end(), { xpos,                    ypos + ch.size.y,     (float)tick,       texLeft,                texTop });
+            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)tick,       texRight,               texTop });
 
-            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)tick,       texLeft,                (float)((double)ch.size.y / (double)m_charTextureAtlas.atlasHeight()) });
-            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)tick,       texRight,               0.0f });
-            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos,                 (float)tick,       texRight,               (float)((double)ch.size.y / (double)m_charTextureAtlas.atlasHeight()) });
+            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)tick,       texLeft,                texBottom });
+            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)tick,       texRight,               texTop });
+            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos,                 (float)tick,       texRight,               texBottom });
 
             charXOffset += (ch.advance >> 6);
         }
     }
-
-    // Store the array in the buffer.
-    labelVAO.bind();
-
-    m_gl.glBindBuffer(GL_ARRAY_BUFFER, labelVBO);
-
-    m_gl.glBufferSubData(
-        GL_ARRAY_BUFFER,
-        0,
-        vertices.size() * sizeof(float),
-        vertices.data()
-    );
-
-    m_gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
-    labelVAO.unBind();
-
 }
 
 
@@ -259,7 +295,7 @@ void AxisTickLabels::draw(glm::mat4& viewportTransform, float tickStartView, flo
         1.0f)
     );
 
-    m_charTextureAtlas.activateAndBind();
+    m_charTextureAtlas->activateAndBind(GL_TEXTURE0);
 
     m_fontProgram.bind();
     m_fontProgram.setUniform1f("axisPos", axisPos);
@@ -285,7 +321,7 @@ void AxisTickLabels::draw(glm::mat4& viewportTransform, float tickStartView, flo
 
     m_fontProgram.unBind();
     m_gl.glBindVertexArray(0);
-    m_charTextureAtlas.unBind();
+    m_charTextureAtlas->unBind();
     m_gl.glDisable(GL_BLEND);
 }
 
@@ -5,6 +5,9 @@
 #include <qfileinfo.h>
 #include FT_FREETYPE_H
 
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <QOpenGLFunctions_3_3_Core>
@@ -14,6 +17,7 @@
 #include "shaders/Program.h"
 #include "../Configs.h"
 #include "CharTextureAtlas.h"
+#include "GlyphAtlasCache.h"
 
 
 class LinkedSubplot; // forward declaration
@@ -21,14 +25,16 @@ class LinkedSubplot; // forward declaration
 
 class AxisTickLabels
 /*
-	Class to manage a texture atlas of TrueType chracter gylphs
-	and buffers used to draw text labels. The procedure is:
+	Class to manage the buffers used to draw text labels, with glyphs from
+	a texture atlas of TrueType character glyphs. The procedure is:
 
-	1) One-time setup of the atlas of all gylphs held in a single row texture
+	1) Get the atlas of the tick label font, shared with all other subplots
+	   (and legends) using the same font and size (see GlyphAtlasCache)
 
 	2) When time to draw tick labels, a vector of characters to draw is passed to
-	   writeTextToBuffer functions. This stores information on the characters to draw including
-	   x, y positioning offsets, as well as position in the texture atlas.
+	   writeTextToBuffer functions. Any characters not yet in the atlas are added, then
+	   information on the characters to draw is stored, including x, y positioning offsets,
+	   as well as position in the texture atlas.
 
 	3) The shader reads these buffers in and positions the characters appropriately,
 	   rendering them based on their positioning in the texture atlas.
@@ -49,8 +55,8 @@ public:
 	void xSetupVAO();
 	void ySetupVAO();
 
-    void yWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits);
-    void xWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits);
+    int yWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits);
+    int xWriteTextToBuffer(const std::vector<std::string>& allTickText, int numDigits);
 
     void drawYTickLabels(
         glm::mat4& viewportTransform,
@@ -75,6 +81,15 @@ public:
         int startAtLowestIdx
     );
 
+    static void layoutTickLabelVertices(
+        const std::vector<std::string>& allTickText,
+        const std::unordered_map<char32_t, Character>& chars,
+        int textYSize,
+        bool isXAxis,
+        bool axisRight,
+        std::vector<float>& vertices
+    );
+
 private:
 
     Configs& m_configs;
@@ -83,7 +98,7 @@ private:
     Program m_fontProgram;
     VertexArrayObject m_xTickLabelVAO;
     VertexArrayObject m_yTickLabelVAO;
-    CharTextureAtlas m_charTextureAtlas;
+    std::shared_ptr<CharTextureAtlas> m_charTextureAtlas;
 
 	void setupVAO(unsigned int& VBO, std::vector<float>& fontBuffer);
 
@@ -98,7 +113,7 @@ private:
 	std::vector<float> m_xLabelBuffer = std::vector<float>(m_maxEverBufferLength, 1.0f);
 
 	// Internal writers and drawers
-    void writeTextToBuffer(
+    int writeTextToBuffer(
         const std::vector<std::string>& allTickText,
         int numDigits,
         unsigned int labelVBO,
@@ -76,17 +76,20 @@ glm::mat4 Camera::getNDCMatrix()
 
     This includes an offset to set 0 as the left edge. This avoids rounding issues 
     for high number of candles. This needs to be matched in the vertex shader, and
-    so `m_left` is passed via a uniform as an offset to be applied there.
+    so `m_left` is passed via a uniform as an offset to be applied there. The view
+    width is taken in double before the cast, as for many candles the left and right
+    edges are close together relative to their size.
 */
 {
     if (m_sp.cameraSettings().yAxisLimitMode == YAxisMode::Pinned)
     {
+        ProfileScope scope(m_sp.profiler(), ProfileStage::pinnedYLimits);
         setYLimitsFromView();
     }
 
     glm::mat4 NDCMatrix = glm::ortho(
         0.0f, 
-        (float)m_right - (float)m_left, 
+        (float)(m_right - m_left), 
         (float)m_bottom, 
         (float)m_top, 
         -1.0f, 
@@ -113,6 +116,31 @@ void Camera::setYLimitsFromView()
 }
 
 
+void Camera::rescaleXView(int oldNumDatapoints, int newNumDatapoints)
+/*
+    The x-axis is normalised to [0, 1) so when datapoints are appended
+    every existing datapoint moves. Rescale the view so the same
+    datapoints remain in view. If the view was showing the most recent
+    datapoint, follow the new datapoints so the live edge stays in view.
+*/
+{
+    double oldMaxX = 1.0 - 1.0 / oldNumDatapoints;
+    bool followLatest = m_right >= oldMaxX;
+
+    double scale = (double)oldNumDatapoints / (double)newNumDatapoints;
+
+    m_left *= scale;
+    m_right *= scale;
+
+    if (followLatest)
+    {
+        double shift = (double)(newNumDatapoints - oldNumDatapoints) / (double)newNumDatapoints;
+        m_left += shift;
+        m_right += shift;
+    }
+}
+
+
 /* ----------------------------------------------------------------------------------------------------------
   Keyboard Zoom / Pan
  ----------------------------------------------------------------------------------------------------------*/
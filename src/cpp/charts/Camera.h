@@ -92,6 +92,7 @@ public:
 
     void setupView();
     void setYLimitsFromView();
+    void rescaleXView(int oldNumDatapoints, int newNumDatapoints);
 
     void storeViewClickPosition(double xClickPos, double clickPosPercent);
     void ensureZoomSwitchedModeOff();
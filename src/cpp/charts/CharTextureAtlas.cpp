@@ -1,42 +1,24 @@
 #include "../include/Plotter.h"
 #include "../Utils.h"
 #include "CharTextureAtlas.h"
-#include "freetype/freetype.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 
-CharTextureAtlas::CharTextureAtlas(
-    QOpenGLFunctions_3_3_Core& glFunctions,
-    GLenum glTextureId,
-    Font font,
-    int fontSize
-    ) : m_gl(glFunctions),
-    m_GL_TEXTURE(glTextureId),
-    m_fontName(utils_fontEnumToStr(font)),
-    m_fontSize(fontSize)
-{
-    setupCharTextureAtlas();
-};
-
-
-CharTextureAtlas::~CharTextureAtlas()
-{
-    m_gl.glDeleteTextures(1, &m_atlas);
-    m_atlas = 0;
-};
+/* --------------------------------------------------------------------------------------------------------
+	FontFace
+----------------------------------------------------------------------------------------------------------*/
 
 
-void CharTextureAtlas::setupCharTextureAtlas()
+FontFace::FontFace(Font font, int pixelSize)
 /*
-    Setup a texture atlas that includes all characters in a single row.
-
-    The key features of each char are stored in `m_characters`.
-    Sizes are in pixels.
+    Load the font from the Qt resources and setup the FreeType face
+    at `pixelSize`. Sizes are in pixels.
 */
 {
     // Initialise the freetype library
-    FT_Library ft;
-    if (FT_Init_FreeType(&ft))
+    if (FT_Init_FreeType(&m_ft))
     {
         // Use `cerr` here so we don't need to worry about resource leaks.
         std::cerr << "CRITICAL ERROR: Freetype could not init FreeType Library" << std::endl;
@@ -44,7 +26,7 @@ void CharTextureAtlas::setupCharTextureAtlas()
     }
 
     // Load the fonts
-    QString qrcFilename = QString::fromStdString(":/fonts/charts/fonts/" +  m_fontName + ".ttf");
+    QString qrcFilename = QString::fromStdString(":/fonts/charts/fonts/" +  utils_fontEnumToStr(font) + ".ttf");
 
     QFile file(qrcFilename);
 
@@ -53,82 +35,95 @@ void CharTextureAtlas::setupCharTextureAtlas()
         std::cerr << "CRITICAL ERROR: Freetype failed to open font from resources!" << std::endl;
         std::exit(EXIT_FAILURE);
     }
-    QByteArray fontData = file.readAll();
+    m_fontData = file.readAll();
     file.close();
 
-    FT_Face face;
-    if (FT_New_Memory_Face(ft, (const FT_Byte*)fontData.constData(), fontData.size(), 0, &face))
+    if (FT_New_Memory_Face(m_ft, (const FT_Byte*)m_fontData.constData(), m_fontData.size(), 0, &m_face))
     {
         std::cerr << "CRITICAL ERROR: Freetype failed to load font" << std::endl;
         std::exit(EXIT_FAILURE);
     }
 
-    FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(m_fontSize));
+    FT_Set_Pixel_Sizes(m_face, 0, static_cast<FT_UInt>(pixelSize));
 
-    // Find the total height and width that the character atlas will be
-    m_atlasWidth = 0;
-    m_atlasHeight = 0;
-    for (unsigned char c = 0; c < 128; c++)
-    {
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-        {
-            std::cerr << "CRITICAL ERROR: Freetype failed to load Glyph" << std::endl;
-            std::exit(EXIT_FAILURE);
-        }
-        m_atlasWidth += face->glyph->bitmap.width;
-        m_atlasHeight = std::max(m_atlasHeight, face->glyph->bitmap.rows);
+    // Store the size of a numeric character which is used later
+    m_numericTextYSize = rasterise('1').size.y;
+}
 
-    }
 
-    // Setup the texture in which the atlas will be bound
-    m_gl.glActiveTexture(m_GL_TEXTURE);
-    m_gl.glGenTextures(1, &m_atlas);
-    m_gl.glBindTexture(GL_TEXTURE_2D, m_atlas);
-    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    m_gl.glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_atlasWidth, m_atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+FontFace::~FontFace()
+{
+    // Important FreeType cleanup
+    FT_Done_Face(m_face);
+    FT_Done_FreeType(m_ft);
+}
 
-    // Fill the texture with all characters
-    int xTexturePos = 0;
-    for (unsigned char c = 0; c < 128; c++)
-    {
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-        {
-            std::cerr << "CRITICAL ERROR: Freetype failed to load Glyph" << std::endl;
-            std::exit(EXIT_FAILURE);
-        }
 
-        m_gl.glTexSubImage2D(
-            GL_TEXTURE_2D,
-            0,
-            xTexturePos,
-            0,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-            );
-
-        Character character = {
-            m_atlas,											// ID handle of the glyph texture
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),	// Size of glyph
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),		// Offset from baseline to left/top of glyph (bearing)
-            (int)face->glyph->advance.x,												// Offset to advance to for next character
-            xTexturePos,
-
-        };
-        m_characters.insert(std::pair<char, Character>(c, character));
-
-        xTexturePos += face->glyph->bitmap.width;
+const GlyphBitmap& FontFace::glyph(char32_t codepoint)
+/*
+    Return the glyph, rasterising it on first request. The returned reference stays
+    valid for the lifetime of the face (glyphs are never removed from the map).
+*/
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_glyphs.find(codepoint);
+
+    if (it != m_glyphs.end())
+    {
+        return it->second;
     }
+    return rasterise(codepoint);
+}
 
-    // Store the size of a numeric character which is used later
-    if (FT_Load_Char(face, '1', FT_LOAD_RENDER))
+
+const GlyphBitmap& FontFace::rasterise(char32_t codepoint)
+/*
+    Characters missing from the font are rendered as the font's
+    missing glyph (usually a box). Must be called with the lock held.
+*/
+{
+    if (FT_Load_Char(m_face, codepoint, FT_LOAD_RENDER))
     {
-        std::cerr << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
+        std::cerr << "CRITICAL ERROR: Freetype failed to load Glyph" << std::endl;
         std::exit(EXIT_FAILURE);
     }
-    m_numericTextYSize = face->glyph->bitmap.rows;
+
+    const FT_Bitmap& bitmap = m_face->glyph->bitmap;
+
+    GlyphBitmap glyph;
+    glyph.size = glm::ivec2(bitmap.width, bitmap.rows);                                  // Size of glyph
+    glyph.bearing = glm::ivec2(m_face->glyph->bitmap_left, m_face->glyph->bitmap_top);   // Offset from baseline to left/top of glyph (bearing)
+    glyph.advance = (int)m_face->glyph->advance.x;                                       // Offset to advance to for next character
+
+    // Copy row by row, as the rows of the FreeType bitmap may be padded (pitch)
+    glyph.pixels.resize(bitmap.width * bitmap.rows);
+
+    for (unsigned int row = 0; row < bitmap.rows; row++)
+    {
+        std::memcpy(glyph.pixels.data() + row * bitmap.width, bitmap.buffer + row * bitmap.pitch, bitmap.width);
+    }
+
+    return m_glyphs.emplace(codepoint, std::move(glyph)).first->second;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------
+	CharTextureAtlas
+----------------------------------------------------------------------------------------------------------*/
+
+
+CharTextureAtlas::CharTextureAtlas(
+    QOpenGLFunctions_3_3_Core& glFunctions,
+    std::shared_ptr<FontFace> fontFace
+    ) : m_gl(glFunctions),
+    m_fontFace(std::move(fontFace))
+/*
+    Setup an empty texture, glyphs are added as they are used.
+*/
+{
+    m_gl.glGenTextures(1, &m_atlas);
+    m_gl.glBindTexture(GL_TEXTURE_2D, m_atlas);
 
     // Set the texture configs
     m_gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -136,36 +131,143 @@ void CharTextureAtlas::setupCharTextureAtlas()
     m_gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     m_gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Important FreeType cleanup
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    resizeTexture(initialAtlasHeight);
 
-    // this must be turned off for Qt QPainter to work
-    // properly over OpenGl widget.
-    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-}
+    m_gl.glBindTexture(GL_TEXTURE_2D, 0);
+};
 
 
-void CharTextureAtlas::activateAndBind()
+CharTextureAtlas::~CharTextureAtlas()
 {
-    m_gl.glActiveTexture(m_GL_TEXTURE);
-    m_gl.glBindTexture(GL_TEXTURE_2D, m_atlas);
+    m_gl.glDeleteTextures(1, &m_atlas);
+    m_atlas = 0;
 };
 
-void CharTextureAtlas::unBind()
+
+void CharTextureAtlas::addCharacters(const std::string& text)
+/*
+    Make sure all characters of the (UTF-8) `text` are in the atlas.
+    This must be called before the text is laid out with chars().
+*/
 {
-    m_gl.glBindTexture(GL_TEXTURE_2D, 0);
-};
+    std::size_t pos = 0;
+    while (pos < text.size())
+    {
+        char32_t codepoint = utils_nextUtf8Codepoint(text, pos);
+
+        if (m_characters.find(codepoint) == m_characters.end())
+        {
+            insertCharacter(codepoint);
+        }
+    }
+}
+
+
+const Character& CharTextureAtlas::getCharacter(char32_t codepoint)
+{
+    auto it = m_characters.find(codepoint);
+
+    if (it != m_characters.end())
+    {
+        return it->second;
+    }
+    return insertCharacter(codepoint);
+}
 
 
-Character CharTextureAtlas::getCharacter(const char& char_)
+const Character& CharTextureAtlas::insertCharacter(char32_t codepoint)
+/*
+    Pack the glyph into the current shelf (starting a new shelf if it does
+    not fit the width, and growing the texture if it does not fit the height)
+    and upload it. Sizes are in pixels.
+*/
 {
-    try
+    const GlyphBitmap& glyph = m_fontFace->glyph(codepoint);
+
+    unsigned int width = glyph.size.x;
+    unsigned int height = glyph.size.y;
+
+    if (width > atlasWidth)
     {
-        return this->chars().at(char_);
+        throw std::runtime_error("CRITICAL ERROR: glyph is wider than the character texture atlas.");
     }
-    catch (const std::out_of_range& e)
+
+    if (m_shelfX + width > atlasWidth)
     {
-        std::cerr << "Cannot find the character '" + std::string(1, char_) + "' in the atlas." << std::endl;
+        m_shelfY += m_shelfHeight + glyphPadding;
+        m_shelfX = 0;
+        m_shelfHeight = 0;
     }
+
+    if (m_shelfY + height > m_atlasHeight)
+    {
+        unsigned int newHeight = m_atlasHeight;
+        while (m_shelfY + height > newHeight)
+        {
+            newHeight *= 2;
+        }
+        m_gl.glBindTexture(GL_TEXTURE_2D, m_atlas);
+        resizeTexture(newHeight);
+    }
+
+    for (unsigned int row = 0; row < height; row++)
+    {
+        std::copy_n(
+            glyph.pixels.data() + row * width,
+            width,
+            m_pixels.data() + (m_shelfY + row) * atlasWidth + m_shelfX
+        );
+    }
+
+    if (width > 0 && height > 0)
+    {
+        m_gl.glBindTexture(GL_TEXTURE_2D, m_atlas);
+        m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        m_gl.glTexSubImage2D(GL_TEXTURE_2D, 0, m_shelfX, m_shelfY, width, height, GL_RED, GL_UNSIGNED_BYTE, glyph.pixels.data());
+
+        // this must be turned off for Qt QPainter to work
+        // properly over OpenGl widget.
+        m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        m_gl.glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    Character character = {
+        glyph.size,
+        glyph.bearing,
+        glyph.advance,
+        (int)m_shelfX,
+        (int)m_shelfY
+    };
+
+    m_shelfX += width + glyphPadding;
+    m_shelfHeight = std::max(m_shelfHeight, height);
+
+    return m_characters.emplace(codepoint, character).first->second;
 }
+
+
+void CharTextureAtlas::resizeTexture(unsigned int newHeight)
+/*
+    Reallocate the (bound) texture with the new height and re-upload the
+    existing glyphs. Glyph texture positions are in texels so do not change.
+*/
+{
+    m_pixels.resize(atlasWidth * newHeight, 0);
+    m_atlasHeight = newHeight;
+
+    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    m_gl.glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlasWidth, m_atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, m_pixels.data());
+    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+
+void CharTextureAtlas::activateAndBind(GLenum textureUnit)
+{
+    m_gl.glActiveTexture(textureUnit);
+    m_gl.glBindTexture(GL_TEXTURE_2D, m_atlas);
+};
+
+void CharTextureAtlas::unBind()
+{
+    m_gl.glBindTexture(GL_TEXTURE_2D, 0);
+};
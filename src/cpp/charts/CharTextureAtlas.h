@@ -1,66 +1,130 @@
 #ifndef CHARTEXTUREATLAS_H
 #define CHARTEXTUREATLAS_H
 
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <glm.hpp>
 #include <qfileinfo.h>
 #include <qopenglfunctions_3_3_core.h>
 #include "../include/Plotter.h"
 
 struct Character {
-    unsigned int textureID;   // ID handle of the glyph texture
     glm::ivec2 size;          // Size of glyph
     glm::ivec2 bearing;       // Offset from baseline to left/top of glyph
     int advance;              // Offset to advance to next glyph
-    int xTexturePos;          // Offset in texture atlas (x)
+    int xTexturePos;          // Offset in texture atlas (x, texels)
+    int yTexturePos;          // Offset in texture atlas (y, texels)
+};
+
+
+struct GlyphBitmap {
+    glm::ivec2 size;
+    glm::ivec2 bearing;
+    int advance;
+    std::vector<unsigned char> pixels;  // size.x * size.y, one byte per pixel
+};
+
+
+class FontFace
+/*
+    A FreeType face of one font (.ttf in the /fonts directory) at one pixel size.
+    It is shared by every atlas of that font and size in the process (see
+    GlyphAtlasCache), so the font is read from the resources and each glyph
+    rasterised only once, however many subplots, legends and windows use it.
+
+    Glyphs are rasterised on first request. A mutex guards the face, as
+    plotters are not bound to a single thread (see Plotter::startAsync()).
+ */
+{
+public:
+
+    FontFace(Font font, int pixelSize);
+    ~FontFace();
+
+    FontFace(const FontFace&) = delete;
+    FontFace& operator=(const FontFace&) = delete;
+    FontFace(FontFace&&) = delete;
+    FontFace& operator=(FontFace&&) = delete;
+
+    const GlyphBitmap& glyph(char32_t codepoint);
+    int numericTextYSize() const { return m_numericTextYSize; };
+
+private:
+
+    const GlyphBitmap& rasterise(char32_t codepoint);
+
+    std::mutex m_mutex;
+    QByteArray m_fontData;  // must outlive m_face
+    FT_Library m_ft;
+    FT_Face m_face;
+    std::unordered_map<char32_t, GlyphBitmap> m_glyphs;
+    int m_numericTextYSize;
 };
 
 
 class CharTextureAtlas
 /*
-    Base texture atlas containing 126 characters (.ttf) of the fontName and fontSize
-    provided. fontName must match a font within the /fonts directory.
+    Texture atlas of the glyphs of a FontFace, shared by all axis tick labels and
+    legends with the same font and size on a context (see GlyphAtlasCache).
 
-    Multiple character atlases are used in order to allow different font sizes (e.g.
-    for axis labels vs. legend). A unique GL_TEXTURE<number> must be passed. Currently
-    used texture bindings are:
+    Glyphs are added on first use (addCharacters()), so any unicode character in
+    the font can be drawn. They are packed left to right into rows (shelves) of a
+    fixed-width texture, which doubles in height when full. Texture positions are
+    in texels and normalised in the font fragment shader with the texture size, so
+    growing the atlas does not invalidate text already written to buffers.
 
-    0 : axis labels (CharTextureAtlast)
+    The texture unit is chosen when binding. Currently used texture units are:
+
+    0 : axis labels (CharTextureAtlas)
     1 : scatterplot textures
-    2 : legend text (CharTextureAtlast)
+    2 : legend text (CharTextureAtlas)
  */
 {
 public:
 
-    CharTextureAtlas(
-        QOpenGLFunctions_3_3_Core& glFunctions,
-        GLenum glTextureId,
-        Font font,
-        int fontSize
-        );
+    CharTextureAtlas(QOpenGLFunctions_3_3_Core& glFunctions, std::shared_ptr<FontFace> fontFace);
     ~CharTextureAtlas();
 
-    const std::map<char, Character>& chars() { return m_characters; };
-    unsigned int atlasHeight() { return m_atlasHeight; };
-    unsigned int atlasWidth() { return m_atlasWidth; };
-    int textYSize() {return m_numericTextYSize; };
-    Character getCharacter(const char& char_);
-    void activateAndBind();
+    CharTextureAtlas(const CharTextureAtlas&) = delete;
+    CharTextureAtlas& operator=(const CharTextureAtlas&) = delete;
+    CharTextureAtlas(CharTextureAtlas&&) = delete;
+    CharTextureAtlas& operator=(CharTextureAtlas&&) = delete;
+
+    void addCharacters(const std::string& text);
+    const Character& getCharacter(char32_t codepoint);
+
+    const std::unordered_map<char32_t, Character>& chars() const { return m_characters; };
+    int textYSize() const { return m_fontFace->numericTextYSize(); };
+    void activateAndBind(GLenum textureUnit);
     void unBind();
 
 private:
 
+    static constexpr unsigned int atlasWidth = 1024;
+    static constexpr unsigned int initialAtlasHeight = 64;
+    static constexpr unsigned int glyphPadding = 1;  // empty texels between glyphs, so linear filtering does not bleed
+
+    const Character& insertCharacter(char32_t codepoint);
+    void resizeTexture(unsigned int newHeight);
+
     QOpenGLFunctions_3_3_Core& m_gl;
-    GLenum m_GL_TEXTURE;
-    std::string m_fontName;
-    int m_fontSize;
+    std::shared_ptr<FontFace> m_fontFace;
 
-    unsigned int m_atlas;
-    std::map<char, Character> m_characters;
-    unsigned int m_atlasWidth = 0;
+    unsigned int m_atlas = 0;
     unsigned int m_atlasHeight = 0;
-    int m_numericTextYSize;
+    std::vector<unsigned char> m_pixels;  // copy of the texture, re-uploaded when it grows
+    std::unordered_map<char32_t, Character> m_characters;
 
-    void setupCharTextureAtlas();
+    // Position of the next glyph
+    unsigned int m_shelfX = 0;
+    unsigned int m_shelfY = 0;
+    unsigned int m_shelfHeight = 0;
 };
 
 #endif // CHARTEXTUREATLAS_H
@@ -0,0 +1,85 @@
+#include "GlyphAtlasCache.h"
+#include "../Utils.h"
+
+
+std::shared_ptr<CharTextureAtlas> GlyphAtlasCache::getAtlas(
+    Font font,
+    int pixelSize,
+    QOpenGLFunctions_3_3_Core& glFunctions
+)
+/*
+    Return the atlas for this font and size on this context,
+    creating it (empty, filled on use) if it does not exist yet.
+ */
+{
+    std::map<AtlasKey, std::weak_ptr<CharTextureAtlas>>& cache = atlases();
+
+    AtlasKey key{&glFunctions, font, pixelSize};
+
+    std::shared_ptr<CharTextureAtlas> atlas = cache[key].lock();
+
+    if (!atlas)
+    {
+        atlas = std::make_shared<CharTextureAtlas>(glFunctions, getFontFace(font, pixelSize));
+        cache[key] = atlas;
+    }
+
+    return atlas;
+}
+
+
+std::shared_ptr<FontFace> GlyphAtlasCache::getFontFace(Font font, int pixelSize)
+/*
+    Return the process-wide face for this font and size,
+    reading the font only the first time it is requested.
+ */
+{
+    std::lock_guard<std::mutex> lock(fontFacesMutex());
+
+    std::shared_ptr<FontFace>& fontFace = fontFaces()[FontFaceKey{font, pixelSize}];
+
+    if (!fontFace)
+    {
+        fontFace = std::make_shared<FontFace>(font, pixelSize);
+    }
+
+    return fontFace;
+}
+
+
+void GlyphAtlasCache::rasteriseGlyphs(Font font, int pixelSize, const std::string& text)
+/*
+    Rasterise the (UTF-8) characters of `text` into the process-wide face, without
+    touching OpenGL. Called on a worker thread when a Plotter is constructed (see
+    Plotter::Impl), so the first tick labels only need to upload the glyphs.
+ */
+{
+    std::shared_ptr<FontFace> fontFace = getFontFace(font, pixelSize);
+
+    std::size_t pos = 0;
+    while (pos < text.size())
+    {
+        fontFace->glyph(utils_nextUtf8Codepoint(text, pos));
+    }
+}
+
+
+std::map<GlyphAtlasCache::AtlasKey, std::weak_ptr<CharTextureAtlas>>& GlyphAtlasCache::atlases()
+{
+    static std::map<AtlasKey, std::weak_ptr<CharTextureAtlas>> cache;
+    return cache;
+}
+
+
+std::map<GlyphAtlasCache::FontFaceKey, std::shared_ptr<FontFace>>& GlyphAtlasCache::fontFaces()
+{
+    static std::map<FontFaceKey, std::shared_ptr<FontFace>> cache;
+    return cache;
+}
+
+
+std::mutex& GlyphAtlasCache::fontFacesMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <QOpenGLFunctions_3_3_Core>
+#include "../include/Plotter.h"
+#include "CharTextureAtlas.h"
+
+
+class GlyphAtlasCache
+/*
+    Cache of the glyph atlases keyed by font and pixel size (the font size
+    times the device pixel ratio, so the DPR is part of the key). Each
+    subplot's axis tick labels and each legend with the same font and size
+    share a single atlas, rather than each building its own.
+
+    Font faces (and the rasterised glyphs) are process-wide and kept for the
+    lifetime of the process, so other windows and later plotters reuse them.
+    Atlas textures are per OpenGL context, as contexts do not share objects.
+    The context is identified by its function object, as in ProgramCache.
+
+    Only weak references to the atlases are held, an atlas is deleted when
+    the last label or legend using it is torn down. Atlases are used from the
+    GUI thread only.
+ */
+{
+
+public:
+    static std::shared_ptr<CharTextureAtlas> getAtlas(
+        Font font,
+        int pixelSize,
+        QOpenGLFunctions_3_3_Core& glFunctions
+    );
+
+    static std::shared_ptr<FontFace> getFontFace(Font font, int pixelSize);
+
+    static void rasteriseGlyphs(Font font, int pixelSize, const std::string& text);
+
+private:
+    using AtlasKey = std::tuple<QOpenGLFunctions_3_3_Core*, Font, int>;
+    using FontFaceKey = std::pair<Font, int>;
+
+    static std::map<AtlasKey, std::weak_ptr<CharTextureAtlas>>& atlases();
+    static std::map<FontFaceKey, std::shared_ptr<FontFace>>& fontFaces();
+    static std::mutex& fontFacesMutex();
+};
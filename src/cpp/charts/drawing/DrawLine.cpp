@@ -1,7 +1,7 @@
 #include "DrawLine.h"
 #include "../../structure/LinkedSubplot.h"
 
-DrawLine::DrawLine(QOpenGLFunctions_3_3_Core& glFunctions, float x, float y, LinkedSubplot& linkedSubplot, BackendDrawLineSettings drawLinesettings)
+DrawLine::DrawLine(QOpenGLFunctions_3_3_Core& glFunctions, double x, double y, LinkedSubplot& linkedSubplot, BackendDrawLineSettings drawLinesettings)
     : m_gl(glFunctions),
     m_vertexArray(m_gl),
     m_program(
@@ -22,23 +22,41 @@ DrawLine::DrawLine(QOpenGLFunctions_3_3_Core& glFunctions, float x, float y, Lin
     m_gl.glGenBuffers(1, &m_VBO);
     m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 
-    m_gl.glBufferData(GL_ARRAY_BUFFER, sizeof(m_drawPoints), m_drawPoints.data(), GL_DYNAMIC_DRAW);
+    m_gl.glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
 
     m_gl.glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     m_gl.glEnableVertexAttribArray(0);
 
+    uploadDrawPoints();
+
     m_vertexArray.unBind();
 
     m_program.setupAndBindProgram();
 };
 
 
-void DrawLine::handleMouseMove(float x, float y)  // TODO: x should already be in delta
+void DrawLine::handleMouseMove(double x, double y)  // TODO: x should already be in delta
 {
     m_drawPoints = { m_drawPoints[0], m_drawPoints[1], x, y};
 
+    uploadDrawPoints();
+}
+
+
+void DrawLine::uploadDrawPoints()
+/*
+    Upload the line points with x relative to the start point, which is
+    subtracted from the offset in draw(). The x positions are large relative
+    to the distance between them for many datapoints, so they are not
+    rounded to float directly.
+*/
+{
+    std::array<float, 4> relativePoints = {
+        0.0f, (float)m_drawPoints[1], (float)(m_drawPoints[2] - m_drawPoints[0]), (float)m_drawPoints[3]
+    };
+
     m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_VBO);  // HANDLE DUPL!
-    m_gl.glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(m_drawPoints), m_drawPoints.data());
+    m_gl.glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(relativePoints), relativePoints.data());
     m_gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
@@ -50,7 +68,7 @@ void DrawLine::draw(glm::mat4 NDCMatrix, Camera& camera)
 
     m_program.bind();
     m_program.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-    m_program.setUniform1f("offset", (float)camera.getLeft());
+    m_program.setUniform1f("offset", (float)(camera.getLeft() - m_drawPoints[0]));
 
     m_program.setUniform1f("aspectRatio", camera.getAspectRatio());
     m_program.setUniform4f("color", m_drawLineSettings.color);
@@ -17,19 +17,21 @@ class DrawLine
 public:
     DrawLine(
         QOpenGLFunctions_3_3_Core& glFunctions,
-        float x,
-        float y,
+        double x,
+        double y,
         LinkedSubplot& linkedSubplot,
         BackendDrawLineSettings drawLineSettings
     );
 
     void setup();
-    void handleMouseMove(float x, float y);
+    void handleMouseMove(double x, double y);
     void draw(glm::mat4 NDCMatrix, Camera& camera);
     std::optional<UnderMouseData> getDataUnderMouse(double xValue, double yData, double yPadding, bool alwaysShow) const;
 
 private:
-    std::array<float, 4> m_drawPoints = {-0.5f, -0.5f, -0.5f, -0.5f}; // (x1, y1, x2, y2);  TODO: should use this for AxesObject!
+    std::array<double, 4> m_drawPoints = {-0.5, -0.5, -0.5, -0.5}; // (x1, y1, x2, y2);  TODO: should use this for AxesObject!
+
+    void uploadDrawPoints();
 
     QOpenGLFunctions_3_3_Core& m_gl;
     VertexArrayObject m_vertexArray;
@@ -1,5 +1,6 @@
 #include "Legend.h"
 #include "../../structure/LinkedSubplot.h"
+#include "../../Utils.h"
 #include <iostream>
 #include <qopenglfunctions_3_3_core.h>
 #include <glm.hpp>
@@ -21,7 +22,7 @@ Legend::Legend(
     m_textVAO(glFunctions),
     m_boxProgram("legend_vertex.shader", "legend_fragment.shader", glFunctions),
     m_textProgram("legend_text_vertex.shader", "font_fragment.shader", glFunctions),
-    m_charTextureAtlas(glFunctions, GL_TEXTURE2, legendSettings.font, legendSettings.fontSize * linkedSubplot.pixelRatio()),
+    m_charTextureAtlas(GlyphAtlasCache::getAtlas(legendSettings.font, legendSettings.fontSize * linkedSubplot.pixelRatio(), glFunctions)),
     m_cfg(legendSettings)
 {
     setupBoxBuffer();
@@ -136,7 +137,7 @@ void Legend::draw(Camera& camera)
     m_textProgram.bind();
     m_textVAO.bind();
 
-    m_charTextureAtlas.activateAndBind();
+    m_charTextureAtlas->activateAndBind(GL_TEXTURE2);
 
     m_textProgram.setUniform1i("text", 2); // GL_TEXTURE2
     m_textProgram.setUniform4f("fontColor", m_cfg.fontColor);
@@ -197,7 +198,8 @@ std::pair<float, float> Legend::writeLabelsToBuffer(const std::vector<std::strin
     Include the 'world' position (that determines how it is represented on screen),
     the index of the label and the characters position in the texture map.
 
-    This is very similar to the AxisTickLabels writeTextToBuffer.
+    This is very similar to the AxisTickLabels writeTextToBuffer. Labels are UTF-8,
+    `m_numChars` is set to the number of characters (not bytes) written.
  */
 {
     std::vector<float> vertices;  // use array!
@@ -215,38 +217,37 @@ std::pair<float, float> Legend::writeLabelsToBuffer(const std::vector<std::strin
         int charXOffset = 0;  // position of the character in the labelIndex label
 
         // For each character, compute the offsets and store in the buffer
-        for (const char& c : label)
+        std::size_t pos = 0;
+        while (pos < label.size())
         {
-            Character ch =  m_charTextureAtlas.getCharacter(c);
+            const Character& ch = m_charTextureAtlas->getCharacter(utils_nextUtf8Codepoint(label, pos));
 
             float xpos, ypos;
 
             xpos = charXOffset + ch.bearing.x;
-            ypos = 0.0f - (ch.size.y - ch.bearing.y) - (float)m_charTextureAtlas.textYSize();
+            ypos = 0.0f - (ch.size.y - ch.bearing.y) - (float)m_charTextureAtlas->textYSize();
 
             if (maxTextHeight < std::abs(ch.size.y))
             {
                 maxTextHeight = std::abs(ch.size.y);
             }
 
-            // Compute the position of this characters texture in the texture atlas.
-            float texelWidth = 1.0f / (float)m_charTextureAtlas.atlasWidth();
-            float texLeft = (float)ch.xTexturePos / (float)m_charTextureAtlas.atlasWidth();;
-            float texRight = ((float)ch.xTexturePos + (float)ch.size.x) / (float)m_charTextureAtlas.atlasWidth();;
-
-            texLeft += 0.5 * texelWidth;
-            texRight -= 0.5 * texelWidth;
+            // Compute the position of this characters texture in the texture atlas (texels).
+            float texLeft = (float)ch.xTexturePos + 0.5f;
+            float texRight = (float)(ch.xTexturePos + ch.size.x) - 0.5f;
+            float texTop = (float)ch.yTexturePos;
+            float texBottom = (float)(ch.yTexturePos + ch.size.y);
 
             // Store everything in the buffer to
             // be passed to font_vertex_shader
-            //                                x pos world              y pos world             labelIndex             texture x pos (NDC)     texture y pos (NDC)
-            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)labelIndex,       texLeft,                (float)((double)ch.size.y / (double)m_charTextureAtlas.atlasHeight()) });
-            vertices.insert(vertices.end(), { xpos,                    ypos + ch.size.y,     (float)labelIndex,       texLeft,                0.0f });
-            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)labelIndex,       texRight,               0.0f });
+            //                                x pos world              y pos world             labelIndex             texture x pos           texture y pos
+            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)labelIndex,       texLeft,                texBottom });
+            vertices.insert(vertices.end(), { xpos,                    ypos + ch.size.y,     (float)labelIndex,       texLeft,                texTop });
+            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)labelIndex,       texRight,               texTop });
 
-            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)labelIndex,       texLeft,                (float)((double)ch.size.y / (double)m_charTextureAtlas.atlasHeight()) });
-            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)labelIndex,       texRight,               0.0f });
-            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos,                 (float)labelIndex,       texRight,               (float)((double)ch.size.y / (double)m_charTextureAtlas.atlasHeight()) });
+            vertices.insert(vertices.end(), { xpos,                    ypos,                 (float)labelIndex,       texLeft,                texBottom });
+            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos + ch.size.y,     (float)labelIndex,       texRight,               texTop });
+            vertices.insert(vertices.end(), { xpos + ch.size.x,        ypos,                 (float)labelIndex,       texRight,               texBottom });
 
             charXOffset += (ch.advance >> 6);
         }
@@ -254,6 +255,8 @@ std::pair<float, float> Legend::writeLabelsToBuffer(const std::vector<std::strin
         textWidths.push_back(charXOffset);
     }
 
+    m_numChars = vertices.size() / (6 * 5);
+
     // Store the array in the buffer.
     m_textVAO.bind();
 
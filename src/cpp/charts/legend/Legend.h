@@ -3,6 +3,7 @@
 
 #include "../Camera.h"
 #include "../CharTextureAtlas.h"
+#include "../GlyphAtlasCache.h"
 #include "../../opengl/VertexArrayObject.h"
 #include "../plots/BasePlot.h"
 #include "../shaders/Program.h"
@@ -94,7 +95,7 @@ private:
     VertexArrayObject m_textVAO;
     Program m_boxProgram;
     Program m_textProgram;
-    CharTextureAtlas m_charTextureAtlas;
+    std::shared_ptr<CharTextureAtlas> m_charTextureAtlas;
     BackendLegendSettings m_cfg;
 
     unsigned int m_BoxVBO;
@@ -47,10 +47,16 @@ void BarPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
     m_gl.glEnable(GL_DEPTH_TEST);  // dont draw overlapping points (e.g. zoomed out)
 
     // Draw the body
+    // Only draw the bars in view. The shader x positions are relative to the first
+    // drawn bar, so the offset is computed relative to it here (in double precision).
+    double delta = getPlotData().getDelta();
+    VisibleIndexRange visibleRange = visibleIndexRange(camera, delta, m_plotData.getNumDatapoints(), 1);
+    rebindInstanceBuffer(visibleRange.startIdx);
+
     m_barProgram.bind();
-    m_barProgram.setUniform1f("xDelta", (float)getPlotData().getDelta());
+    m_barProgram.setUniform1f("xDelta", (float)delta);
     m_barProgram.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-    m_barProgram.setUniform1f("offset", (float)camera.getLeft());
+    m_barProgram.setUniform1f("offset", (float)(camera.getLeft() - delta * (double)visibleRange.startIdx));
     m_barProgram.setUniform1f("minValue", m_plotData.getMinValue());
 
     m_barProgram.setUniform4f("color", m_barSettings.color);
@@ -58,12 +64,12 @@ void BarPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
 
     m_barVAO.bind();
     m_barProgram.setUniform1i("drawMode", 0);
-    m_gl.glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_plotData.getNumDatapoints());
+    m_gl.glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, visibleRange.size());
 
     // Draw lines behind the body to stop fade-into-white when zooming out.
     m_lineVAO.bind();
     m_barProgram.setUniform1i("drawMode", 1);
-    m_gl.glDrawArraysInstanced(GL_LINES, 0, 2, m_plotData.getNumDatapoints());
+    m_gl.glDrawArraysInstanced(GL_LINES, 0, 2, visibleRange.size());
 
     m_gl.glDisable(GL_DEPTH_TEST);
 
@@ -114,3 +120,27 @@ void BarPlot::initializeAllBuffers()
     m_gl.glVertexAttribDivisor(0, 1);
 }
 
+
+void BarPlot::rebindInstanceBuffer(std::size_t firstInstance)
+/*
+    Point the bar data attribute of both VAO at the first
+    bar to draw. This is only re-bound when it changes.
+*/
+{
+    if (firstInstance == m_boundFirstInstance)
+    {
+        return;
+    }
+
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_barVBO);
+
+    m_barVAO.bind();
+    m_gl.glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(firstInstance * sizeof(float)));
+
+    m_lineVAO.bind();
+    m_gl.glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(firstInstance * sizeof(float)));
+
+    m_lineVAO.unBind();
+
+    m_boundFirstInstance = firstInstance;
+}
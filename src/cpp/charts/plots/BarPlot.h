@@ -28,6 +28,7 @@ public:
     PlotColor getPlotColor()const override { return  PlotColor{m_barSettings.color}; };
 
     void draw(glm::mat4& NDCMatrix, Camera& camera) override;
+    ProfileStage profileStage() const override { return ProfileStage::barPlot; };
 
 private:
 
@@ -37,7 +38,7 @@ private:
     BarData m_plotData;
 
 	void initializeAllBuffers();
-	void rebindInstanceBuffer(bool setAttributeDivisor);
+	void rebindInstanceBuffer(std::size_t firstInstance);
 
     unsigned int m_barVBO;
     unsigned int m_barBasisVBO;
@@ -46,4 +47,6 @@ private:
     VertexArrayObject m_barVAO;
     VertexArrayObject m_lineVAO;
 
+    std::size_t m_boundFirstInstance = 0;
+
 };
@@ -1,12 +1,15 @@
 #ifndef BASEPLOT_H
 #define BASEPLOT_H
 
+#include <algorithm>
+#include <cmath>
 #include <variant>
 #include <QOpenGLFunctions_3_3_Core>
 #include "../Camera.h"
 #include "CandlestickData.h"
 #include "LineData.h"
 #include "BasePlotData.h"
+#include "../../structure/FrameProfiler.h"
 
 
 struct PlotColor
@@ -22,6 +25,19 @@ struct CandlestickColor
 };
 
 
+struct VisibleIndexRange
+/*
+    Range of datapoint indices [startIdx, endIdx) that are
+    within the camera view, see BasePlot::visibleIndexRange.
+ */
+{
+    std::size_t startIdx;
+    std::size_t endIdx;
+
+    std::size_t size() const { return endIdx - startIdx; };
+};
+
+
 using PlotData = std::variant<CandlestickData, LineData>;
 
 class BasePlot
@@ -36,6 +52,7 @@ public:
     BasePlot& operator=(BasePlot&&) = delete;
 
     virtual void draw(glm::mat4& NDCMatrix, Camera& camera) = 0;
+    virtual ProfileStage profileStage() const = 0;
 
     double getDelta() const { return getPlotData().getDelta(); };
     int getNumDatapoints() const { return getPlotData().getNumDatapoints(); };
@@ -46,6 +63,23 @@ protected:
 
     BasePlot() = default;
 
+    static VisibleIndexRange visibleIndexRange(const Camera& camera, double delta, std::size_t numDatapoints, std::size_t margin)
+    /*
+        Indices of the datapoints inside the camera view (datapoint i is at
+        x = delta * i), used to only draw the visible instances / vertices.
+        `margin` datapoints are added on each side, e.g. so candles that
+        are partially in view, or line segment neighbours, are drawn.
+     */
+    {
+        double firstVisible = std::floor(camera.getLeft() / delta) - (double)margin;
+        double lastVisible = std::ceil(camera.getRight() / delta) + (double)margin;
+
+        std::size_t startIdx = (std::size_t)std::clamp(firstVisible, 0.0, (double)numDatapoints);
+        std::size_t endIdx = (std::size_t)std::clamp(lastVisible + 1.0, (double)startIdx, (double)numDatapoints);
+
+        return {startIdx, endIdx};
+    };
+
 };
 
 
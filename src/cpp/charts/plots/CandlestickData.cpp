@@ -1,4 +1,5 @@
 #include <cassert>
+#include <stdexcept>
 #include "CandlestickData.h"
 
 
@@ -29,6 +30,165 @@ CandlestickData::~CandlestickData()
 }
 
 
+std::vector<float> CandlestickData::makeCandleBasis()
+/*
+    The basis shapes for the three candle styles, one after the other
+    (see `fullBasisFirst` etc.). Each shape is a list of triangles.
+*/
+{
+    std::vector<float> basis;
+
+    auto addBody = [&basis]()
+    {
+        basis.insert(basis.end(), {
+            0.0f,  0.0f, 0.0f, 0.0f,    // top left
+            0.0f, -1.0f, 0.0f, 0.0f,    // bottom left
+            1.0f,  0.0f, 0.0f, 0.0f,    // top right
+
+            1.0f,  0.0f, 0.0f, 0.0f,    // top right
+            0.0f, -1.0f, 0.0f, 0.0f,    // bottom left
+            1.0f, -1.0f, 0.0f, 0.0f     // bottom right
+        });
+    };
+
+    // A vertical line from the top (0) to bottom (-1), widened along x
+    auto addVerticalLine = [&basis](float part)
+    {
+        basis.insert(basis.end(), {
+            0.0f,  0.0f, part, -0.5f,
+            0.0f, -1.0f, part, -0.5f,
+            0.0f,  0.0f, part,  0.5f,
+
+            0.0f,  0.0f, part,  0.5f,
+            0.0f, -1.0f, part, -0.5f,
+            0.0f, -1.0f, part,  0.5f
+        });
+    };
+
+    // A horizontal cap at the top (0) or bottom (-1), widened along y
+    auto addCap = [&basis](float y)
+    {
+        basis.insert(basis.end(), {
+           -0.5f, y, 2.0f, -0.5f,
+           -0.5f, y, 2.0f,  0.5f,
+            0.5f, y, 2.0f, -0.5f,
+
+            0.5f, y, 2.0f, -0.5f,
+           -0.5f, y, 2.0f,  0.5f,
+            0.5f, y, 2.0f,  0.5f
+        });
+    };
+
+    // full: body, connecting line low / high, top and bottom caps
+    addBody();
+    addVerticalLine(1.0f);
+    addCap(0.0f);
+    addCap(-1.0f);
+
+    // noCaps: body, line low / high
+    addBody();
+    addVerticalLine(1.0f);
+
+    // bodyOnly: body, line open / close
+    addBody();
+    addVerticalLine(3.0f);
+
+    return basis;
+}
+
+
+/* -----------------------------------------------------------
+   Streaming
+   ---------------------------------------------------------*/
+
+
+void CandlestickData::appendCandles(
+    const float* openPtr, const float* highPtr,
+    const float* lowPtr, const float* closePtr,
+    std::size_t size
+)
+/*
+    Append new candles to the end of the data. The first time this
+    is called the user-passed data is copied into owned vectors, so
+    the passed arrays no longer need to outlive the plot. Subsequent
+    appends are amortised O(size) as the vectors grow geometrically.
+*/
+{
+    std::size_t newSize = m_open.size() + size;
+
+    if (!m_ownsData)
+    {
+        takeOwnershipOfData(newSize);
+    }
+
+    m_ownedOpen.insert(m_ownedOpen.end(), openPtr, openPtr + size);
+    m_ownedHigh.insert(m_ownedHigh.end(), highPtr, highPtr + size);
+    m_ownedLow.insert(m_ownedLow.end(), lowPtr, lowPtr + size);
+    m_ownedClose.insert(m_ownedClose.end(), closePtr, closePtr + size);
+
+    resetDataViews();
+}
+
+
+void CandlestickData::updateLastCandle(float open, float high, float low, float close)
+/*
+    Overwrite the most recent candle in place (e.g. a live bar
+    that has not yet closed).
+*/
+{
+    if (m_open.size() == 0)
+    {
+        throw std::runtime_error("CRITICAL ERROR: cannot update the last candle of an empty plot.");
+    }
+
+    if (!m_ownsData)
+    {
+        takeOwnershipOfData(m_open.size());
+    }
+
+    std::size_t lastIdx = m_ownedOpen.size() - 1;
+
+    m_ownedOpen[lastIdx] = open;
+    m_ownedHigh[lastIdx] = high;
+    m_ownedLow[lastIdx] = low;
+    m_ownedClose[lastIdx] = close;
+}
+
+
+void CandlestickData::takeOwnershipOfData(std::size_t newSize)
+{
+    m_ownedOpen.reserve(newSize);
+    m_ownedHigh.reserve(newSize);
+    m_ownedLow.reserve(newSize);
+    m_ownedClose.reserve(newSize);
+
+    m_ownedOpen.assign(m_open.begin(), m_open.end());
+    m_ownedHigh.assign(m_high.begin(), m_high.end());
+    m_ownedLow.assign(m_low.begin(), m_low.end());
+    m_ownedClose.assign(m_close.begin(), m_close.end());
+
+    m_ownsData = true;
+
+    resetDataViews();
+}
+
+
+void CandlestickData::resetDataViews()
+/*
+    The owned vectors may have reallocated, so re-point the
+    views and update the number of datapoints / delta.
+*/
+{
+    m_open = StdPtrVector<float>(m_ownedOpen.data(), m_ownedOpen.size());
+    m_high = StdPtrVector<float>(m_ownedHigh.data(), m_ownedHigh.size());
+    m_low = StdPtrVector<float>(m_ownedLow.data(), m_ownedLow.size());
+    m_close = StdPtrVector<float>(m_ownedClose.data(), m_ownedClose.size());
+
+    m_numDataPoints = m_ownedOpen.size();
+    m_delta = 1.0 / m_numDataPoints;
+}
+
+
 std::optional<UnderMouseData> CandlestickData::getDataUnderMouse(
     int xIdx,
     double yMousePos,
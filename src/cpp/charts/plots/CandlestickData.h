@@ -32,9 +32,15 @@ public:
     );
 	~CandlestickData();
 
-    const std::vector<float>& getBodyBasis() const { return m_bodyBasis; };
-    const std::vector<float>& getCandleBasis() const { return m_candleBasis;  };
-    const std::vector<float>& getLineBasis() const { return m_lineBasis; };
+    const std::vector<float>& getCandleBasis() const { return m_candleBasis; };
+
+    // Ranges of m_candleBasis (first vertex, number of vertices) for each candle style
+    static constexpr int fullBasisFirst = 0;
+    static constexpr int fullBasisCount = 24;
+    static constexpr int noCapsBasisFirst = 24;
+    static constexpr int noCapsBasisCount = 12;
+    static constexpr int bodyOnlyBasisFirst = 36;
+    static constexpr int bodyOnlyBasisCount = 12;
 
     const StdPtrVector<float>& getMinVector() const override { return m_low; };
     const StdPtrVector<float>& getMaxVector() const override { return m_high; };
@@ -43,38 +49,49 @@ public:
         int xIdx, double yMousePos, double yPadding, bool alwaysShow, std::optional<double> xMousePos = std::nullopt
     ) const override;
 
-    const StdPtrVector<float> m_open;
-    const StdPtrVector<float> m_high;
-    const StdPtrVector<float> m_low;
-    const StdPtrVector<float> m_close;
+    void appendCandles(
+        const float* openPtr, const float* highPtr,
+        const float* lowPtr, const float* closePtr,
+        std::size_t size
+    );
+    void updateLastCandle(float open, float high, float low, float close);
+
+    // Read-only views, these point either to the user-passed
+    // data or (once streaming has started) to the owned vectors below.
+    StdPtrVector<float> m_open;
+    StdPtrVector<float> m_high;
+    StdPtrVector<float> m_low;
+    StdPtrVector<float> m_close;
 
 private:
 
     Configs& m_configs;
 
-	// Setup instance basis and vector pointers 
-	// ----------------------------------------
-
-    const std::vector<float> m_bodyBasis = {
-	0.0f,  0.0f,   // top left
-	0.0f, -1.0f,   // bottom left
-	1.0f,  0.0f,   // top right
-	1.0f, -1.0f    // bottom right
-	};
-
-    const std::vector<float> m_candleBasis = {
-		-0.5f,  0.0f,      // top cap
-		 0.5f,  0.0f,
+    // Owned copies of the data, only filled once candles are appended.
+    // Before this the data is owned by the user (see Plotter.h).
+    bool m_ownsData = false;
+    std::vector<float> m_ownedOpen;
+    std::vector<float> m_ownedHigh;
+    std::vector<float> m_ownedLow;
+    std::vector<float> m_ownedClose;
 
-		-0.5f, -1.0f,      // bottom cap
-		 0.5f, -1.0f,
+    void takeOwnershipOfData(std::size_t newSize);
+    void resetDataViews();
 
-		 0.0f,  0.0f,      // connecting line
-		 0.0f, -1.0f
-    };
-
-    const std::vector<float> m_lineBasis = {
-        0.0f,  0.0f,    // line top
-		0.0f, -1.0f    // line bottom
-	};
+	// Setup instance basis and vector pointers
+	// ----------------------------------------
+    //
+    // The body and lines of a candle are drawn together as triangles in one
+    // instanced draw. Each vertex is (x, y, part, pixel offset). The parts are
+    // 0: body, 1: vertical line low / high, 2: horizontal cap, 3: vertical line
+    // open / close. Lines are zero-width here and widened to one pixel in the
+    // `candlestick_vertex.shader` by the pixel offset (x for vertical, y for
+    // horizontal lines). The body comes first in each candle so it hides its
+    // own lines, as everything is at the same depth and the depth test
+    // keeps the first fragment drawn (as when the body was drawn in a pass
+    // before the lines).
+
+    static std::vector<float> makeCandleBasis();
+
+    const std::vector<float> m_candleBasis = makeCandleBasis();
 };
@@ -0,0 +1,242 @@
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "CandlestickLodPyramid.h"
+#include "../../ParallelFor.h"
+
+
+namespace
+{
+    void mergeCandles(
+        float openA, float closeA, float lowA, float highA,
+        float openB, float closeB, float lowB, float highB,
+        float* out
+    )
+    /*
+        Merge two neighbouring candles A, B into `out` (open, close, low, high).
+        Missing (NaN) values are skipped so a gap does not hide its neighbour.
+     */
+    {
+        out[0] = std::isnan(openA) ? openB : openA;
+        out[1] = std::isnan(closeB) ? closeA : closeB;
+        out[2] = std::fmin(lowA, lowB);
+        out[3] = std::fmax(highA, highB);
+    }
+
+    void aggregateCandles(
+        const float* open, const float* high, const float* low, const float* close,
+        std::size_t startIdx, std::size_t endIdx, float* out
+    )
+    /*
+        Aggregate the candles [startIdx, endIdx) into `out`, the same as
+        merging them pairwise (the first / last open and close that are not
+        NaN, the min low and max high).
+     */
+    {
+        float nan = std::numeric_limits<float>::quiet_NaN();
+        out[0] = nan;
+        out[1] = nan;
+        out[2] = nan;
+        out[3] = nan;
+
+        for (std::size_t i = startIdx; i < endIdx; i++)
+        {
+            if (std::isnan(out[0]))
+            {
+                out[0] = open[i];
+            }
+            if (!std::isnan(close[i]))
+            {
+                out[1] = close[i];
+            }
+            out[2] = std::fmin(out[2], low[i]);
+            out[3] = std::fmax(out[3], high[i]);
+        }
+    }
+}
+
+
+void CandlestickLodPyramid::update(
+    const StdPtrVector<float>& open, const StdPtrVector<float>& high,
+    const StdPtrVector<float>& low, const StdPtrVector<float>& close,
+    std::size_t firstChangedIdx
+)
+/*
+    (Re)compute the levels held here for all candles from `firstChangedIdx`
+    onwards. Pass 0 to build from scratch. When candles are appended or the
+    last candle is updated only the parents of the changed candles are
+    recomputed on each level, so the cost is O(changed + 2^cpuBaseLevel + log n).
+ */
+{
+    m_numDatapoints = open.size();
+
+    // Level L exists while level L - 1 has at least two candles
+    m_numLevels = 1;
+    while (numCandles(m_numLevels - 1) >= 2)
+    {
+        m_numLevels++;
+    }
+
+    // Raw pointers, the bounds are known and this is hot for large data
+    const float* openData = open.data();
+    const float* highData = high.data();
+    const float* lowData = low.data();
+    const float* closeData = close.data();
+
+    std::size_t firstChangedChild = firstChangedIdx;
+
+    for (int level = cpuBaseLevel; level < m_numLevels; level++)
+    {
+        std::size_t levelSize = numCandles(level);
+        std::size_t firstChangedParent = (level == cpuBaseLevel) ? (firstChangedIdx >> cpuBaseLevel) : firstChangedChild / 2;
+
+        if (m_levels.size() < (std::size_t)(level - cpuBaseLevel + 1))
+        {
+            m_levels.emplace_back();
+            firstChangedParent = 0;
+        }
+
+        std::vector<float>& levelData = m_levels[level - cpuBaseLevel];
+
+        firstChangedParent = std::min(firstChangedParent, levelData.size() / 4);
+        levelData.resize(levelSize * 4);
+
+        // Building from scratch, the large (lowest) levels are split across threads
+        std::size_t chunkSize = (level == cpuBaseLevel) ? baseChunkSize : parallelChunkSize;
+
+        parallelFor(levelSize - firstChangedParent, chunkSize, [&](std::size_t chunkStart, std::size_t chunkEnd)
+        {
+            for (std::size_t i = firstChangedParent + chunkStart; i < firstChangedParent + chunkEnd; i++)
+            {
+                if (level == cpuBaseLevel)
+                {
+                    std::size_t startIdx = i << cpuBaseLevel;
+                    std::size_t endIdx = std::min(startIdx + (std::size_t(1) << cpuBaseLevel), m_numDatapoints);
+
+                    aggregateCandles(openData, highData, lowData, closeData, startIdx, endIdx, &levelData[i * 4]);
+                }
+                else
+                {
+                    const std::vector<float>& child = m_levels[level - cpuBaseLevel - 1];
+                    std::size_t childSize = child.size() / 4;
+
+                    std::size_t a = 2 * i;
+                    std::size_t b = (2 * i + 1 < childSize) ? 2 * i + 1 : a;
+
+                    mergeCandles(
+                        child[a * 4], child[a * 4 + 1], child[a * 4 + 2], child[a * 4 + 3],
+                        child[b * 4], child[b * 4 + 1], child[b * 4 + 2], child[b * 4 + 3],
+                        &levelData[i * 4]
+                    );
+                }
+            }
+        });
+
+        firstChangedChild = firstChangedParent;
+    }
+
+    // The data can only grow, but for safety drop any stale top levels.
+    m_levels.resize(std::max(m_numLevels - cpuBaseLevel, 0));
+}
+
+
+void CandlestickLodPyramid::reduce(
+    const StdPtrVector<float>& open, const StdPtrVector<float>& high,
+    const StdPtrVector<float>& low, const StdPtrVector<float>& close,
+    std::size_t startIdx, std::size_t endIdx, int maxLevel,
+    std::vector<std::vector<float>>& levels
+)
+/*
+    Aggregate the candles [startIdx, endIdx) into levels 1 to `maxLevel`,
+    `levels[L - 1]` holds the candles of level L from `startIdx >> L`.
+    `startIdx` must be a multiple of 2^maxLevel, and `endIdx` either
+    a multiple or the number of candles, so each aggregated candle
+    covers the same candles as in the full pyramid.
+ */
+{
+    levels.resize(maxLevel);
+
+    const float* openData = open.data();
+    const float* highData = high.data();
+    const float* lowData = low.data();
+    const float* closeData = close.data();
+
+    for (int level = 1; level <= maxLevel; level++)
+    {
+        std::size_t childSize = (level == 1) ? endIdx - startIdx : levels[level - 2].size() / 4;
+
+        std::vector<float>& levelData = levels[level - 1];
+        levelData.resize(((childSize + 1) / 2) * 4);
+
+        parallelFor(levelData.size() / 4, parallelChunkSize, [&](std::size_t chunkStart, std::size_t chunkEnd)
+        {
+            for (std::size_t i = chunkStart; i < chunkEnd; i++)
+            {
+                std::size_t a = 2 * i;
+                std::size_t b = (2 * i + 1 < childSize) ? 2 * i + 1 : a;
+
+                if (level == 1)
+                {
+                    a += startIdx;
+                    b += startIdx;
+
+                    mergeCandles(
+                        openData[a], closeData[a], lowData[a], highData[a],
+                        openData[b], closeData[b], lowData[b], highData[b],
+                        &levelData[i * 4]
+                    );
+                }
+                else
+                {
+                    const std::vector<float>& child = levels[level - 2];
+                    mergeCandles(
+                        child[a * 4], child[a * 4 + 1], child[a * 4 + 2], child[a * 4 + 3],
+                        child[b * 4], child[b * 4 + 1], child[b * 4 + 2], child[b * 4 + 3],
+                        &levelData[i * 4]
+                    );
+                }
+            }
+        });
+    }
+}
+
+
+std::size_t CandlestickLodPyramid::numCandles(int level) const
+{
+    std::size_t levelWidth = std::size_t(1) << level;
+
+    return (m_numDatapoints + levelWidth - 1) >> level;
+}
+
+
+const std::vector<float>& CandlestickLodPyramid::levelData(int level) const
+{
+    if (level < cpuBaseLevel || level >= m_numLevels)
+    {
+        throw std::runtime_error("CRITICAL ERROR: CandlestickLodPyramid level not held on the CPU: " + std::to_string(level));
+    }
+    return m_levels[level - cpuBaseLevel];
+}
+
+
+int CandlestickLodPyramid::selectLevel(double numCandlesInView, double numPixelsInView, int numLevels)
+/*
+    Select the lowest level on which a candle is at least
+    ~1 pixel wide, so the number of drawn candles is bounded
+    by the width of the plot rather than the data size.
+ */
+{
+    if (numPixelsInView <= 0)
+    {
+        return 0;
+    }
+
+    int level = 0;
+    while (level < numLevels - 1 && numCandlesInView > numPixelsInView)
+    {
+        numCandlesInView /= 2.0;
+        level++;
+    }
+    return level;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "../../include/UserVector.h"
+
+
+class CandlestickLodPyramid
+/*
+    Level-of-detail pyramid of aggregated candles, used to draw
+    fewer candles when many candles fall into a single pixel.
+
+    Level 0 is the candle data itself (held by CandlestickData, not here).
+    Each level above merges pairs of candles from the level below:
+    (first open, max high, min low, last close). Candle `i` on level `L`
+    therefore covers the original candles [i * 2^L, (i + 1) * 2^L).
+
+    Only the levels from `cpuBaseLevel` up are kept here, ~N / 2^(cpuBaseLevel - 1)
+    candles in total (about 3 MB for 100M candles), level `cpuBaseLevel` is
+    aggregated straight from the candles. The levels below are only on the GPU,
+    they are aggregated from the candles a range at a time by reduce(), so the
+    CPU memory is bounded by that range (see CandlestickPlot::uploadChunk()).
+
+    The levels are stored interleaved in the same layout as the
+    instance buffer, (open, close, low, high), so they can be
+    uploaded directly (see CandlestickPlot).
+*/
+{
+
+public:
+    CandlestickLodPyramid() = default;
+
+    CandlestickLodPyramid(const CandlestickLodPyramid&) = delete;
+    CandlestickLodPyramid& operator=(const CandlestickLodPyramid&) = delete;
+    CandlestickLodPyramid(CandlestickLodPyramid&&) = delete;
+    CandlestickLodPyramid& operator=(CandlestickLodPyramid&&) = delete;
+
+    void update(
+        const StdPtrVector<float>& open, const StdPtrVector<float>& high,
+        const StdPtrVector<float>& low, const StdPtrVector<float>& close,
+        std::size_t firstChangedIdx
+    );
+
+    static void reduce(
+        const StdPtrVector<float>& open, const StdPtrVector<float>& high,
+        const StdPtrVector<float>& low, const StdPtrVector<float>& close,
+        std::size_t startIdx, std::size_t endIdx, int maxLevel,
+        std::vector<std::vector<float>>& levels
+    );
+
+    int numLevels() const { return m_numLevels; };
+    std::size_t numCandles(int level) const;
+    const std::vector<float>& levelData(int level) const;
+
+    static bool isOnCpu(int level) { return level >= cpuBaseLevel; };
+    static int selectLevel(double numCandlesInView, double numPixelsInView, int numLevels);
+
+    static constexpr int cpuBaseLevel = 10;
+
+private:
+
+    // m_levels[L - cpuBaseLevel] holds level L
+    std::vector<std::vector<float>> m_levels;
+    std::size_t m_numDatapoints = 0;
+    int m_numLevels = 1;
+
+    static constexpr std::size_t parallelChunkSize = 1 << 16;  // parent candles per thread
+    static constexpr std::size_t baseChunkSize = 1 << 10;  // as above on the base level, 2^20 candles
+};
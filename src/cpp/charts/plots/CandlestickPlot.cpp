@@ -1,7 +1,10 @@
 
+#include <algorithm>
 #include "../../include/UserVector.h"
 #include "CandlestickPlot.h"
 #include "../../include/UserVector.h"
+#include "../../ParallelFor.h"
+#include "../../structure/DeferredWorkQueue.h"
 #include "../../structure/LinkedSubplot.h"
 
 
@@ -26,9 +29,8 @@ CandlestickPlot::CandlestickPlot(
           glFunctions
       ),
       m_lineProgram(
-          "candlestick_vertex.shader",
+          "line_instanced_vertex.shader",
           "candlestick_line_fragment.shader",
-          "line_geometry.shader",
           glFunctions
       ),
       m_oldPlotStyleProgram(
@@ -37,12 +39,12 @@ CandlestickPlot::CandlestickPlot(
           glFunctions
       ),
       m_plotData(configs, openPtr, openSize, highPtr, highSize, lowPtr, lowSize, closePtr, closeSize),
-      m_bodyVAO(glFunctions),
       m_candleVAO(glFunctions),
-      m_lineVAO(glFunctions),
-      m_linePlotVAO(glFunctions)
+      m_linePlotVAO(glFunctions),
+      m_miterLine(glFunctions)
 {
     initializeAllBuffers();
+    addChunks();
 	m_instanceProgram.setupAndBindProgram();
     m_lineProgram.setupAndBindProgram();
     m_oldPlotStyleProgram.setupAndBindProgram();
@@ -51,17 +53,19 @@ CandlestickPlot::CandlestickPlot(
 
 CandlestickPlot::~CandlestickPlot()
 {
+    m_linkedSubplot.deferredWork().cancel(this);
+
     m_gl.glDeleteBuffers(1, &m_instanceVBO);
     m_instanceVBO = 0;
 
-    m_gl.glDeleteBuffers(1, &m_bodyBasisVBO);
-    m_bodyBasisVBO = 0;
-
     m_gl.glDeleteBuffers(1, &m_candleBasisVBO);
     m_candleBasisVBO = 0;
 
-    m_gl.glDeleteBuffers(1, &m_lineBasisVBO);
-    m_lineBasisVBO = 0;
+    if (!m_lodVBOs.empty())
+    {
+        m_gl.glDeleteBuffers(m_lodVBOs.size(), m_lodVBOs.data());
+        m_lodVBOs.clear();
+    }
 }
 
 
@@ -74,13 +78,16 @@ void CandlestickPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
 /*
 	Here we coordinate the 5 different plot types for candlestick data.
 
-    "full" : The full candlestick plot. First, we draw the body, then all the candlestick lines
-	
-    "bodyOnly" : First draw the body, then the shadow connectiong low-high
-	
-    "noCaps" : First draw the body, then a single vertical line connecting Open-Close.
+    "full" : The full candlestick plot, the body and all the candlestick lines.
+
+    "noCaps" : The body and the shadow connecting low-high.
+
+    "bodyOnly" : The body and a single vertical line connecting Open-Close.
 							 This is required to avoid the candles dissapearing when zooming our far.
 						     Maybe there is a better way to acheive this!
+
+    The body and lines of all three candle styles are drawn in a single instanced draw of
+    triangles, the lines are 1 pixel wide quads (see CandlestickData::makeCandleBasis).
 	
 	"lineOpen" : A simple line plot, instancing is not used for this. Plot the Open positions as a line.
 	
@@ -93,9 +100,12 @@ void CandlestickPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
 			    world coordinates) to NDC (+- 1).
 
 	offset : due to numerical issues, it is better to compute the NDCMatrix transformation
-	         centered at zero. The offset is simply the left camera edge, and we pass
+	         centered at zero. The offset is the left camera edge, and we pass
 			 this to the shader so the NDC transformation incorproates this offset, 
-			 see m_camera.getNDCMatrix().
+			 see m_camera.getNDCMatrix(). The shader x positions are relative to the
+			 first drawn candle / vertex, so the offset is too (computed in double).
+
+	firstVertex : first drawn vertex for the line modes, as x is relative to it.
 
 	lampMode : currently unused mode for lighting effect.
 
@@ -107,23 +117,62 @@ void CandlestickPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
 
 	capWidth
 
+	pixelSize : the size of a pixel in NDC, used to widen the candle lines to 1 pixel.
+
     Draw Modes for Vertex Shader
     ----------------------------
 
-    0 : The candle body
-    1 : The full candlestick lines (vertical, two horizontal)
-    2 : Line extending vertically through the body and extending to low / high (no cap tops)
-    3 : Line extending vertically through the body to open / close (no caps)
+    0 : Candles, the body and lines are set by the basis shape (see CandlestickData)
     4 : Line only (open)
     5 : Line only (close)
 */
 {
     m_gl.glEnable(GL_DEPTH_TEST);  // dont draw overlapping points (e.g. zoomed out)
 
+    bool isCandleStickPlot = (m_candlestickSettings.mode != CandlestickMode::lineOpen && m_candlestickSettings.mode != CandlestickMode::lineClose);
+
+    // When zoomed out, draw aggregated candles from the LOD pyramid. A candle on level L
+    // is 2^L candles wide, so it is centered (2^L - 1) / 2 candles to the right of its
+    // first candle. This is applied through the offset so the shader is unchanged.
+    int lodLevel = isCandleStickPlot ? selectLodLevel(camera) : 0;
+
+    double delta = getPlotData().getDelta();
+    double lodDelta = delta * (double)(std::size_t(1) << lodLevel);
+
+    // Only draw the candles in view. There is no base instance in OpenGL 3.3, so the
+    // instance attributes are offset to the first visible candle.
+    VisibleIndexRange visibleRange = visibleIndexRange(camera, delta, m_plotData.getNumDatapoints(), 1);
+
+    std::size_t firstInstance = visibleRange.startIdx >> lodLevel;
+    std::size_t endInstance = std::min(
+        m_lodPyramid.numCandles(lodLevel),
+        (visibleRange.endIdx + (std::size_t(1) << lodLevel) - 1) >> lodLevel
+    );
+    int numInstances = (int)(endInstance - std::min(firstInstance, endInstance));
+
+    // Only the candles in view must be uploaded to draw, the rest are streamed in when idle
+    if (isCandleStickPlot)
+    {
+        uploadRange(lodLevel, firstInstance, endInstance);
+    }
+    else
+    {
+        // The line modes draw level 0 (the full-resolution candles), with a margin for the miter line
+        VisibleIndexRange lineRange = visibleIndexRange(camera, delta, m_plotData.getNumDatapoints(), 2);
+        uploadRange(0, lineRange.startIdx, lineRange.endIdx);
+    }
+
+    // The shader x positions are relative to the first drawn candle (gl_InstanceID), and
+    // the offset to the camera edge is computed here in double. Both are then small, so
+    // there is no float rounding of the x position however many candles there are.
+    double lodOffset = camera.getLeft() - lodDelta * (double)firstInstance - (lodDelta - delta) / 2.0;
+
+    bindInstanceRange(lodLevel, firstInstance);
+
     m_instanceProgram.bind();
-    m_instanceProgram.setUniform1f("xDelta", (float)getPlotData().getDelta());
+    m_instanceProgram.setUniform1f("xDelta", (float)lodDelta);
 	m_instanceProgram.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-    m_instanceProgram.setUniform1f("offset", (float)camera.getLeft());
+    m_instanceProgram.setUniform1f("offset", (float)lodOffset);
     m_instanceProgram.setUniform1i("lampMode", 0);
 
     m_instanceProgram.setUniform4f("upColor", m_candlestickSettings.upColor);
@@ -132,72 +181,80 @@ void CandlestickPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
     m_instanceProgram.setUniform1f("candleWidthRatio", m_candlestickSettings.candleWidthRatio);
     m_instanceProgram.setUniform1f("capWidthRatio", m_candlestickSettings.capWidthRatio);
 
-    bool isCandleStickPlot = (m_candlestickSettings.mode != CandlestickMode::lineOpen && m_candlestickSettings.mode != CandlestickMode::lineClose);
-
 	if (isCandleStickPlot)
 	{
-		// Draw the candle body
-		m_instanceProgram.setUniform1i("drawMode", 0);
-        m_bodyVAO.bind();
-        m_gl.glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_plotData.getNumDatapoints());
+        WindowViewportObject& viewport = m_linkedSubplot.windowViewport();
+
+        m_instanceProgram.setUniform2f("pixelSize", glm::vec2(
+            2.0 / viewport.plotWidthInPixels(),
+            2.0 / viewport.plotHeightInPixels(m_linkedSubplot.m_yHeightProportion)
+        ));
+
+        // Draw the body and lines together, either full candles, candles without
+        // caps, or a line behind the body to stop it dissapearing when zoomed out.
+        int basisFirst, basisCount;
 
-		// Next draw lines, either full candles, candles without caps, 
-		// or line behind the body to stop it dissapearing when zoomed out.
-        // TODO: this is a slow hack to avoid candles dissapearing when zoomed out.
         if (m_candlestickSettings.mode == CandlestickMode::full)
 		{
-            m_instanceProgram.setUniform1i("drawMode", 1);
-			m_candleVAO.bind();
-            m_gl.glDrawArraysInstanced(GL_LINES, 0, 6, m_plotData.getNumDatapoints());
+            basisFirst = CandlestickData::fullBasisFirst;
+            basisCount = CandlestickData::fullBasisCount;
 		}
         else if (m_candlestickSettings.mode == CandlestickMode::noCaps)
         {
-            m_instanceProgram.setUniform1i("drawMode", 2);
-            m_lineVAO.bind();
-            m_gl.glDrawArraysInstanced(GL_LINES, 0, 2, m_plotData.getNumDatapoints());
+            basisFirst = CandlestickData::noCapsBasisFirst;
+            basisCount = CandlestickData::noCapsBasisCount;
         }
         else
         {
-            m_instanceProgram.setUniform1i("drawMode", 3);
-            m_lineVAO.bind();
-            m_gl.glDrawArraysInstanced(GL_LINES, 0, 2, m_plotData.getNumDatapoints());
+            basisFirst = CandlestickData::bodyOnlyBasisFirst;
+            basisCount = CandlestickData::bodyOnlyBasisCount;
         }
-    }    
+
+		m_instanceProgram.setUniform1i("drawMode", 0);
+        m_candleVAO.bind();
+        m_gl.glDrawArraysInstanced(GL_TRIANGLES, basisFirst, basisCount, numInstances);
+    }
     else
     {
         if (!m_candlestickSettings.lineModeBasicLine)
         {
+            // Two vertices margin, as each segment also needs its adjacent vertices
+            VisibleIndexRange lineRange = visibleIndexRange(camera, delta, m_plotData.getNumDatapoints(), 2);
+
+            // The (open, close) of each candle are read straight from the instance buffer,
+            // the point before the first segment is at `startIdx` as the buffer is padded.
+            m_miterLine.bindPoints(m_instanceVBO, lineRange.startIdx * 4 * sizeof(float), 2, 4 * sizeof(float));
+
+            // x is relative to the first drawn vertex, as for the candles above
             m_lineProgram.bind();
-            m_lineProgram.setUniform1f("xDelta", (float)getPlotData().getDelta());
+            m_lineProgram.setUniform1i("dataLayout", (m_candlestickSettings.mode == CandlestickMode::lineOpen) ? 2 : 3);
+            m_lineProgram.setUniform1f("xDelta", (float)delta);
+            m_lineProgram.setUniform1i("firstVertex", (int)lineRange.startIdx);
+            m_lineProgram.setUniform1i("numVertices", m_plotData.getNumDatapoints());
             m_lineProgram.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-            m_lineProgram.setUniform1f("offset", (float)camera.getLeft());
-            m_lineProgram.setUniform1i("lampMode", 0);
+            m_lineProgram.setUniform1f("offset", (float)(camera.getLeft() - delta * (double)lineRange.startIdx));
 
             m_lineProgram.setUniform4f("upColor", m_candlestickSettings.upColor);
             m_lineProgram.setUniform4f("downColor", m_candlestickSettings.downColor);
 
-            m_lineProgram.setUniform1f("candleWidthRatio", m_candlestickSettings.candleWidthRatio);
-            m_lineProgram.setUniform1f("capWidthRatio", m_candlestickSettings.capWidthRatio);
-
             m_lineProgram.setUniform1f("aspectRatio", camera.getAspectRatio());
             m_lineProgram.setUniform1f("yHeightProportion", m_linkedSubplot.m_yHeightProportion);
             m_lineProgram.setUniform1f("subplotHeightProportion", m_linkedSubplot.windowViewport().subplotSizePercent().second); // TODO: this naming is super confusing, this is the high level subplot
-            m_lineProgram.setUniform1i("useColor", 1);
 
-            int drawMode = (m_candlestickSettings.mode == CandlestickMode::lineOpen) ? 4 : 5;
-            m_lineProgram.setUniform1i("drawMode", drawMode);
             m_lineProgram.setUniform1f("width", m_candlestickSettings.lineModeLinewidth / 100.0);
             m_lineProgram.setUniform1f("miterLimit", m_candlestickSettings.lineModeMiterLimit);
 
-            m_linePlotVAO.bind();
-            m_gl.glDrawArrays(GL_LINE_STRIP_ADJACENCY, 0, m_plotData.getNumDatapoints() + 1);
+            m_miterLine.draw((int)lineRange.size());
         }
         else
         {
+            VisibleIndexRange lineRange = visibleIndexRange(camera, delta, m_plotData.getNumDatapoints(), 1);
+
             m_oldPlotStyleProgram.bind();
-            m_oldPlotStyleProgram.setUniform1f("xDelta", (float)getPlotData().getDelta());
+            m_oldPlotStyleProgram.setUniform1f("xDelta", (float)delta);
+            m_oldPlotStyleProgram.setUniform1i("firstVertex", (int)lineRange.startIdx);
             m_oldPlotStyleProgram.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-            m_oldPlotStyleProgram.setUniform1f("offset", (float)camera.getLeft());
+            m_oldPlotStyleProgram.setUniform1f("offset", (float)(camera.getLeft() - delta * (double)lineRange.startIdx));
             m_oldPlotStyleProgram.setUniform1i("lampMode", 0);
 
             m_oldPlotStyleProgram.setUniform4f("upColor", m_candlestickSettings.upColor);
@@ -207,12 +264,11 @@ void CandlestickPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
             m_oldPlotStyleProgram.setUniform1f("capWidthRatio", m_candlestickSettings.capWidthRatio);
 
             int drawMode = (m_candlestickSettings.mode == CandlestickMode::lineOpen) ? 4 : 5;
-            m_lineProgram.setUniform1i("drawMode", drawMode);
-
+            m_oldPlotStyleProgram.setUniform1i("drawMode", drawMode);
 
             m_linePlotVAO.bind();
 
-            m_gl.glDrawArrays(GL_LINE_STRIP, 0, m_plotData.getNumDatapoints());
+            m_gl.glDrawArrays(GL_LINE_STRIP, lineRange.startIdx, lineRange.size());
         }
     }
 
@@ -238,6 +294,48 @@ void CandlestickPlot::cyclePlotType()
         m_candlestickSettings.mode = CandlestickMode::full;
 }
 
+/* -----------------------------------------------------------
+   Streaming
+------------------------------------------------------------*/
+
+
+void CandlestickPlot::appendCandles(
+    const float* openPtr, const float* highPtr,
+    const float* lowPtr, const float* closePtr,
+    std::size_t size
+)
+/*
+    Append candles to the plot data and upload only the new
+    candles to the GPU, growing the instance buffer if required.
+*/
+{
+    std::size_t oldSize = m_plotData.getNumDatapoints();
+
+    m_plotData.appendCandles(openPtr, highPtr, lowPtr, closePtr, size);
+
+    std::size_t newSize = m_plotData.getNumDatapoints();
+
+    if (newSize > m_instanceCapacity)
+    {
+        growInstanceBuffer(newSize);
+    }
+
+    updateStreamedCandles(oldSize);
+}
+
+
+void CandlestickPlot::updateLastCandle(float open, float high, float low, float close)
+/*
+    Overwrite the last candle, only its 16 bytes (and its
+    aggregated candles, if uploaded) are uploaded.
+*/
+{
+    m_plotData.updateLastCandle(open, high, low, close);
+
+    updateStreamedCandles(m_plotData.getNumDatapoints() - 1);
+}
+
+
 /* -----------------------------------------------------------
    Setup Buffers
 ------------------------------------------------------------*/
@@ -250,76 +348,46 @@ void CandlestickPlot::initializeAllBuffers()
     Low-High price of Open-Close price) as well as a normal vertex
 	line plot.
 
-	For convenient plotting, we create 4 VAO that share the same
-	instance VBO but have (optional) basis shape attached in the 
-	first position. As the instance VBO is set only once, it is
+	For convenient plotting, we create 2 VAO that share the same
+	instance VBO, one with the basis shape attached in the first
+	position. As the instance VBO is set only once, it is
 	not duplicated across VAO.
 
 	The instance attributes are:
         (xPos), (Open, Close), (Low, High).
 
-	m_bodyVAO : VAO for the square body. The data is (x, y) pairs
-			    indicating the 4 edges of the square.
-
-	m_candleVAO : VAO for the candle lines. This is (x, y) pairs
-				  for the vertices for the 3 lines that make the candle.
-
-	m_lineVAO : A single verticle line (x, y), two points. 
+	m_candleVAO : VAO for the candles. The data is (x, y, part, pixel offset)
+				  for the triangles that make the body and lines of the candle,
+				  for each candle style (see CandlestickData::makeCandleBasis).
 
 	m_linePlotVAO : This is just the instance buffer with all attributes bound.
 	                No basis shape is required because it is used for a simple line plot.
+
+	The instance buffer holds one (unused) candle of padding before the first
+	and after the last candle, so the miter line of the line modes can read
+	the candles either side of every segment (see MiterLine).
+
+    The buffers are only allocated here, the candles are uploaded
+    when first drawn or when idle (see uploadChunk()).
 */
 {
 	// Setup the instance buffer (shared between all VAO)
     m_gl.glGenBuffers(1, &m_instanceVBO);
     m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
 
+    m_instanceCapacity = m_plotData.m_open.size();
+    m_gl.glBufferData(GL_ARRAY_BUFFER, (m_instanceCapacity + 2 * instancePadding) * 4 * sizeof(float), nullptr, GL_STATIC_DRAW);
 
-    // Interleave the data for fast access on the GPU.
-    // This is a copy operation
-    std::vector<float> tmp;
-    tmp.resize(m_plotData.m_open.size() * 4);
-
-    int j = 0;
-    for (int i = 0; i < m_plotData.m_open.size(); i ++)
-    {
-        // Note the reorder to (open, close, high, low)
-        tmp[j] = m_plotData.m_open[i];
-        tmp[j + 1] = m_plotData.m_close[i];
-        tmp[j + 2] = m_plotData.m_low[i];
-        tmp[j + 3] = m_plotData.m_high[i];
-
-        j += 4;
-    }
-    m_gl.glBufferData(GL_ARRAY_BUFFER, tmp.size() * sizeof(float), tmp.data(), GL_STATIC_DRAW);
+    m_lodPyramid.update(m_plotData.m_open, m_plotData.m_high, m_plotData.m_low, m_plotData.m_close, 0);
+    allocateLodBuffers();
 
 
-	// Setup the body buffer and bind the associated instance VAO
-	m_bodyVAO.setup();
-    m_gl.glGenBuffers(1, &m_bodyBasisVBO);
-    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_bodyBasisVBO);
-    m_gl.glBufferData(GL_ARRAY_BUFFER, m_plotData.getBodyBasis().size() * sizeof(float), m_plotData.getBodyBasis().data(), GL_STATIC_DRAW);
-    m_gl.glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    m_gl.glEnableVertexAttribArray(0);
-
-	rebindInstanceBuffer(true);
-
-	// Setup the candle buffer and bind the associated instance VAO
+	// Setup the candle basis buffer and bind the associated instance VAO
 	m_candleVAO.setup();
     m_gl.glGenBuffers(1, &m_candleBasisVBO);
     m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_candleBasisVBO);
     m_gl.glBufferData(GL_ARRAY_BUFFER, m_plotData.getCandleBasis().size() * sizeof(float), m_plotData.getCandleBasis().data(), GL_STATIC_DRAW);
-    m_gl.glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    m_gl.glEnableVertexAttribArray(0);
-
-	rebindInstanceBuffer(true);
-
-	// Setup the line buffer and bind the associated instance VAO
-	m_lineVAO.setup();
-    m_gl.glGenBuffers(1, &m_lineBasisVBO);
-    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_lineBasisVBO);
-    m_gl.glBufferData(GL_ARRAY_BUFFER, m_plotData.getLineBasis().size() * sizeof(float), m_plotData.getLineBasis().data(), GL_STATIC_DRAW);
-    m_gl.glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    m_gl.glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     m_gl.glEnableVertexAttribArray(0);
 
 	rebindInstanceBuffer(true);
@@ -327,19 +395,508 @@ void CandlestickPlot::initializeAllBuffers()
 	
 	m_linePlotVAO.setup();
 	rebindInstanceBuffer(false);
+
+    m_miterLine.setup();
 }
 
-void CandlestickPlot::rebindInstanceBuffer(bool setAttributeDivisor)
+void CandlestickPlot::allocateLodBuffers()
+/*
+    Create an instance buffer for each level of the LOD pyramid
+    that does not have one, sized to the level but not filled (see
+    uploadChunk()). Buffers of levels that no longer fit their candles
+    are grown geometrically, keeping the uploaded chunks.
+*/
+{
+    for (int level = 1; level < m_lodPyramid.numLevels(); level++)
+    {
+        std::size_t numCandles = m_lodPyramid.numCandles(level);
+
+        if (m_lodVBOs.size() < (std::size_t)level)
+        {
+            unsigned int lodVBO;
+            m_gl.glGenBuffers(1, &lodVBO);
+            m_gl.glBindBuffer(GL_ARRAY_BUFFER, lodVBO);
+            m_gl.glBufferData(GL_ARRAY_BUFFER, numCandles * 4 * sizeof(float), nullptr, GL_STATIC_DRAW);
+
+            m_lodVBOs.push_back(lodVBO);
+            m_lodCapacities.push_back(numCandles);
+        }
+        else if (numCandles > m_lodCapacities[level - 1])
+        {
+            std::size_t& capacity = m_lodCapacities[level - 1];
+            std::size_t newCapacity = std::max(numCandles, capacity * 2);
+
+            m_lodVBOs[level - 1] = growBuffer(m_lodVBOs[level - 1], level, capacity, newCapacity, 0);
+            capacity = newCapacity;
+
+            // The candle VAO may point at the old buffer
+            m_boundLodLevel = -1;
+        }
+    }
+}
+
+
+void CandlestickPlot::addChunks()
+/*
+    Track the chunks of new candles (or new levels) as not uploaded, and
+    post their upload for when the GUI thread is idle. The levels are
+    posted coarsest first and a chunk per task, so each idle slice is short.
+    Levels are small until the finest few, so zooming in soon after the
+    first frame shows detail quickly.
+*/
+{
+    int numLevels = m_lodPyramid.numLevels();
+    int topGpuOnlyLevel = std::min(numLevels, CandlestickLodPyramid::cpuBaseLevel) - 1;
+
+    m_chunkUploaded.resize(numLevels);
+
+    for (int level = numLevels - 1; level >= 0; level--)
+    {
+        std::size_t oldNumChunks = m_chunkUploaded[level].size();
+        std::size_t numChunks = (m_lodPyramid.numCandles(level) + chunkCandles(level) - 1) / chunkCandles(level);
+
+        m_chunkUploaded[level].resize(numChunks, false);
+
+        // The levels only on the GPU are uploaded together (see uploadChunk())
+        if (isGpuOnlyLevel(level) && level != topGpuOnlyLevel)
+        {
+            continue;
+        }
+
+        for (std::size_t chunk = oldNumChunks; chunk < numChunks; chunk++)
+        {
+            m_linkedSubplot.deferredWork().post(this, [this, level, chunk]() { uploadChunk(level, chunk); });
+        }
+    }
+}
+
+
+bool CandlestickPlot::isGpuOnlyLevel(int level) const
+{
+    return level > 0 && !CandlestickLodPyramid::isOnCpu(level);
+}
+
+
+std::size_t CandlestickPlot::chunkCandles(int level) const
+/*
+    Candles per upload chunk on the level. The levels only on the GPU
+    are aggregated a full-resolution chunk at a time, so their chunks
+    are the candles aggregated from one full-resolution chunk.
+*/
+{
+    return isGpuOnlyLevel(level) ? (uploadChunkCandles >> level) : uploadChunkCandles;
+}
+
+
+void CandlestickPlot::uploadRange(int level, std::size_t startIdx, std::size_t endIdx)
+/*
+    Upload the chunks holding the candles [startIdx, endIdx) of the level
+    (0 is the full-resolution candles), if not already uploaded.
+*/
+{
+    if (endIdx <= startIdx)
+    {
+        return;
+    }
+
+    for (std::size_t chunk = startIdx / chunkCandles(level); chunk <= (endIdx - 1) / chunkCandles(level); chunk++)
+    {
+        uploadChunk(level, chunk);
+    }
+}
+
+
+void CandlestickPlot::uploadChunk(int level, std::size_t chunk)
+/*
+    Upload the candles of the chunk. Level 0 is interleaved into the instance
+    buffer (see writeInstanceData()). The levels only on the GPU are aggregated
+    from the full-resolution chunk, all together (see writeGpuOnlyLevels()). The
+    levels held by the pyramid are copied straight from it. Each upload, and its
+    CPU memory, is then bounded by the chunk size, however large the dataset.
+*/
+{
+    if (m_chunkUploaded[level][chunk])
+    {
+        return;
+    }
+
+    std::size_t startIdx = chunk * chunkCandles(level);
+    std::size_t endIdx = std::min(startIdx + chunkCandles(level), m_lodPyramid.numCandles(level));
+
+    if (level == 0)
+    {
+        writeInstanceData(startIdx, endIdx);
+    }
+    else if (isGpuOnlyLevel(level))
+    {
+        writeGpuOnlyLevels(startIdx << level, std::min(endIdx << level, m_lodPyramid.numCandles(0)));
+
+        for (int gpuOnlyLevel = 1; gpuOnlyLevel < m_lodPyramid.numLevels() && isGpuOnlyLevel(gpuOnlyLevel); gpuOnlyLevel++)
+        {
+            m_chunkUploaded[gpuOnlyLevel][chunk] = true;
+        }
+    }
+    else
+    {
+        writeLevelData(level, startIdx, endIdx);
+    }
+
+    m_chunkUploaded[level][chunk] = true;
+}
+
+
+void CandlestickPlot::writeGpuOnlyLevels(std::size_t startIdx, std::size_t endIdx)
+/*
+    Aggregate the candles [startIdx, endIdx) into the levels only held on
+    the GPU and upload them. `startIdx` is aligned to the top GPU-only level
+    (see CandlestickLodPyramid::reduce()), the aggregated candles are held
+    on the CPU only for the upload.
+*/
+{
+    int maxLevel = std::min(m_lodPyramid.numLevels(), CandlestickLodPyramid::cpuBaseLevel) - 1;
+
+    if (maxLevel < 1 || endIdx <= startIdx)
+    {
+        return;
+    }
+
+    std::vector<std::vector<float>> levels;
+    CandlestickLodPyramid::reduce(
+        m_plotData.m_open, m_plotData.m_high, m_plotData.m_low, m_plotData.m_close, startIdx, endIdx, maxLevel, levels
+    );
+
+    for (int level = 1; level <= maxLevel; level++)
+    {
+        const std::vector<float>& levelData = levels[level - 1];
+
+        m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_lodVBOs[level - 1]);
+        m_gl.glBufferSubData(GL_ARRAY_BUFFER, (startIdx >> level) * 4 * sizeof(float), levelData.size() * sizeof(float), levelData.data());
+    }
+}
+
+
+void CandlestickPlot::writeLevelData(int level, std::size_t startIdx, std::size_t endIdx)
 /*
-    Setup the attributes for the (xPos), (Open, Close), (Low, High) on the instance array.
+    Upload the candles [startIdx, endIdx) of a level held by the pyramid.
+*/
+{
+    if (endIdx <= startIdx)
+    {
+        return;
+    }
+
+    const std::vector<float>& levelData = m_lodPyramid.levelData(level);
+
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_lodVBOs[level - 1]);
+    m_gl.glBufferSubData(
+        GL_ARRAY_BUFFER,
+        startIdx * 4 * sizeof(float),
+        (endIdx - startIdx) * 4 * sizeof(float),
+        levelData.data() + startIdx * 4
+    );
+}
+
+
+void CandlestickPlot::writeInstanceData(std::size_t startIdx, std::size_t endIdx)
+/*
+    Interleave the candles in [startIdx, endIdx) and upload only
+    these bytes into the (already allocated) instance buffer.
+
+    Large ranges are written a chunk at a time, interleaved (in parallel)
+    straight into the mapped buffer, so there is no CPU copy of the candles.
+    Small writes (e.g. streaming the last candle) are copied through
+    glBufferSubData(), which is cheaper than mapping for a few bytes.
 */
 {
     m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
 
-    m_gl.glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(0 * sizeof(float)));  // (Open, Close)
+    for (std::size_t chunkStart = startIdx; chunkStart < endIdx; chunkStart += uploadChunkCandles)
+    {
+        std::size_t chunkEnd = std::min(chunkStart + uploadChunkCandles, endIdx);
+
+        GLintptr offset = (chunkStart + instancePadding) * 4 * sizeof(float);
+        GLsizeiptr size = (chunkEnd - chunkStart) * 4 * sizeof(float);
+
+        void* mapped = nullptr;
+        if (chunkEnd - chunkStart >= mapMinCandles)
+        {
+            mapped = m_gl.glMapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        }
+
+        if (mapped)
+        {
+            interleaveInstanceData(m_plotData, chunkStart, chunkEnd, static_cast<float*>(mapped));
+
+            // The buffer contents are undefined if unmapping fails (e.g. on a display mode change),
+            // re-write the chunk with a copy
+            if (m_gl.glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE)
+            {
+                continue;
+            }
+        }
+
+        std::vector<float> tmp;
+        interleaveInstanceData(m_plotData, chunkStart, chunkEnd, tmp);
+
+        m_gl.glBufferSubData(GL_ARRAY_BUFFER, offset, size, tmp.data());
+    }
+}
+
+
+void CandlestickPlot::interleaveInstanceData(
+    const CandlestickData& plotData, std::size_t startIdx, std::size_t endIdx, std::vector<float>& instanceData
+)
+/*
+    Interleave the candles in [startIdx, endIdx) for fast access on the GPU,
+    as (open, close, low, high) per candle. Does not touch GL, so the
+    CPU cost can be measured on its own (see bench_cpu_hot_paths.cpp).
+*/
+{
+    instanceData.resize((endIdx - startIdx) * 4);
+
+    interleaveInstanceData(plotData, startIdx, endIdx, instanceData.data());
+}
+
+
+void CandlestickPlot::interleaveInstanceData(
+    const CandlestickData& plotData, std::size_t startIdx, std::size_t endIdx, float* instanceData
+)
+/*
+    As above, into `instanceData` which holds (endIdx - startIdx) * 4 floats
+    (e.g. a mapped buffer). Large ranges are split across threads.
+*/
+{
+    parallelFor(endIdx - startIdx, interleaveChunkSize, [&](std::size_t chunkStart, std::size_t chunkEnd)
+    {
+        std::size_t j = chunkStart * 4;
+        for (std::size_t i = startIdx + chunkStart; i < startIdx + chunkEnd; i ++)
+        {
+            instanceData[j] = plotData.m_open[i];
+            instanceData[j + 1] = plotData.m_close[i];
+            instanceData[j + 2] = plotData.m_low[i];
+            instanceData[j + 3] = plotData.m_high[i];
+
+            j += 4;
+        }
+    });
+}
+
+
+void CandlestickPlot::growInstanceBuffer(std::size_t minCapacity)
+/*
+    Grow the instance buffer geometrically so that repeated appends
+    are amortised. The uploaded chunks are copied GPU-side into the
+    new buffer (no re-upload from the CPU) and the VAO that share the
+    instance buffer are re-pointed at it.
+*/
+{
+    std::size_t newCapacity = std::max(minCapacity, m_instanceCapacity * 2);
+
+    m_instanceVBO = growBuffer(m_instanceVBO, 0, m_instanceCapacity, newCapacity, instancePadding);
+    m_instanceCapacity = newCapacity;
+
+    m_candleVAO.bind();
+    rebindInstanceBuffer(true);
+
+    m_linePlotVAO.bind();
+    rebindInstanceBuffer(false);
+
+    m_linePlotVAO.unBind();
+
+    m_miterLine.resetBoundPoints();
+
+    m_boundLodLevel = 0;
+    m_boundFirstInstance = 0;
+}
+
+
+unsigned int CandlestickPlot::growBuffer(
+    unsigned int buffer, int level, std::size_t capacity, std::size_t newCapacity, std::size_t padding
+)
+/*
+    Return a new buffer for `newCapacity` candles of the level (and `padding`
+    candles each end), with the uploaded chunks of `buffer` copied into it
+    GPU-side. Chunks not uploaded are left to be uploaded when drawn or idle,
+    so the chunk flags remain valid. `buffer` is deleted.
+*/
+{
+    unsigned int newBuffer;
+    m_gl.glGenBuffers(1, &newBuffer);
+    m_gl.glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    m_gl.glBufferData(GL_COPY_WRITE_BUFFER, (newCapacity + 2 * padding) * 4 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+
+    m_gl.glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+
+    // Copy each run of uploaded chunks at once
+    const std::vector<bool>& uploaded = m_chunkUploaded[level];
+    std::size_t chunk = 0;
+
+    while (chunk < uploaded.size())
+    {
+        if (!uploaded[chunk])
+        {
+            chunk++;
+            continue;
+        }
+
+        std::size_t firstChunk = chunk;
+        while (chunk < uploaded.size() && uploaded[chunk])
+        {
+            chunk++;
+        }
+
+        std::size_t startIdx = firstChunk * chunkCandles(level);
+        std::size_t endIdx = std::min(chunk * chunkCandles(level), capacity);
+
+        if (startIdx < endIdx)
+        {
+            GLintptr offset = (startIdx + padding) * 4 * sizeof(float);
+            m_gl.glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, offset, (endIdx - startIdx) * 4 * sizeof(float));
+        }
+    }
+
+    m_gl.glDeleteBuffers(1, &buffer);
+
+    return newBuffer;
+}
+
+
+/* -----------------------------------------------------------
+   Level of Detail
+------------------------------------------------------------*/
+
+
+void CandlestickPlot::updateStreamedCandles(std::size_t firstChangedIdx)
+/*
+    Update the LOD pyramid from `firstChangedIdx`, and upload the changed
+    candles on each level only into the chunks that are already uploaded.
+    The other chunks are uploaded when drawn or idle, from the updated
+    candles, so streaming into a large plot never uploads the whole dataset.
+    The LOD buffers are grown geometrically when streamed candles no
+    longer fit.
+*/
+{
+    std::size_t numDatapoints = m_plotData.getNumDatapoints();
+
+    m_lodPyramid.update(m_plotData.m_open, m_plotData.m_high, m_plotData.m_low, m_plotData.m_close, firstChangedIdx);
+
+    allocateLodBuffers();
+    addChunks();
+
+    for (int level = 0; level < m_lodPyramid.numLevels(); level++)
+    {
+        // The levels only on the GPU are aggregated from level 0, below
+        if (isGpuOnlyLevel(level))
+        {
+            continue;
+        }
+
+        std::size_t firstChangedCandle = firstChangedIdx >> level;
+        std::size_t numCandles = m_lodPyramid.numCandles(level);
+
+        for (std::size_t chunk = firstChangedCandle / uploadChunkCandles; chunk < m_chunkUploaded[level].size(); chunk++)
+        {
+            if (!m_chunkUploaded[level][chunk])
+            {
+                continue;
+            }
+
+            std::size_t startIdx = std::max(firstChangedCandle, chunk * uploadChunkCandles);
+            std::size_t endIdx = std::min((chunk + 1) * uploadChunkCandles, numCandles);
+
+            if (level == 0)
+            {
+                writeInstanceData(startIdx, endIdx);
+            }
+            else
+            {
+                writeLevelData(level, startIdx, endIdx);
+            }
+        }
+    }
+
+    // Re-aggregate the changed GPU-only candles of uploaded chunks, from the start
+    // of the top level candle holding the first changed candle
+    int topGpuOnlyLevel = std::min(m_lodPyramid.numLevels(), CandlestickLodPyramid::cpuBaseLevel) - 1;
+
+    if (topGpuOnlyLevel >= 1)
+    {
+        std::size_t alignedIdx = (firstChangedIdx >> topGpuOnlyLevel) << topGpuOnlyLevel;
+
+        for (std::size_t chunk = alignedIdx / uploadChunkCandles; chunk < m_chunkUploaded[1].size(); chunk++)
+        {
+            if (m_chunkUploaded[1][chunk])
+            {
+                writeGpuOnlyLevels(
+                    std::max(alignedIdx, chunk * uploadChunkCandles),
+                    std::min((chunk + 1) * uploadChunkCandles, numDatapoints)
+                );
+            }
+        }
+    }
+}
+
+
+int CandlestickPlot::selectLodLevel(Camera& camera)
+/*
+    Pick the LOD level for the current view, such that each drawn
+    candle is at least ~1 pixel wide.
+*/
+{
+    double numPixelsInView = m_linkedSubplot.windowViewport().plotWidthInPixels();
+    double numCandlesInView = camera.getViewWidth() / getPlotData().getDelta();
+
+    return CandlestickLodPyramid::selectLevel(numCandlesInView, numPixelsInView, m_lodPyramid.numLevels());
+}
+
+
+void CandlestickPlot::bindInstanceRange(int level, std::size_t firstInstance)
+/*
+    Point the instanced VAO at the instance buffer for the LOD level,
+    starting at `firstInstance`. This is only re-bound when the level
+    or first visible candle changes. The line plot VAO (line modes)
+    always uses the full data, from the first vertex.
+*/
+{
+    if (level == m_boundLodLevel && firstInstance == m_boundFirstInstance)
+    {
+        return;
+    }
+
+    unsigned int instanceVBO = (level == 0) ? m_instanceVBO : m_lodVBOs[level - 1];
+
+    m_candleVAO.bind();
+    rebindInstanceBuffer(true, instanceVBO, firstInstance);
+
+    m_candleVAO.unBind();
+
+    m_boundLodLevel = level;
+    m_boundFirstInstance = firstInstance;
+}
+
+
+void CandlestickPlot::rebindInstanceBuffer(bool setAttributeDivisor)
+{
+    rebindInstanceBuffer(setAttributeDivisor, m_instanceVBO, 0);
+}
+
+
+void CandlestickPlot::rebindInstanceBuffer(bool setAttributeDivisor, unsigned int instanceVBO, std::size_t firstInstance)
+/*
+    Setup the attributes for the (xPos), (Open, Close), (Low, High) on the instance array,
+    starting from the candle `firstInstance`. The full-resolution instance buffer
+    is padded (see initializeAllBuffers()), the LOD level buffers are not.
+*/
+{
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+    std::size_t padding = (instanceVBO == m_instanceVBO) ? instancePadding : 0;
+    std::size_t firstByte = (firstInstance + padding) * 4 * sizeof(float);
+
+    m_gl.glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(firstByte + 0 * sizeof(float)));  // (Open, Close)
     m_gl.glEnableVertexAttribArray(1);
 
-    m_gl.glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));  // (Low, High)
+    m_gl.glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(firstByte + 2 * sizeof(float)));  // (Low, High)
     m_gl.glEnableVertexAttribArray(2);
 
 	if (setAttributeDivisor)  // We do not want to do this for line plot which is not an instance
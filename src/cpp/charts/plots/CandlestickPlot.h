@@ -3,6 +3,8 @@
 #include <QOpenGLFunctions_3_3_Core>
 #include "../Camera.h"
 #include "CandlestickData.h"
+#include "CandlestickLodPyramid.h"
+#include "MiterLine.h"
 #include "../../opengl/VertexArrayObject.h"
 #include "../../Configs.h"
 #include "../shaders/Program.h"
@@ -17,17 +19,33 @@ class CandlestickPlot : public FourValuePlot
 	Contains VAO and Buffers for the instance array
 	as well as basis shapes.
 
-	There are 4 types of basis shape:
+	There is a basis shape for each candle style, made of triangles:
 
-	body : the square that makes up the candle body
-	candle : the full candlestick, including the gaps
-	line : a vertical line. For candlestick no caps, this is
-           between the low / high price. For no candle, this is still
+	full : the candle body and the full candlestick lines, including the caps
+	noCaps : the candle body and a vertical line between the low / high price
+	bodyOnly : the candle body and a vertical line between the open / close price,
 		   displayed under the candle body. Without this line, the candles
 		   start to dissapear when zoomed out far, and could not solve any other way.
 
+	Lines are drawn as 1 pixel wide quads, so all candles are a single instanced
+	draw and does not depend on glLineWidth.
+
 	These are shift and scaled in the `candlestick_vertex.shader` 
 	to their appropriate poisition on the plot.
+
+    When zoomed out so that many candles fall in a single pixel, candles are
+    drawn from a level of the LOD pyramid (see CandlestickLodPyramid), each level
+    has its own instance buffer that is swapped into the VAO when drawn.
+
+    Each level is uploaded in chunks of `uploadChunkCandles`, a chunk is uploaded
+    when it is first drawn or when the GUI thread is idle (coarse levels first,
+    see DeferredWorkQueue). A frame only waits for the chunks in view, so the
+    first frame of a large dataset (or the first zoom into it) is shown as soon
+    as the candles it draws are uploaded, and the rest are streamed in over the
+    following frames. Candles are interleaved straight into the mapped buffer,
+    and the finer LOD levels are aggregated a chunk at a time as they are
+    uploaded, so no CPU copy of the dataset is made. Streamed candles are only
+    written into chunks already uploaded.
 */
 {
 
@@ -48,12 +66,27 @@ public:
 
 	void cyclePlotType();
 
+    void appendCandles(
+        const float* openPtr, const float* highPtr,
+        const float* lowPtr, const float* closePtr,
+        std::size_t size
+    );
+    void updateLastCandle(float open, float high, float low, float close);
+
     void draw(glm::mat4& NDCMatrix, Camera& camera) override;
+    ProfileStage profileStage() const override { return ProfileStage::candlestickPlot; };
 
     CandlestickColor getPlotColor()const override {
         return  CandlestickColor{m_candlestickSettings.upColor, m_candlestickSettings.downColor};
     };
 
+    static void interleaveInstanceData(
+        const CandlestickData& plotData, std::size_t startIdx, std::size_t endIdx, std::vector<float>& instanceData
+    );
+    static void interleaveInstanceData(
+        const CandlestickData& plotData, std::size_t startIdx, std::size_t endIdx, float* instanceData
+    );
+
 private:
 
     Configs& m_configs;
@@ -66,16 +99,40 @@ private:
     CandlestickData m_plotData;
 
 	void initializeAllBuffers();
+    void allocateLodBuffers();
+    void addChunks();
+    bool isGpuOnlyLevel(int level) const;
+    std::size_t chunkCandles(int level) const;
+    void uploadRange(int level, std::size_t startIdx, std::size_t endIdx);
+    void uploadChunk(int level, std::size_t chunk);
+    void writeGpuOnlyLevels(std::size_t startIdx, std::size_t endIdx);
+    void writeLevelData(int level, std::size_t startIdx, std::size_t endIdx);
 	void rebindInstanceBuffer(bool setAttributeDivisor);
+    void rebindInstanceBuffer(bool setAttributeDivisor, unsigned int instanceVBO, std::size_t firstInstance);
+    void growInstanceBuffer(std::size_t minCapacity);
+    unsigned int growBuffer(unsigned int buffer, int level, std::size_t capacity, std::size_t newCapacity, std::size_t padding);
+    void writeInstanceData(std::size_t startIdx, std::size_t endIdx);
+    void updateStreamedCandles(std::size_t firstChangedIdx);
+    int selectLodLevel(Camera& camera);
+    void bindInstanceRange(int level, std::size_t firstInstance);
 
 	unsigned int m_instanceVBO;
-	unsigned int m_bodyBasisVBO;
+    std::size_t m_instanceCapacity = 0;  // in number of candles, without the padding
+    static constexpr std::size_t instancePadding = 1;  // unused candles at each end, see MiterLine
+    static constexpr std::size_t interleaveChunkSize = 1 << 18;  // candles per thread, see interleaveInstanceData()
+    static constexpr std::size_t uploadChunkCandles = 1 << 20;  // 16 MB, see uploadChunk()
+    static constexpr std::size_t mapMinCandles = 1 << 12;  // smaller writes are copied, see writeInstanceData()
+
+    CandlestickLodPyramid m_lodPyramid;
+    std::vector<unsigned int> m_lodVBOs;  // m_lodVBOs[L - 1] holds level L
+    std::vector<std::size_t> m_lodCapacities;
+    std::vector<std::vector<bool>> m_chunkUploaded;  // m_chunkUploaded[L][i] for chunk i of level L, see chunkCandles()
+    int m_boundLodLevel = 0;  // -1 if the bound buffer was replaced
+    std::size_t m_boundFirstInstance = 0;
 	unsigned int m_candleBasisVBO;
-	unsigned int m_lineBasisVBO;
 
-    VertexArrayObject m_bodyVAO;
     VertexArrayObject m_candleVAO;
-    VertexArrayObject m_lineVAO;
     VertexArrayObject m_linePlotVAO;
+    MiterLine m_miterLine;
 
 };
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cmath>
+#include "LineMinMaxPyramid.h"
+#include "../../ParallelFor.h"
+
+
+void LineMinMaxPyramid::build(const StdPtrVector<float>& yData)
+/*
+    Build all levels. NaN values (gaps) are ignored for the min / max,
+    a block of only NaN stores its first sample as the min / max.
+ */
+{
+    m_yData = yData;
+    m_levels.clear();
+
+    const float* data = yData.data();
+    std::size_t numSamples = yData.size();
+
+    std::size_t blockSize = std::size_t(1) << firstLevel;
+
+    if (numSamples < 2 * blockSize)
+    {
+        return;
+    }
+
+    // First level from the data
+    std::size_t numBlocks = (numSamples + blockSize - 1) / blockSize;
+    std::vector<BlockSummary> level(numBlocks);
+
+    // This reads every sample, so is split across threads
+    parallelFor(numBlocks, parallelChunkBlocks, [&](std::size_t chunkStart, std::size_t chunkEnd)
+    {
+        for (std::size_t blockIdx = chunkStart; blockIdx < chunkEnd; blockIdx++)
+        {
+            std::size_t start = blockIdx * blockSize;
+            std::size_t end = std::min(start + blockSize, numSamples);
+
+            BlockSummary summary{data[start], data[start], 0, 0};
+
+            for (std::size_t i = start; i < end; i++)
+            {
+                if (data[i] < summary.min || std::isnan(summary.min))
+                {
+                    summary.min = data[i];
+                    summary.minOffset = (std::uint32_t)(i - start);
+                }
+                if (data[i] > summary.max || std::isnan(summary.max))
+                {
+                    summary.max = data[i];
+                    summary.maxOffset = (std::uint32_t)(i - start);
+                }
+            }
+            level[blockIdx] = summary;
+        }
+    });
+    m_levels.push_back(std::move(level));
+
+    // Higher levels, merge pairs of blocks from the level below
+    while (m_levels.back().size() > 1)
+    {
+        const std::vector<BlockSummary>& child = m_levels.back();
+        std::uint32_t childBlockSize = (std::uint32_t)(std::size_t(1) << (firstLevel + m_levels.size() - 1));
+
+        std::vector<BlockSummary> parent((child.size() + 1) / 2);
+
+        for (std::size_t i = 0; i < parent.size(); i++)
+        {
+            BlockSummary summary = child[2 * i];
+
+            if (2 * i + 1 < child.size())
+            {
+                const BlockSummary& right = child[2 * i + 1];
+
+                if (right.min < summary.min || std::isnan(summary.min))
+                {
+                    summary.min = right.min;
+                    summary.minOffset = right.minOffset + childBlockSize;
+                }
+                if (right.max > summary.max || std::isnan(summary.max))
+                {
+                    summary.max = right.max;
+                    summary.maxOffset = right.maxOffset + childBlockSize;
+                }
+            }
+            parent[i] = summary;
+        }
+        m_levels.push_back(std::move(parent));
+    }
+}
+
+
+int LineMinMaxPyramid::selectLevel(double numSamplesInView, double numPixelsInView) const
+/*
+    Select the highest level on which a block is not wider than one pixel
+    column. Returns 0 if there are too few samples per pixel to decimate.
+ */
+{
+    if (m_levels.empty() || numPixelsInView <= 0)
+    {
+        return 0;
+    }
+
+    double samplesPerPixel = numSamplesInView / numPixelsInView;
+
+    int level = 0;
+    while (level + 1 <= firstLevel + (int)m_levels.size() - 1 && std::pow(2.0, level + 1) <= samplesPerPixel)
+    {
+        level++;
+    }
+    return (level >= firstLevel) ? level : 0;
+}
+
+
+std::size_t LineMinMaxPyramid::decimate(
+    int level, std::size_t startIdx, std::size_t endIdx,
+    std::vector<float>& outVertices
+) const
+/*
+    Write the decimated line for the samples [startIdx, endIdx) to `outVertices`
+    as interleaved (y, x-index) where the x-index is relative to the returned
+    first index (so it can be held exactly in a float). For each block, the
+    first, min, max and last samples are output in index order, without
+    duplicates (a zero-length segment breaks the miter joints, see MiterLine).
+ */
+{
+    outVertices.clear();
+
+    const std::vector<BlockSummary>& summaries = m_levels[level - firstLevel];
+    const float* data = m_yData.data();
+    std::size_t blockSize = std::size_t(1) << level;
+
+    std::size_t startBlock = startIdx / blockSize;
+    std::size_t endBlock = std::min(summaries.size(), (endIdx + blockSize - 1) / blockSize);
+
+    std::size_t firstIdx = startBlock * blockSize;
+
+    outVertices.reserve((endBlock - startBlock) * 4 * 2);
+
+    for (std::size_t blockIdx = startBlock; blockIdx < endBlock; blockIdx++)
+    {
+        std::size_t start = blockIdx * blockSize;
+        std::size_t last = std::min(start + blockSize, m_yData.size()) - 1;
+
+        const BlockSummary& summary = summaries[blockIdx];
+
+        std::size_t indices[4] = {start, start + summary.minOffset, start + summary.maxOffset, last};
+        std::sort(indices, indices + 4);
+        std::size_t* uniqueEnd = std::unique(indices, indices + 4);
+
+        for (std::size_t* idx = indices; idx != uniqueEnd; idx++)
+        {
+            outVertices.push_back(data[*idx]);
+            outVertices.push_back((float)(*idx - firstIdx));
+        }
+    }
+
+    return firstIdx;
+}
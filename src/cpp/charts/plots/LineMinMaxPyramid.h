@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../../include/UserVector.h"
+
+
+class LineMinMaxPyramid
+/*
+    Precomputed block summaries for min / max (M4) decimation of line plots.
+
+    When zoomed out, many samples fall in a single pixel column. Drawing the
+    first, min, max and last sample of each pixel column (in index order) gives
+    the same rasterised line as drawing every sample, with only up to four
+    vertices per column.
+
+    For each level L (starting at `firstLevel`) the data is split into blocks
+    of 2^L samples and the min / max value and their position in the block are
+    stored. The first / last samples are read directly from the data. Each level
+    is built by merging pairs of blocks from the level below. Blocks smaller than
+    2^firstLevel are not stored (the full line is cheap to draw at that zoom).
+*/
+{
+
+public:
+    LineMinMaxPyramid() = default;
+
+    LineMinMaxPyramid(const LineMinMaxPyramid&) = delete;
+    LineMinMaxPyramid& operator=(const LineMinMaxPyramid&) = delete;
+    LineMinMaxPyramid(LineMinMaxPyramid&&) = delete;
+    LineMinMaxPyramid& operator=(LineMinMaxPyramid&&) = delete;
+
+    void build(const StdPtrVector<float>& yData);
+
+    int selectLevel(double numSamplesInView, double numPixelsInView) const;
+
+    std::size_t decimate(
+        int level, std::size_t startIdx, std::size_t endIdx,
+        std::vector<float>& outVertices
+    ) const;
+
+    static constexpr int firstLevel = 4;
+
+private:
+
+    static constexpr std::size_t parallelChunkBlocks = 1 << 14;  // first level blocks per thread
+
+    struct BlockSummary
+    {
+        float min;
+        float max;
+        std::uint32_t minOffset;  // position of the min / max in the block
+        std::uint32_t maxOffset;
+    };
+
+    StdPtrVector<float> m_yData;
+
+    // m_levels[i] holds level (firstLevel + i)
+    std::vector<std::vector<BlockSummary>> m_levels;
+};
@@ -12,14 +12,15 @@ LinePlot::LinePlot(
     m_linkedSubplot(subplot),
     m_gl(glFunctions),
     m_lineProgram(
-          "line_vertex.shader",
+          "line_instanced_vertex.shader",
           "line_fragment.shader",
-          "line_geometry.shader",
           glFunctions
           ),
     m_oldPlotStyleProgram("line_vertex.shader", "line_fragment.shader", glFunctions),
     m_plotData(configs, yPtr, ySize),
-    m_yDataVAO(glFunctions)
+    m_yDataVAO(glFunctions),
+    m_miterLine(glFunctions),
+    m_decimatedVAO(glFunctions)
 {
     initializeAllBuffers();
     m_lineProgram.setupAndBindProgram();
@@ -31,6 +32,9 @@ LinePlot::~LinePlot()
 {
     m_gl.glDeleteBuffers(1, &m_yDataVBO);
     m_yDataVBO = 0;
+
+    m_gl.glDeleteBuffers(1, &m_decimatedVBO);
+    m_decimatedVBO = 0;
 }
 
 
@@ -39,56 +43,155 @@ void LinePlot::draw(glm::mat4& NDCMatrix, Camera& camera)
 
     m_gl.glEnable(GL_DEPTH_TEST);  // dont draw overlapping points (e.g. zoomed out)
 
+    // Only draw the vertices in view. Two vertices margin, as each segment needs its
+    // neighbours. The shader x positions are relative to the first drawn vertex, and the
+    // offset is computed relative to it here in double, so both stay small and exact.
+    VisibleIndexRange visibleRange = visibleIndexRange(camera, getPlotData().getDelta(), m_plotData.getYData().size(), 2);
+
+    // When zoomed out so many samples fall in each pixel column, draw the min / max
+    // (M4) decimated line instead, which rasterises the same (see LineMinMaxPyramid).
+    // Its vertices hold their x-index relative to the first decimated sample.
+    int decimationLevel = m_minMaxPyramid.selectLevel(
+        visibleRange.size(), m_linkedSubplot.windowViewport().plotWidthInPixels()
+    );
+
+    int firstVertex = visibleRange.startIdx;
+    int drawnVertices = visibleRange.size();
+    int numVertices = m_plotData.getYData().size();
+    double offset = camera.getLeft() - getPlotData().getDelta() * (double)firstVertex;
+
+    if (decimationLevel > 0)
+    {
+        updateDecimatedBuffer(decimationLevel, visibleRange);
+
+        firstVertex = 0;
+        drawnVertices = m_numDecimatedVertices;
+        numVertices = m_numDecimatedVertices;
+        offset = camera.getLeft() - getPlotData().getDelta() * (double)m_decimatedFirstIdx;
+    }
+
     if (!m_lineSettings.basicLine)
     {
+        // The point before the first segment is at `firstVertex` in the padded buffers
+        if (decimationLevel > 0)
+        {
+            m_miterLine.bindPoints(m_decimatedVBO, 0, 2, 2 * sizeof(float));
+        }
+        else
+        {
+            m_miterLine.bindPoints(m_yDataVBO, firstVertex * sizeof(float), 1, sizeof(float));
+        }
+
         m_lineProgram.bind();
+        m_lineProgram.setUniform1i("dataLayout", (int)(decimationLevel > 0));
         m_lineProgram.setUniform1f("xDelta", (float)getPlotData().getDelta());
+        m_lineProgram.setUniform1i("firstVertex", firstVertex);
 
         m_lineProgram.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-        m_lineProgram.setUniform1f("offset", (float)camera.getLeft());
+        m_lineProgram.setUniform1f("offset", (float)offset);
         m_lineProgram.setUniform1f("aspectRatio", camera.getAspectRatio());
         m_lineProgram.setUniform4f("color", m_lineSettings.color);
         m_lineProgram.setUniform1f("width", m_lineSettings.width / 100.0);
         m_lineProgram.setUniform1f("miterLimit", m_lineSettings.miterLimit);
         m_lineProgram.setUniform1f("yHeightProportion", m_linkedSubplot.m_yHeightProportion);
-        m_lineProgram.setUniform1i("numVertices", m_plotData.getYData().size());
+        m_lineProgram.setUniform1i("numVertices", numVertices);
         m_lineProgram.setUniform1f("subplotHeightProportion", m_linkedSubplot.windowViewport().subplotSizePercent().second);
 
-        m_yDataVAO.bind();
-
-        m_gl.glDrawArrays(GL_LINE_STRIP_ADJACENCY, 0, m_plotData.getYData().size());
+        m_miterLine.draw(drawnVertices);
     }
     else
     {
+        if (decimationLevel > 0)
+        {
+            m_decimatedVAO.bind();
+        }
+        else
+        {
+            m_yDataVAO.bind();
+        }
+
         m_oldPlotStyleProgram.bind();
         m_oldPlotStyleProgram.setUniform1f("xDelta", (float)getPlotData().getDelta());
+        m_oldPlotStyleProgram.setUniform1i("useXIndex", (int)(decimationLevel > 0));
+        m_oldPlotStyleProgram.setUniform1i("firstVertex", firstVertex);
 
         m_oldPlotStyleProgram.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-        m_oldPlotStyleProgram.setUniform1f("offset", (float)camera.getLeft());
+        m_oldPlotStyleProgram.setUniform1f("offset", (float)offset);
         m_oldPlotStyleProgram.setUniform4f("color", m_lineSettings.color);
-        m_yDataVAO.bind();
 
-        m_gl.glDrawArrays(GL_LINE_STRIP, 0, m_plotData.getYData().size());
+        m_gl.glDrawArrays(GL_LINE_STRIP, firstVertex, drawnVertices);
     }
     m_gl.glDisable(GL_DEPTH_TEST);
 }
 
 
+void LinePlot::updateDecimatedBuffer(int level, VisibleIndexRange visibleRange)
+/*
+    Fill the decimated vertex buffer for the samples in view. This is only
+    a few vertices per pixel column, and is skipped if the level and visible
+    range are unchanged (e.g. redraws on mouse move, or vertical pans).
+*/
+{
+    if (level == m_decimatedLevel &&
+        visibleRange.startIdx == m_decimatedRange.startIdx &&
+        visibleRange.endIdx == m_decimatedRange.endIdx)
+    {
+        return;
+    }
+
+    m_decimatedFirstIdx = m_minMaxPyramid.decimate(level, visibleRange.startIdx, visibleRange.endIdx, m_decimatedVertices);
+    m_numDecimatedVertices = m_decimatedVertices.size() / 2;
+
+    // One (unused) vertex of padding at each end, see MiterLine
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_decimatedVBO);
+    m_gl.glBufferData(GL_ARRAY_BUFFER, (m_decimatedVertices.size() + 4) * sizeof(float), nullptr, GL_STREAM_DRAW);
+    m_gl.glBufferSubData(GL_ARRAY_BUFFER, 2 * sizeof(float), m_decimatedVertices.size() * sizeof(float), m_decimatedVertices.data());
+
+    m_decimatedLevel = level;
+    m_decimatedRange = visibleRange;
+}
+
+
 void LinePlot::initializeAllBuffers()
+/*
+    The y data is uploaded with one point of padding at each end (a copy
+    of the first / last point, it is not drawn), so the miter line can
+    read the points either side of every segment (see MiterLine). The
+    basic line VAOs skip the padding.
+*/
 {
-    // Setup the instance buffer (shared between all VAO)
+    const StdPtrVector<float>& yData = m_plotData.getYData();
+    std::size_t numPoints = yData.size();
+
     m_yDataVAO.setup();
     m_gl.glGenBuffers(1, &m_yDataVBO);
     m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_yDataVBO);
 
-    m_gl.glBufferData(
-        GL_ARRAY_BUFFER,
-        m_plotData.getYData().size() * sizeof(float),
-        m_plotData.getYData().data(),
-        GL_STATIC_DRAW
-    );
+    m_gl.glBufferData(GL_ARRAY_BUFFER, (numPoints + 2) * sizeof(float), nullptr, GL_STATIC_DRAW);
+    m_gl.glBufferSubData(GL_ARRAY_BUFFER, sizeof(float), numPoints * sizeof(float), yData.data());
+
+    if (numPoints > 0)
+    {
+        m_gl.glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float), yData.data());
+        m_gl.glBufferSubData(GL_ARRAY_BUFFER, (numPoints + 1) * sizeof(float), sizeof(float), yData.data() + numPoints - 1);
+    }
+
+    m_gl.glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, 0, (void*)sizeof(float));
+    m_gl.glEnableVertexAttribArray(0);
 
-    m_gl.glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    m_miterLine.setup();
+
+    // Setup the decimated line buffer, interleaved (y, x-index), filled on draw
+    m_minMaxPyramid.build(m_plotData.getYData());
+
+    m_decimatedVAO.setup();
+    m_gl.glGenBuffers(1, &m_decimatedVBO);
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_decimatedVBO);
+
+    m_gl.glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)(2 * sizeof(float)));
     m_gl.glEnableVertexAttribArray(0);
+
+    m_gl.glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)(3 * sizeof(float)));
+    m_gl.glEnableVertexAttribArray(1);
 }
 
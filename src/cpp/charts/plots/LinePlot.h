@@ -4,6 +4,8 @@
 #include "../Camera.h"
 #include "../../Configs.h"
 #include "LineData.h"
+#include "LineMinMaxPyramid.h"
+#include "MiterLine.h"
 #include "../../opengl/VertexArrayObject.h"
 #include "BasePlot.h"
 #include "../shaders/Program.h"
@@ -25,6 +27,7 @@ public:
     ~LinePlot();
 
     void draw(glm::mat4& NDCMatrix, Camera& camera) override;
+    ProfileStage profileStage() const override { return ProfileStage::linePlot; };
 
     const LineData& getPlotData() const override { return m_plotData; }
     PlotColor getPlotColor()const override { return  PlotColor{m_lineSettings.color}; };
@@ -39,9 +42,23 @@ private:
     LineData m_plotData;
 
     void initializeAllBuffers();
+    void updateDecimatedBuffer(int level, VisibleIndexRange visibleRange);
 
+    // The y data and decimated buffers hold one unused point of padding
+    // at each end, as read by the miter line (see MiterLine).
     unsigned int m_yDataVBO;
     VertexArrayObject m_yDataVAO;
+    MiterLine m_miterLine;
+
+    // Min / max (M4) decimated line, used when zoomed out
+    LineMinMaxPyramid m_minMaxPyramid;
+    unsigned int m_decimatedVBO;
+    VertexArrayObject m_decimatedVAO;
+    std::vector<float> m_decimatedVertices;
+    std::size_t m_numDecimatedVertices = 0;
+    std::size_t m_decimatedFirstIdx = 0;
+    int m_decimatedLevel = -1;
+    VisibleIndexRange m_decimatedRange{0, 0};
 };
 
 #endif
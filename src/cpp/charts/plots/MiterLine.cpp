@@ -0,0 +1,75 @@
+#include "MiterLine.h"
+
+
+MiterLine::MiterLine(QOpenGLFunctions_3_3_Core& glFunctions)
+    : m_gl(glFunctions),
+      m_VAO(glFunctions)
+{
+}
+
+
+void MiterLine::setup()
+/*
+    The VAO has no per-vertex attributes, the corner of
+    the segment quad is taken from gl_VertexID.
+*/
+{
+    m_VAO.setup();
+
+    for (unsigned int attributeIdx = 0; attributeIdx < 4; attributeIdx++)
+    {
+        m_gl.glEnableVertexAttribArray(attributeIdx);
+        m_gl.glVertexAttribDivisor(attributeIdx, 1);
+    }
+
+    m_VAO.unBind();
+}
+
+
+void MiterLine::bindPoints(unsigned int VBO, std::size_t firstByte, int numComponents, std::size_t stride)
+/*
+    Read the points from `VBO`, where `firstByte` is the padding (or
+    data) point before the start of the first drawn segment. Points
+    are `numComponents` floats, `stride` bytes apart.
+*/
+{
+    if (VBO == m_boundVBO && firstByte == m_boundFirstByte &&
+        numComponents == m_boundNumComponents && stride == m_boundStride)
+    {
+        return;
+    }
+
+    m_VAO.bind();
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    // (point before, segment start, segment end, point after)
+    for (unsigned int attributeIdx = 0; attributeIdx < 4; attributeIdx++)
+    {
+        m_gl.glVertexAttribPointer(
+            attributeIdx, numComponents, GL_FLOAT, GL_FALSE, (GLsizei)stride, (void*)(firstByte + attributeIdx * stride)
+        );
+    }
+
+    m_VAO.unBind();
+
+    m_boundVBO = VBO;
+    m_boundFirstByte = firstByte;
+    m_boundNumComponents = numComponents;
+    m_boundStride = stride;
+}
+
+
+void MiterLine::draw(int numPoints)
+/*
+    Draw the `numPoints - 1` segments between the points from
+    those bound in bindPoints(). The program must be bound.
+*/
+{
+    if (numPoints < 2)
+    {
+        return;
+    }
+
+    m_VAO.bind();
+    m_gl.glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, numPoints - 1);
+}
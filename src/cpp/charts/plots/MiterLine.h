@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <QOpenGLFunctions_3_3_Core>
+#include "../../opengl/VertexArrayObject.h"
+
+
+class MiterLine
+/*
+    Draw a thick line with miter joints (bevel joints past the miter limit)
+    as a single instanced draw, one instance per segment. Each instance is
+    a 4-vertex triangle strip whose corners are placed in the vertex shader
+    (see `line_instanced_vertex.shader`).
+
+    The points are read (vertex pulling) from the plot's own vertex buffer
+    as instanced attributes. Segment i reads its start and end point and the
+    points before and after it, for the joints at each end (attributes 0 - 3
+    point at the same buffer, each one point further along). The points before
+    the first and after the last point are read but not used, so the buffer
+    must hold one (unused) point of padding at each end.
+
+    This replaces drawing GL_LINE_STRIP_ADJACENCY through a geometry shader,
+    which is slow on many drivers and very slow on software rasterizers.
+*/
+{
+
+public:
+    MiterLine(QOpenGLFunctions_3_3_Core& glFunctions);
+
+    MiterLine(const MiterLine&) = delete;
+    MiterLine& operator=(const MiterLine&) = delete;
+    MiterLine(MiterLine&&) = delete;
+    MiterLine& operator=(MiterLine&&) = delete;
+
+    void setup();
+
+    void bindPoints(unsigned int VBO, std::size_t firstByte, int numComponents, std::size_t stride);
+    void resetBoundPoints() { m_boundVBO = 0; };
+
+    void draw(int numPoints);
+
+private:
+
+    QOpenGLFunctions_3_3_Core& m_gl;
+    VertexArrayObject m_VAO;
+
+    // The attributes are only re-pointed when these change
+    unsigned int m_boundVBO = 0;
+    std::size_t m_boundFirstByte = 0;
+    int m_boundNumComponents = 0;
+    std::size_t m_boundStride = 0;
+};
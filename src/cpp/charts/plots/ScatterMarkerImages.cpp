@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <QByteArray>
+#include <QFile>
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include "ScatterMarkerImages.h"
+
+
+void ScatterMarkerImages::prefetch()
+/*
+    Start decoding on a worker thread, if not already started.
+ */
+{
+    std::lock_guard<std::mutex> lock(decodedMutex());
+
+    if (!decoded().valid())
+    {
+        decoded() = std::async(std::launch::async, &ScatterMarkerImages::decodeAll).share();
+    }
+}
+
+
+const MarkerImage& ScatterMarkerImages::get(ScatterShape shape)
+/*
+    The images are never released, so the reference is valid for
+    the lifetime of the process.
+ */
+{
+    prefetch();
+
+    std::shared_future<std::vector<MarkerImage>> images;
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex());
+        images = decoded();
+    }
+
+    // Indexed in the order of decodeAll()
+    return images.get()[static_cast<int>(shape)];
+}
+
+
+std::vector<MarkerImage> ScatterMarkerImages::decodeAll()
+/*
+    In the order of the ScatterShape enum.
+ */
+{
+    std::vector<MarkerImage> images;
+    images.push_back(decode(":/scatterTexture/charts/plots/textures/circle.png"));
+    images.push_back(decode(":/scatterTexture/charts/plots/textures/triangle_up.png"));
+    images.push_back(decode(":/scatterTexture/charts/plots/textures/triangle_down.png"));
+    images.push_back(decode(":/scatterTexture/charts/plots/textures/cross.png"));
+
+    return images;
+}
+
+
+MarkerImage ScatterMarkerImages::decode(const char* resourcePath)
+/*
+    The rows are flipped here rather than with stbi_set_flip_vertically_on_load(),
+    which sets global state and so is not safe to use from the worker thread.
+ */
+{
+    QFile file(resourcePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        std::cerr << "CRITICAL ERROR: Failed to open resource file: " << resourcePath << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    QByteArray imageData = file.readAll();
+    file.close();
+
+    int width, height, numChannels;
+    unsigned char* data = stbi_load_from_memory(
+        reinterpret_cast<const unsigned char*>(imageData.constData()),
+        imageData.size(),
+        &width,
+        &height,
+        &numChannels,
+        4
+    );
+
+    if (!data)
+    {
+        std::cerr << "CRITICAL ERROR: Failed to load png texture." << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    MarkerImage image{width, height, std::vector<unsigned char>(width * height * 4)};
+
+    std::size_t rowBytes = width * 4;
+    for (int row = 0; row < height; row++)
+    {
+        std::memcpy(image.pixels.data() + row * rowBytes, data + (height - 1 - row) * rowBytes, rowBytes);
+    }
+
+    stbi_image_free(data);
+
+    return image;
+}
+
+
+std::shared_future<std::vector<MarkerImage>>& ScatterMarkerImages::decoded()
+{
+    static std::shared_future<std::vector<MarkerImage>> images;
+    return images;
+}
+
+
+std::mutex& ScatterMarkerImages::decodedMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <future>
+#include <mutex>
+#include <vector>
+#include "../../include/Plotter.h"
+
+
+struct MarkerImage
+/*
+    A decoded marker texture, RGBA with the bottom row first (as OpenGL expects).
+ */
+{
+    int width;
+    int height;
+    std::vector<unsigned char> pixels;
+};
+
+
+class ScatterMarkerImages
+/*
+    The scatter marker textures (the .png in charts/plots/textures), decoded once
+    per process. Decoding runs on a worker thread started by prefetch(), which the
+    Plotter calls on construction so it overlaps the window and OpenGL setup.
+    get() waits for it if it is still running (or starts it, if not prefetched).
+
+    Only the pixels are shared, each ScatterPlot uploads the texture of its own
+    shape when first drawn. Thread-safe.
+ */
+{
+
+public:
+    static void prefetch();
+    static const MarkerImage& get(ScatterShape shape);
+
+private:
+    static std::vector<MarkerImage> decodeAll();
+    static MarkerImage decode(const char* resourcePath);
+
+    static std::shared_future<std::vector<MarkerImage>>& decoded();
+    static std::mutex& decodedMutex();
+};
@@ -1,9 +1,12 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <numeric>
 #include <qfileinfo.h>
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
 
 #include "ScatterPlot.h"
+#include "ScatterMarkerImages.h"
 
 
 ScatterPlot::ScatterPlot(
@@ -25,17 +28,13 @@ ScatterPlot::ScatterPlot(
     m_linkedSubplot(subplot)
 {
     initializeAllBuffers();
-    setupTexture();
     m_instanceProgram.setupAndBindProgram();
 }
 
 
 ScatterPlot::~ScatterPlot()
 {
-    m_gl.glDeleteTextures(1, &m_circleTexture);
-    m_gl.glDeleteTextures(1, &m_triangleUpTexture);
-    m_gl.glDeleteTextures(1, &m_triangleDownTexture);
-    m_gl.glDeleteTextures(1, &m_crossTexture);
+    m_gl.glDeleteTextures(1, &m_markerTexture);
 }
 
 void ScatterPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
@@ -46,43 +45,46 @@ void ScatterPlot::draw(glm::mat4& NDCMatrix, Camera& camera)
 
     m_instanceProgram.setUniform1f("xDelta", (float)m_linkedSubplot.jointPlotData().getDelta());
     m_instanceProgram.setUniformMatrix4fc("NDCMatrix", NDCMatrix);
-    m_instanceProgram.setUniform1f("offset", (float)camera.getLeft());
     m_instanceProgram.setUniform4f("color", m_scatterSettings.color);
     m_instanceProgram.setUniform1i("fixedSize", (int)m_scatterSettings.fixedSize);
     m_instanceProgram.setUniform1f("markerSizeFixed", m_scatterSettings.markerSizeFixed);
     m_instanceProgram.setUniform1f("markerSizeFree", m_scatterSettings.markerSizeFree);
     m_instanceProgram.setUniform1f("aspectRatio", camera.getAspectRatio());
 
-    m_allDataVAO.bind();
-    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_allDataVBO);
-    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_quadInstanceVBO);
+    // Only draw the markers in view. The markers are sorted by x-index so the
+    // visible range can be found by binary search. The margin covers markers
+    // that are centered out of view but are large enough to overlap it.
+    double delta = m_linkedSubplot.jointPlotData().getDelta();
+    double fixedSizeMargin = m_scatterSettings.markerSizeFixed * camera.getViewWidth() / 2.0 / delta;
+    std::size_t margin = (std::size_t)std::ceil(std::max(m_scatterSettings.markerSizeFree, fixedSizeMargin)) + 1;
 
-    m_gl.glActiveTexture(GL_TEXTURE1);
+    VisibleIndexRange visibleRange = visibleIndexRange(camera, delta, m_linkedSubplot.jointPlotData().getNumDatapoints(), margin);
 
-    ScatterShape shape = m_scatterSettings.shape;
-    if (shape == ScatterShape::circle)
-    {
-        m_gl.glBindTexture(GL_TEXTURE_2D, m_circleTexture);
-    }
-    else if (shape == ScatterShape::triangleUp)
-    {
-        m_gl.glBindTexture(GL_TEXTURE_2D, m_triangleUpTexture);
-    }
-    else if (shape == ScatterShape::triangleDown)
-    {
-        m_gl.glBindTexture(GL_TEXTURE_2D, m_triangleDownTexture);
-    }
-    else if (shape == ScatterShape::cross)
+    std::size_t firstInstance = std::lower_bound(m_sortedXData.begin(), m_sortedXData.end(), (int)visibleRange.startIdx) - m_sortedXData.begin();
+    std::size_t endInstance = std::lower_bound(m_sortedXData.begin(), m_sortedXData.end(), (int)visibleRange.endIdx) - m_sortedXData.begin();
+
+    // The marker x positions are computed in the shader relative to the first index
+    // in view, and the offset relative to it here in double, so both stay small.
+    m_instanceProgram.setUniform1i("indexOrigin", (int)visibleRange.startIdx);
+    m_instanceProgram.setUniform1f("offset", (float)(camera.getLeft() - delta * (double)visibleRange.startIdx));
+
+    m_allDataVAO.bind();
+
+    if (firstInstance != m_boundFirstInstance)
     {
-        m_gl.glBindTexture(GL_TEXTURE_2D, m_crossTexture);
+        bindMarkerAttributes(firstInstance);
     }
-    else
+
+    if (m_markerTexture == 0)
     {
-        std::cerr << "CRITICAL ERROR: `shape` " << utils_scatterShapeEnumToStr(shape) << " not recognised. This should be caught further up." << std::endl;
-        std::exit(EXIT_FAILURE);
+        setupTexture();
     }
+
+    m_gl.glActiveTexture(GL_TEXTURE1);
+    m_gl.glBindTexture(GL_TEXTURE_2D, m_markerTexture);
+
     m_instanceProgram.setUniform1i("shapeTexture", 1);
-    m_gl.glDrawArraysInstanced(GL_TRIANGLES, 0, 6, m_plotData.getYData().size());
+    m_gl.glDrawArraysInstanced(GL_TRIANGLES, 0, 6, endInstance - firstInstance);
 
     m_gl.glDisable(GL_DEPTH_TEST);
 
@@ -100,26 +102,33 @@ void ScatterPlot::initializeAllBuffers()
     const StdPtrVector<float>& yData = m_plotData.getYData();
 
     // Annoying to have to copy here... I wonder if there is any way around it...
-    std::vector<float> interleavedData(xData.size() * 2 + 1);
+    std::vector<MarkerVertex> interleavedData(xData.size() + 1);
 
-    double delta = m_linkedSubplot.jointPlotData().getDelta();
+    // Sort the markers by x-index, so only the markers in view can be drawn
+    std::vector<std::size_t> order(xData.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&xData](std::size_t a, std::size_t b) { return xData[a] < xData[b]; });
+
+    m_sortedXData.resize(xData.size());
 
     for (int i = 0; i < xData.size(); i++)
     {
-        interleavedData[i * 2] = (float)(delta * xData[i]);
-        interleavedData[i * 2 + 1] = yData[i];
+        m_sortedXData[i] = xData[order[i]];
+        interleavedData[i] = MarkerVertex{xData[order[i]], yData[order[i]]};
     }
 
     m_gl.glBufferData(
         GL_ARRAY_BUFFER,
-        interleavedData.size() * sizeof(float),
+        interleavedData.size() * sizeof(MarkerVertex),
         interleavedData.data(),
         GL_STATIC_DRAW
     );
 
-    m_gl.glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    bindMarkerAttributes(0);
     m_gl.glEnableVertexAttribArray(0);
     m_gl.glVertexAttribDivisor(0, 1);
+    m_gl.glEnableVertexAttribArray(2);
+    m_gl.glVertexAttribDivisor(2, 1);
 
     // The instance
     m_gl.glGenBuffers(1, &m_quadInstanceVBO);
@@ -135,66 +144,50 @@ void ScatterPlot::initializeAllBuffers()
 }
 
 
-void ScatterPlot::setupTexture()
+void ScatterPlot::bindMarkerAttributes(std::size_t firstInstance)
+/*
+    Point the marker attributes (x-index, y) at the marker `firstInstance`,
+    as there is no base instance in OpenGL 3.3. The x-index is an integer
+    attribute, and must be bound with glVertexAttribIPointer. The marker
+    VAO must be bound.
+*/
 {
-    m_gl.glGenTextures(1, &m_circleTexture);
-    m_gl.glBindTexture(GL_TEXTURE_2D, m_circleTexture);
-    loadTexture(":/scatterTexture/charts/plots/textures/circle.png");
-
-    m_gl.glGenTextures(1, &m_triangleUpTexture);
-    m_gl.glBindTexture(GL_TEXTURE_2D, m_triangleUpTexture);
-    loadTexture(":/scatterTexture/charts/plots/textures/triangle_up.png");
+    m_gl.glBindBuffer(GL_ARRAY_BUFFER, m_allDataVBO);
 
-    m_gl.glGenTextures(1, &m_triangleDownTexture);
-    m_gl.glBindTexture(GL_TEXTURE_2D, m_triangleDownTexture);
-    loadTexture(":/scatterTexture/charts/plots/textures/triangle_down.png");
+    std::size_t firstByte = firstInstance * sizeof(MarkerVertex);
 
-    m_gl.glGenTextures(1, &m_crossTexture);
-    m_gl.glBindTexture(GL_TEXTURE_2D, m_crossTexture);
-    loadTexture(":/scatterTexture/charts/plots/textures/cross.png");
+    m_gl.glVertexAttribIPointer(0, 1, GL_INT, sizeof(MarkerVertex), (void*)(firstByte + offsetof(MarkerVertex, xIndex)));
+    m_gl.glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(MarkerVertex), (void*)(firstByte + offsetof(MarkerVertex, y)));
 
-    // this must be turned off for Qt QPainter to work
-    // properly over OpenGl widget.
-    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    m_boundFirstInstance = firstInstance;
 }
 
 
-void ScatterPlot::loadTexture(std::string fileName)
+void ScatterPlot::setupTexture()
+/*
+    Upload the texture of the marker shape, on first draw. The image
+    is decoded on a worker thread (see ScatterMarkerImages).
+*/
 {
-    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    QFile file(QString::fromStdString(fileName));
+    ScatterShape shape = m_scatterSettings.shape;
 
-    if (!file.open(QIODevice::ReadOnly))
+    if (!(shape == ScatterShape::circle || shape == ScatterShape::triangleUp || shape == ScatterShape::triangleDown || shape == ScatterShape::cross))
     {
-        std::cerr << "CRITICAL ERROR: Failed to open resource file: " << fileName << std::endl;
+        std::cerr << "CRITICAL ERROR: `shape` " << utils_scatterShapeEnumToStr(shape) << " not recognised. This should be caught further up." << std::endl;
         std::exit(EXIT_FAILURE);
     }
 
-    QByteArray imageData = file.readAll();
-    file.close();
-
-    stbi_set_flip_vertically_on_load(true);
+    const MarkerImage& image = ScatterMarkerImages::get(shape);
 
-    int width, height, numChannels;
-    unsigned char* data = stbi_load_from_memory(
-        reinterpret_cast<const unsigned char*>(imageData.constData()),
-        imageData.size(),
-        &width,
-        &height,
-        &numChannels,
-        4
-    );
+    m_gl.glGenTextures(1, &m_markerTexture);
+    m_gl.glBindTexture(GL_TEXTURE_2D, m_markerTexture);
 
-    if (!data)
-    {
-        std::cerr << "CRITICAL ERROR: Failed to load png texture." << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-
-    m_gl.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    m_gl.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
 
-    stbi_image_free(data);
+    // this must be turned off for Qt QPainter to work
+    // properly over OpenGl widget.
+    m_gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
     m_gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     m_gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -26,11 +26,10 @@ public:
     ~ScatterPlot();
 
     void draw(glm::mat4& NDCMatrix, Camera& camera) override;
+    ProfileStage profileStage() const override { return ProfileStage::scatterPlot; };
 
     const ScatterplotData& getPlotData() const override { return m_plotData; }
 
-    void setupTexture();
-
     PlotColor getPlotColor()const override { return  PlotColor{m_scatterSettings.color}; };
 
 
@@ -42,17 +41,29 @@ private:
     ScatterplotData m_plotData;
 
     void initializeAllBuffers();
-    void loadTexture(std::string fileName);
+    void setupTexture();
+
+    // A marker, the integer x-index is uploaded rather than the float x
+    // position so it is exact for any number of datapoints (see draw()).
+    struct MarkerVertex
+    {
+        int xIndex;
+        float y;
+    };
+
+    void bindMarkerAttributes(std::size_t firstInstance);
 
     unsigned int m_allDataVBO;
     VertexArrayObject m_allDataVAO;
 
+    // The x-index of each marker, in the (sorted) order they are in m_allDataVBO.
+    // Used to find the markers in view, see draw().
+    std::vector<int> m_sortedXData;
+    std::size_t m_boundFirstInstance = 0;
+
     LinkedSubplot& m_linkedSubplot;
 
-    unsigned int m_circleTexture = 0;
-    unsigned int m_triangleUpTexture = 0;
-    unsigned int m_triangleDownTexture = 0;
-    unsigned int m_crossTexture = 0;
+    unsigned int m_markerTexture = 0;  // of m_scatterSettings.shape, created on first draw
 
     unsigned int m_quadInstanceVBO;
 
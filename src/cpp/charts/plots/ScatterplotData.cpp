@@ -30,6 +30,14 @@ ScatterplotData::ScatterplotData(
 
         m_xData = StdPtrVector<int>(m_heldXData.data(), m_heldXData.size());
     }
+    else if (std::holds_alternative<EpochNsVector>(xData))
+    {
+        m_heldXData = sharedXData.convertDateToIndex(
+            std::get<EpochNsVector>(xData)
+            );
+
+        m_xData = StdPtrVector<int>(m_heldXData.data(), m_heldXData.size());
+    }
     m_hashedX = std::unordered_set<int>(m_xData.begin(), m_xData.end());
 };
 
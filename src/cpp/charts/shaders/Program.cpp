@@ -1,7 +1,6 @@
 #include <iostream>
 #include <gtc/type_ptr.hpp>
 #include "Program.h"
-#include "Shaders.h"
 
 
 Program::Program(std::string vertexShaderPath, std::string fragmentShaderPath, std::string geometryShaderPath, QOpenGLFunctions_3_3_Core& glFunctions)
@@ -23,65 +22,27 @@ Program::~Program()
 
 
 void Program::setupAndBindProgram()
-// Setup a program by linking together vertex and fragment shaders.
-// Note this links the inputs / outputs, so output of vertex shader
-// will be passed to inputs of fragment shader.
+/*
+    Get the linked program for the shaders (compiled only if this is
+    the first Program on the context to use them, see ProgramCache).
+ */
 {
-	// Initialise the shader objects and compile the shaders
-    Shader vshad(GL_VERTEX_SHADER, m_vertexShaderPath, m_gl);
-    Shader fshad(GL_FRAGMENT_SHADER, m_fragmentShaderPath, m_gl);
-
-	vshad.compileShader();
-	fshad.compileShader();
-
-	// Create thre program and link the shaders to it.
-    m_programID = m_gl.glCreateProgram();
-
-    m_gl.glAttachShader(m_programID, vshad.getId());
-    m_gl.glAttachShader(m_programID, fshad.getId());
-
-
-    bool hasGeometryShader = m_geometryShaderPath != "";
-
-    if (hasGeometryShader)
-    {
-        Shader gshad(GL_GEOMETRY_SHADER, m_geometryShaderPath, m_gl);
-        gshad.compileShader();
-        m_gl.glAttachShader(m_programID, gshad.getId());
-
-        m_gl.glLinkProgram(m_programID);
-        gshad.deleteShader();
-    }
-    else
-    {
-        m_gl.glLinkProgram(m_programID);
-    }
-
-	vshad.deleteShader(); 
-	fshad.deleteShader();
-
-    // Check the shaders were linked sucessfully
-	int sucess;
-    m_gl.glGetProgramiv(m_programID, GL_LINK_STATUS, &sucess);
-	char infoLog[512];
-	if (!sucess)
-	{
-        m_gl.glGetProgramInfoLog(m_programID, 512, NULL, infoLog);
-		std::cout << "ERROR IN PROGRAM LINKING: " << infoLog << std::endl;
-		return;
-	}
+    m_linkedProgram = ProgramCache::getProgram(m_vertexShaderPath, m_fragmentShaderPath, m_geometryShaderPath, m_gl);
+    m_programID = m_linkedProgram->getId();
+    m_uniformLocations.clear();
 
 	bind();
 }
 
 
 void Program::teardownProgram()
+/*
+    Release the shared program, it is deleted once no Program uses it.
+ */
 {
-	if (m_programID != 0)
-	{
-        m_gl.glDeleteProgram(m_programID);
-		m_programID = 0;
-	}
+    m_linkedProgram.reset();
+    m_programID = 0;
+    m_uniformLocations.clear();
 }
 
 
@@ -97,37 +58,60 @@ void Program::unBind()
 }
 
 
-void Program::setUniform4f(const std::string& uniformName, glm::vec4 value)  // TODO: factor out glGetUniformLocation like cherno!
+int Program::uniformLocation(const char* uniformName)
+/*
+    Uniform names are string literals, so the location is cached by the
+    address of the name. There are only a handful of uniforms per program,
+    so a linear search is faster than hashing.
+ */
 {
-    int location = m_gl.glGetUniformLocation(m_programID, uniformName.c_str());
-    m_gl.glUniform4f(location, value[0], value[1], value[2], value[3]);
+    for (const std::pair<const char*, int>& entry : m_uniformLocations)
+    {
+        if (entry.first == uniformName)
+        {
+            return entry.second;
+        }
+    }
+
+    int location = m_linkedProgram->uniformLocation(uniformName);
+    m_uniformLocations.emplace_back(uniformName, location);
+
+    return location;
 }
 
 
-void Program::setUniform3f(const std::string& uniformName, glm::vec3 value)
+void Program::setUniform4f(const char* uniformName, glm::vec4 value)
 {
-    int location = m_gl.glGetUniformLocation(m_programID, uniformName.c_str());
-    m_gl.glUniform3f(location, value[0], value[1], value[2]);
+    m_gl.glUniform4f(uniformLocation(uniformName), value[0], value[1], value[2], value[3]);
 }
 
 
-void Program::setUniform1i(const std::string& uniformName, int value)
+void Program::setUniform3f(const char* uniformName, glm::vec3 value)
 {
-    int location = m_gl.glGetUniformLocation(m_programID, uniformName.c_str());
-    m_gl.glUniform1i(location, value);
+    m_gl.glUniform3f(uniformLocation(uniformName), value[0], value[1], value[2]);
 }
 
 
-void Program::setUniform1f(const std::string& uniformName, float value)
+void Program::setUniform2f(const char* uniformName, glm::vec2 value)
 {
-    int location = m_gl.glGetUniformLocation(m_programID, uniformName.c_str());
-    m_gl.glUniform1f(location, value);
+    m_gl.glUniform2f(uniformLocation(uniformName), value[0], value[1]);
 }
 
 
-void Program::setUniformMatrix4fc(const std::string& uniformName, glm::mat4 value)
+void Program::setUniform1i(const char* uniformName, int value)
+{
+    m_gl.glUniform1i(uniformLocation(uniformName), value);
+}
+
+
+void Program::setUniform1f(const char* uniformName, float value)
+{
+    m_gl.glUniform1f(uniformLocation(uniformName), value);
+}
+
+
+void Program::setUniformMatrix4fc(const char* uniformName, glm::mat4 value)
 // requires pointer to ensure glm matrix is in form openGL can handle.
 {
-    int location = m_gl.glGetUniformLocation(m_programID, uniformName.c_str());
-    m_gl.glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
-;}
+    m_gl.glUniformMatrix4fv(uniformLocation(uniformName), 1, GL_FALSE, glm::value_ptr(value));
+}
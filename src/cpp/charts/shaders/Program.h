@@ -1,10 +1,23 @@
 #pragma once
 
+#include <memory>
+#include <utility>
+#include <vector>
 #include <QOpenGLFunctions_3_3_Core>
 #include <glm.hpp>
+#include "ProgramCache.h"
 
 
 class Program
+/*
+    A shader program used by a plot or chart object. The compiled program is
+    shared with all other `Program` on the context with the same shaders
+    (see ProgramCache), so this only holds the uniform locations in use.
+
+    All uniforms must be set before each draw, as other objects may have set
+    them on the shared program. Uniform names must be string literals, their
+    locations are cached by address so no lookup by string is done per frame.
+ */
 {
 public:
     Program(std::string vertexShaderPath, std::string fragmentShaderPath, std::string geometryShaderPath, QOpenGLFunctions_3_3_Core& glFunctions);
@@ -17,16 +30,22 @@ public:
 	void bind();
 	void unBind();
 
-	void setUniform4f(const std::string& uniformName, glm::vec4 value);
-	void setUniform3f(const std::string& uniformName, glm::vec3 value);
-	void setUniform1i(const std::string& uniformName, int value);
-	void setUniformMatrix4fc(const std::string& uniformName, glm::mat4 value);
-	void setUniform1f(const std::string& uniformName, float value);
+	void setUniform4f(const char* uniformName, glm::vec4 value);
+	void setUniform3f(const char* uniformName, glm::vec3 value);
+	void setUniform2f(const char* uniformName, glm::vec2 value);
+	void setUniform1i(const char* uniformName, int value);
+	void setUniformMatrix4fc(const char* uniformName, glm::mat4 value);
+	void setUniform1f(const char* uniformName, float value);
 
 	unsigned int getId() const { return m_programID; };
 
 private:
+	int uniformLocation(const char* uniformName);
+
 	unsigned int m_programID = 0;
+	std::shared_ptr<LinkedProgram> m_linkedProgram;
+	std::vector<std::pair<const char*, int>> m_uniformLocations;  // (name literal, location)
+
 	std::string m_vertexShaderPath;
 	std::string m_fragmentShaderPath;
     std::string m_geometryShaderPath = "";  // TODO: probably a better way to do this rather than overloading!!
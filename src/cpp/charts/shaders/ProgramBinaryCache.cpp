@@ -0,0 +1,235 @@
+#include <cstdio>
+#include <cstring>
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include "ProgramBinaryCache.h"
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+
+namespace
+{
+    // File layout: magic, file version, binary format (GLenum), program binary
+    constexpr char fileMagic[4] = {'R', 'P', 'P', 'B'};
+    constexpr std::uint32_t fileVersion = 1;
+    constexpr int headerSize = sizeof(fileMagic) + 2 * sizeof(std::uint32_t);
+
+    std::uint64_t fnv1a(std::uint64_t hash, const std::string& text)
+    {
+        for (unsigned char c : text)
+        {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        // Separator, so ("ab", "c") and ("a", "bc") differ
+        hash ^= 0xFF;
+        hash *= 1099511628211ULL;
+
+        return hash;
+    }
+}
+
+
+ProgramBinaryCache::ProgramBinaryCache(const std::string& directory, QOpenGLFunctions_3_3_Core& glFunctions)
+/*
+    Binaries are only used if a directory is set, the extension is exposed
+    (or core, OpenGL 4.1+) and the driver has at least one binary format.
+ */
+    : m_directory(directory), m_gl(glFunctions)
+{
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+
+    if (m_directory.empty() || context == nullptr)
+    {
+        return;
+    }
+
+    QPair<int, int> version = context->format().version();
+    bool isCore = version >= qMakePair(4, 1);
+
+    if (!isCore && !context->hasExtension("GL_ARB_get_program_binary"))
+    {
+        return;
+    }
+
+    int numFormats = 0;
+    m_gl.glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+    m_extraFunctions = context->extraFunctions();
+    m_enabled = numFormats > 0 && m_extraFunctions != nullptr;
+}
+
+
+std::string ProgramBinaryCache::defaultDirectory()
+/*
+    `rallyplot/program_binaries` in the user cache directory,
+    e.g. ~/.cache/rallyplot/program_binaries on Linux.
+ */
+{
+    QString cacheRoot = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+
+    if (cacheRoot.isEmpty())
+    {
+        return "";
+    }
+    return QDir(cacheRoot).filePath("rallyplot/program_binaries").toStdString();
+}
+
+
+std::string ProgramBinaryCache::makeKey(const std::vector<std::string>& shaderSources)
+/*
+    64-bit FNV-1a hash (as hex) of the driver strings and the
+    shader sources. std::hash is not stable between builds.
+ */
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION})
+    {
+        const GLubyte* driverString = m_gl.glGetString(name);
+        hash = fnv1a(hash, driverString ? reinterpret_cast<const char*>(driverString) : "");
+    }
+
+    for (const std::string& source : shaderSources)
+    {
+        hash = fnv1a(hash, source);
+    }
+
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", (unsigned long long)hash);
+
+    return std::string(key);
+}
+
+
+void ProgramBinaryCache::setRetrievableHint(unsigned int programID)
+/*
+    Must be set before the program is linked from source,
+    some drivers do not keep the binary otherwise.
+ */
+{
+    if (m_enabled)
+    {
+        m_extraFunctions->glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+
+bool ProgramBinaryCache::load(unsigned int programID, const std::string& key)
+/*
+    Load the cached binary into the (empty) program. Returns `true` if the
+    program is linked, otherwise it must be linked from source.
+ */
+{
+    if (!m_enabled)
+    {
+        return false;
+    }
+
+    QFile file(QString::fromStdString(filePath(key)));
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    QByteArray contents = file.readAll();
+    file.close();
+
+    if (contents.size() <= headerSize || std::memcmp(contents.constData(), fileMagic, sizeof(fileMagic)) != 0)
+    {
+        return false;
+    }
+
+    std::uint32_t version, binaryFormat;
+    std::memcpy(&version, contents.constData() + sizeof(fileMagic), sizeof(version));
+    std::memcpy(&binaryFormat, contents.constData() + sizeof(fileMagic) + sizeof(version), sizeof(binaryFormat));
+
+    if (version != fileVersion)
+    {
+        return false;
+    }
+
+    m_extraFunctions->glProgramBinary(programID, (GLenum)binaryFormat, contents.constData() + headerSize, (GLsizei)(contents.size() - headerSize));
+
+    // The driver may reject the binary (e.g. after an update), this is not an error
+    int linked = 0;
+    m_gl.glGetProgramiv(programID, GL_LINK_STATUS, &linked);
+
+    if (!linked)
+    {
+        while (m_gl.glGetError() != GL_NO_ERROR) {}
+    }
+
+    return linked != 0;
+}
+
+
+void ProgramBinaryCache::store(unsigned int programID, const std::string& key)
+/*
+    Write the binary of the linked program. Written atomically (QSaveFile), so
+    other processes starting at the same time never read a partial file.
+    Failures are ignored, the program is compiled from source next time.
+ */
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    int length = 0;
+    m_gl.glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+    {
+        return;
+    }
+
+    QByteArray contents(headerSize + length, Qt::Uninitialized);
+
+    GLsizei written = 0;
+    GLenum binaryFormat = 0;
+    m_extraFunctions->glGetProgramBinary(programID, length, &written, &binaryFormat, contents.data() + headerSize);
+
+    if (written <= 0)
+    {
+        return;
+    }
+    contents.resize(headerSize + written);
+
+    std::uint32_t format32 = binaryFormat;
+    std::memcpy(contents.data(), fileMagic, sizeof(fileMagic));
+    std::memcpy(contents.data() + sizeof(fileMagic), &fileVersion, sizeof(fileVersion));
+    std::memcpy(contents.data() + sizeof(fileMagic) + sizeof(fileVersion), &format32, sizeof(format32));
+
+    if (!QDir().mkpath(QString::fromStdString(m_directory)))
+    {
+        return;
+    }
+
+    QSaveFile file(QString::fromStdString(filePath(key)));
+
+    if (file.open(QIODevice::WriteOnly))
+    {
+        file.write(contents);
+        file.commit();
+    }
+}
+
+
+std::string ProgramBinaryCache::filePath(const std::string& key) const
+{
+    return QDir(QString::fromStdString(m_directory)).filePath(QString::fromStdString(key + ".bin")).toStdString();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLFunctions_3_3_Core>
+
+
+class ProgramBinaryCache
+/*
+    On-disk cache of linked program binaries (ARB_get_program_binary), so
+    shaders are compiled from source once per driver rather than on every
+    startup. Binaries are keyed by a hash of the shader sources and the
+    driver vendor / renderer / version strings, as they are only valid
+    for the driver that produced them.
+
+    Anything unexpected (the extension or binary formats are not supported,
+    a missing, stale or corrupt file, a binary the driver rejects) falls
+    back to compiling from source, and the binary is rewritten.
+
+    The directory is set per OpenGL context (see ProgramCache), an empty
+    directory disables the cache. Construct on the GUI thread with the
+    context current, entry points are resolved for that context.
+ */
+{
+
+public:
+    ProgramBinaryCache(const std::string& directory, QOpenGLFunctions_3_3_Core& glFunctions);
+
+    static std::string defaultDirectory();
+
+    bool isEnabled() const { return m_enabled; };
+
+    std::string makeKey(const std::vector<std::string>& shaderSources);
+
+    void setRetrievableHint(unsigned int programID);
+    bool load(unsigned int programID, const std::string& key);
+    void store(unsigned int programID, const std::string& key);
+
+private:
+    std::string filePath(const std::string& key) const;
+
+    std::string m_directory;
+    QOpenGLFunctions_3_3_Core& m_gl;
+    bool m_enabled = false;
+
+    // The program binary functions are not part of OpenGL 3.3, they are
+    // resolved by Qt from the context (only used if m_enabled)
+    QOpenGLExtraFunctions* m_extraFunctions = nullptr;
+};
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "ProgramCache.h"
+#include "ProgramBinaryCache.h"
+#include "Shaders.h"
+
+
+LinkedProgram::LinkedProgram(
+    const std::string& vertexShaderPath,
+    const std::string& fragmentShaderPath,
+    const std::string& geometryShaderPath,
+    const std::string& binaryCacheDirectory,
+    QOpenGLFunctions_3_3_Core& glFunctions
+)
+// Setup a program by linking together vertex and fragment shaders.
+// Note this links the inputs / outputs, so output of vertex shader
+// will be passed to inputs of fragment shader. If a binary of the
+// same program is in the ProgramBinaryCache it is used instead.
+    : m_gl(glFunctions)
+{
+    bool hasGeometryShader = geometryShaderPath != "";
+
+    std::string vertexSource = Shader::readShaderSource(vertexShaderPath);
+    std::string fragmentSource = Shader::readShaderSource(fragmentShaderPath);
+    std::string geometrySource = hasGeometryShader ? Shader::readShaderSource(geometryShaderPath) : "";
+
+    ProgramBinaryCache binaryCache(binaryCacheDirectory, m_gl);
+    std::string binaryKey;
+
+    if (binaryCache.isEnabled())
+    {
+        binaryKey = binaryCache.makeKey({vertexSource, fragmentSource, geometrySource});
+
+        m_programID = m_gl.glCreateProgram();
+
+        if (binaryCache.load(m_programID, binaryKey))
+        {
+            readUniformLocations();
+            return;
+        }
+
+        // A rejected binary may leave the program in any state, start again
+        m_gl.glDeleteProgram(m_programID);
+    }
+
+	// Initialise the shader objects and compile the shaders
+    Shader vshad(GL_VERTEX_SHADER, vertexShaderPath, m_gl);
+    Shader fshad(GL_FRAGMENT_SHADER, fragmentShaderPath, m_gl);
+
+	vshad.compileShader(vertexSource);
+	fshad.compileShader(fragmentSource);
+
+	// Create thre program and link the shaders to it.
+    m_programID = m_gl.glCreateProgram();
+    binaryCache.setRetrievableHint(m_programID);
+
+    m_gl.glAttachShader(m_programID, vshad.getId());
+    m_gl.glAttachShader(m_programID, fshad.getId());
+
+    if (hasGeometryShader)
+    {
+        Shader gshad(GL_GEOMETRY_SHADER, geometryShaderPath, m_gl);
+        gshad.compileShader(geometrySource);
+        m_gl.glAttachShader(m_programID, gshad.getId());
+
+        m_gl.glLinkProgram(m_programID);
+        gshad.deleteShader();
+    }
+    else
+    {
+        m_gl.glLinkProgram(m_programID);
+    }
+
+	vshad.deleteShader();
+	fshad.deleteShader();
+
+    // Check the shaders were linked sucessfully
+	int sucess;
+    m_gl.glGetProgramiv(m_programID, GL_LINK_STATUS, &sucess);
+	char infoLog[512];
+	if (!sucess)
+	{
+        m_gl.glGetProgramInfoLog(m_programID, 512, NULL, infoLog);
+		std::cout << "ERROR IN PROGRAM LINKING: " << infoLog << std::endl;
+		return;
+	}
+
+    binaryCache.store(m_programID, binaryKey);
+
+    readUniformLocations();
+}
+
+
+LinkedProgram::~LinkedProgram()
+{
+	if (m_programID != 0)
+	{
+        m_gl.glDeleteProgram(m_programID);
+		m_programID = 0;
+	}
+}
+
+
+void LinkedProgram::readUniformLocations()
+/*
+    Store the location of every active uniform, so they are never
+    queried from the driver while drawing. Uniforms that are not used by
+    the shaders are optimised out by the driver and are not stored.
+ */
+{
+    int numUniforms = 0;
+    int maxNameLength = 0;
+    m_gl.glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &numUniforms);
+    m_gl.glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::vector<char> name(std::max(maxNameLength, 1));
+
+    for (int i = 0; i < numUniforms; i++)
+    {
+        int nameLength = 0;
+        int size = 0;
+        GLenum type;
+        m_gl.glGetActiveUniform(m_programID, (GLuint)i, (GLsizei)name.size(), &nameLength, &size, &type, name.data());
+
+        std::string uniformName(name.data(), nameLength);
+        m_uniformLocations[uniformName] = m_gl.glGetUniformLocation(m_programID, uniformName.c_str());
+    }
+}
+
+
+int LinkedProgram::uniformLocation(const std::string& uniformName) const
+/*
+    Return the location of the uniform, or -1 if it is not used by the
+    shaders (setting location -1 is silently ignored by OpenGL).
+ */
+{
+    auto it = m_uniformLocations.find(uniformName);
+
+    return (it == m_uniformLocations.end()) ? -1 : it->second;
+}
+
+
+std::shared_ptr<LinkedProgram> ProgramCache::getProgram(
+    const std::string& vertexShaderPath,
+    const std::string& fragmentShaderPath,
+    const std::string& geometryShaderPath,
+    QOpenGLFunctions_3_3_Core& glFunctions
+)
+/*
+    Return the linked program for these shaders on this context,
+    compiling and linking it only if it does not exist yet.
+ */
+{
+    std::map<Key, std::weak_ptr<LinkedProgram>>& cache = programs();
+
+    Key key{&glFunctions, vertexShaderPath, fragmentShaderPath, geometryShaderPath};
+
+    std::shared_ptr<LinkedProgram> program = cache[key].lock();
+
+    if (!program)
+    {
+        eraseExpired();
+
+        program = std::make_shared<LinkedProgram>(
+            vertexShaderPath, fragmentShaderPath, geometryShaderPath, binaryCacheDirectories()[&glFunctions], glFunctions
+        );
+        cache[key] = program;
+    }
+
+    return program;
+}
+
+
+void ProgramCache::setBinaryCacheDirectory(QOpenGLFunctions_3_3_Core& glFunctions, const std::string& directory)
+/*
+    Set the ProgramBinaryCache directory for programs linked on this
+    context, an empty directory compiles them from source. Set before
+    any program is requested (see CentralOpenGlWidget::initializeGL()).
+ */
+{
+    binaryCacheDirectories()[&glFunctions] = directory;
+}
+
+
+void ProgramCache::releaseContext(QOpenGLFunctions_3_3_Core& glFunctions)
+/*
+    Erase all entries for this context when it is torn down. Programs
+    still held by plots are not deleted here, only forgotten by the cache.
+ */
+{
+    std::map<Key, std::weak_ptr<LinkedProgram>>& cache = programs();
+
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        it = (std::get<0>(it->first) == &glFunctions) ? cache.erase(it) : std::next(it);
+    }
+
+    binaryCacheDirectories().erase(&glFunctions);
+}
+
+
+void ProgramCache::eraseExpired()
+/*
+    Erase entries whose program has been deleted, so plots that are
+    added and removed over a long session do not grow the cache.
+ */
+{
+    std::map<Key, std::weak_ptr<LinkedProgram>>& cache = programs();
+
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        it = it->second.expired() ? cache.erase(it) : std::next(it);
+    }
+}
+
+
+std::map<ProgramCache::Key, std::weak_ptr<LinkedProgram>>& ProgramCache::programs()
+{
+    static std::map<Key, std::weak_ptr<LinkedProgram>> cache;
+    return cache;
+}
+
+
+std::map<QOpenGLFunctions_3_3_Core*, std::string>& ProgramCache::binaryCacheDirectories()
+{
+    static std::map<QOpenGLFunctions_3_3_Core*, std::string> directories;
+    return directories;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <QOpenGLFunctions_3_3_Core>
+
+
+class LinkedProgram
+/*
+    A compiled and linked OpenGL program, shared between all `Program`
+    objects with the same shaders (see ProgramCache). The locations of all
+    active uniforms are read once after linking.
+
+    Delete move and copy constructors to ensure
+    proper handling of resources.
+ */
+{
+
+public:
+    LinkedProgram(
+        const std::string& vertexShaderPath,
+        const std::string& fragmentShaderPath,
+        const std::string& geometryShaderPath,
+        const std::string& binaryCacheDirectory,
+        QOpenGLFunctions_3_3_Core& glFunctions
+    );
+    ~LinkedProgram();
+
+    LinkedProgram(const LinkedProgram&) = delete;
+    LinkedProgram& operator=(const LinkedProgram&) = delete;
+    LinkedProgram(LinkedProgram&&) = delete;
+    LinkedProgram& operator=(LinkedProgram&&) = delete;
+
+    unsigned int getId() const { return m_programID; };
+
+    int uniformLocation(const std::string& uniformName) const;
+
+private:
+    void readUniformLocations();
+
+    unsigned int m_programID = 0;
+    std::unordered_map<std::string, int> m_uniformLocations;
+    QOpenGLFunctions_3_3_Core& m_gl;
+};
+
+
+class ProgramCache
+/*
+    Context-wide cache of linked programs keyed by their shader files, so
+    each shader combination is compiled once per OpenGL context rather than
+    once per plot. The context is identified by its function object (one per
+    context, see CentralOpenGlWidget::initializeGL()).
+
+    Only weak references are held, a program is deleted when the last
+    `Program` using it is torn down (and recompiled if requested again).
+    All programs are used from the GUI thread only.
+
+    The directory of the on-disk ProgramBinaryCache is also per context,
+    so plotters with different cache settings do not affect each other.
+    A context's entries are erased when its widget is destroyed (see
+    `releaseContext`), so a later context at the same address starts empty.
+ */
+{
+
+public:
+    static std::shared_ptr<LinkedProgram> getProgram(
+        const std::string& vertexShaderPath,
+        const std::string& fragmentShaderPath,
+        const std::string& geometryShaderPath,
+        QOpenGLFunctions_3_3_Core& glFunctions
+    );
+
+    static void setBinaryCacheDirectory(QOpenGLFunctions_3_3_Core& glFunctions, const std::string& directory);
+    static void releaseContext(QOpenGLFunctions_3_3_Core& glFunctions);
+
+private:
+    using Key = std::tuple<QOpenGLFunctions_3_3_Core*, std::string, std::string, std::string>;
+
+    static std::map<Key, std::weak_ptr<LinkedProgram>>& programs();
+    static std::map<QOpenGLFunctions_3_3_Core*, std::string>& binaryCacheDirectories();
+    static void eraseExpired();
+};
@@ -21,7 +21,14 @@ Shader::~Shader()
 
 void Shader::compileShader()
 {
-    QString qrcFilename = QString::fromStdString(":/shaders/charts/shaders/shader_code/" + m_filepath);
+    compileShader(readShaderSource(m_filepath));
+}
+
+
+std::string Shader::readShaderSource(const std::string& filepath)
+// Read the shader source from the Qt resources (see resources.qrc).
+{
+    QString qrcFilename = QString::fromStdString(":/shaders/charts/shaders/shader_code/" + filepath);
 
     QFile file(qrcFilename);
 
@@ -33,8 +40,12 @@ void Shader::compileShader()
 
     QTextStream in(&file);
     QString fileContent = in.readAll();
-    std::string shaderSource = fileContent.toStdString();
+    return fileContent.toStdString();
+}
+
 
+void Shader::compileShader(const std::string& shaderSource)
+{
     const GLchar* shaderSourcePtr = shaderSource.c_str();
 
 	// create an empty shader object and return nonzero reference
@@ -22,8 +22,11 @@ public:
     Shader& operator=(Shader&&) = delete;
 
 	void compileShader();
+    void compileShader(const std::string& shaderSource);
 	void deleteShader();
 
+    static std::string readShaderSource(const std::string& filepath);
+
     unsigned int getId() const { return m_id; }
 
 private:
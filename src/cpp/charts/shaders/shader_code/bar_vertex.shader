@@ -17,7 +17,7 @@ uniform float widthRatio;
 
 void main()
 {
-        float xPosCenter = xDelta * gl_InstanceID;
+        float xPosCenter = xDelta * gl_InstanceID;  // relative to the first drawn bar
 
         float yPos = yData * barVertex.y  + minValue;
 
@@ -1,19 +1,21 @@
 #version 330 core
 /*
-    see CandleStickPlot.draw() for uniforms
+    see CandleStickPlot.draw() for uniforms and CandlestickData for the basis shapes
 */
-layout(location = 0) in vec2 BasisVertex;
+layout(location = 0) in vec4 BasisVertex;  // (x, y, part, pixel offset)
 
 layout(location = 1) in vec2 OpenClose;   // (Open, Close)
 layout(location = 2) in vec2 lowHigh;      // (Low, High)
 
 
 uniform float xDelta;
+uniform int firstVertex;  // first drawn vertex for the line modes, x is relative to this (the offset is too)
 
 uniform int drawMode;
 
 uniform mat4 NDCMatrix;
 uniform float offset;
+uniform vec2 pixelSize;  // size of a pixel in NDC
 
 uniform vec4 upColor;
 uniform vec4 downColor;
@@ -31,11 +33,11 @@ void main()
         float xPosCenter;
         if (drawMode == 4 || drawMode == 5)
         {
-            xPosCenter = xDelta * gl_VertexID;
+            xPosCenter = xDelta * float(gl_VertexID - firstVertex);
         }
         else
         {
-            xPosCenter = xDelta * gl_InstanceID;
+            xPosCenter = xDelta * gl_InstanceID;  // relative to the first drawn candle
         }
         float candleWidth = xDelta * candleWidthRatio;
         float capWidth = candleWidth * capWidthRatio;
@@ -45,11 +47,21 @@ void main()
 
         bool goingUp = (close > open);
 
+        // 0: body, 1: vertical line low / high, 2: cap, 3: vertical line open / close
+        int part = int(BasisVertex.z);
+
         float yPos;
         float xPos;
 
+        // line only (open: 4) or (close: 5)
+        if (drawMode == 4 || drawMode == 5)
+        {
+            xPos = xPosCenter - offset;
+            yPos = (drawMode == 4) ? open : close;
+        }
+
         // Candle body or vertical line extending open / close
-        if (drawMode == 0 || drawMode == 3)
+        else if (part == 0 || part == 3)
         {
             if (goingUp)
             {
@@ -61,26 +73,19 @@ void main()
             }
             xPos = xPosCenter - offset - (candleWidth / 2.0f) + (BasisVertex.x * candleWidth);
 
-            if (drawMode == 3)
+            if (part == 3)
             {
                 xPos += candleWidth * 0.5;
             }
         }
 
-        // line extending to low / high
-        else if (drawMode == 1 || drawMode == 2)
+        // line extending to low / high, or caps
+        else
         {
              yPos = (lowHigh.y - lowHigh.x) * BasisVertex.y + lowHigh.y;
              xPos = xPosCenter - offset + (BasisVertex.x * capWidth);
         }
 
-        // line only (open: 4) or (close: 5)
-        else if (drawMode == 4 || drawMode == 5)
-        {
-            xPos = xPosCenter - offset;
-            yPos = (drawMode == 4) ? open : close;
-        }
-
         if (goingUp)
         {
             Color = upColor;
@@ -92,8 +97,22 @@ void main()
 
         gl_Position = NDCMatrix * vec4(xPos, yPos, 0.0f, 1.0);  // TODO: RENAME!
 
+        // Widen the lines to one pixel, vertical lines along x and caps along y. This
+        // covers the same pixels as a 1 px GL_LINES line (and under multisampling,
+        // where lines are rasterized as 1 px wide rectangles, the same samples).
+        if (drawMode != 4 && drawMode != 5)
+        {
+            if (part == 1 || part == 3)
+            {
+                gl_Position.x += BasisVertex.w * pixelSize.x * gl_Position.w;
+            }
+            else if (part == 2)
+            {
+                gl_Position.y += BasisVertex.w * pixelSize.y * gl_Position.w;
+            }
+        }
+
         FragPos = gl_Position;
 
         vIndex = gl_VertexID;
 }
-
@@ -1,6 +1,6 @@
 #version 330 core
 
-in vec2 TexCoords;
+in vec2 TexCoords;  // in texels, see CharTextureAtlas
 out vec4 FragColor;
 
 uniform sampler2D text;
@@ -8,6 +8,6 @@ uniform vec4 fontColor;
 
 void main()
 {
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
+    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords / vec2(textureSize(text, 0))).r);
     FragColor = fontColor * sampled;
 }
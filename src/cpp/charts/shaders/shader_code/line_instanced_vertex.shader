@@ -0,0 +1,133 @@
+#version 330 core
+/*
+    Build one segment of a thick line with miter joints, see MiterLine. Each
+    instance is one segment, drawn as a 4-vertex triangle strip:
+    (start + miter, start - miter, end + miter, end - miter).
+
+    To compute the miter joints at each end of the segment, the tangent / normal
+    at the joint is computed. The length of the miter (along the normal) is computed
+    as the dot(normal, segmend end).
+
+    The vectors are first transformed to incorporate the aspect ratio, as this is
+    effected by the angle of the joints. Also, the width is adjusted with
+    yHeightProportion so that linewidth is uniform across subplots.
+
+    Because as the joint angle -> 0, miter length -> infinity, there needs
+    to be a hard cutoff after which a basic bevel joint is used. The related
+    constants (miterLimit, length of miter) and cosLimit (angle between vectors)
+    acheive this. The constants are based on visual inspection. The reason there
+    are two approaches is because when zooming, the angle and miter length changes
+    a lot and having both (slightly redundant) methods is more robust.
+
+    Data layouts (dataLayout uniform) of the points:
+
+    0 : (y), x is the point index (line plot)
+    1 : (y, x-index) decimated line plot, see LineMinMaxPyramid
+    2 : (open, close) candlestick line of the open prices, colored by up / down
+    3 : (open, close) candlestick line of the close prices, colored by up / down
+*/
+
+layout(location = 0) in vec2 PrevPoint;   // unused for the first point
+layout(location = 1) in vec2 StartPoint;
+layout(location = 2) in vec2 EndPoint;
+layout(location = 3) in vec2 NextPoint;   // unused for the last point
+
+uniform int dataLayout;
+
+uniform float xDelta;
+uniform int firstVertex;  // index of the start of the first drawn segment, x is relative to this (the offset is too)
+uniform int numVertices;
+
+uniform mat4 NDCMatrix;
+uniform float offset;
+
+uniform vec4 color;
+uniform vec4 upColor;
+uniform vec4 downColor;
+
+uniform float width;
+uniform float miterLimit;
+uniform float aspectRatio;
+uniform float yHeightProportion;
+uniform float subplotHeightProportion;
+
+out vec4 gColor;
+
+float correctedWidth = width * (1.0 / yHeightProportion) * (1.0f / subplotHeightProportion);
+float userMiterLimit = miterLimit;  // TODO: need to scale this by zoom!
+float maxLen = correctedWidth * 0.5 * userMiterLimit;
+float cosLimit = 1.0;
+float minMiterLenDivisor = 0.000000001f;
+
+
+vec2 aspectCorrected(vec2 v) {
+    return vec2(v.x * aspectRatio, v.y);
+}
+
+vec2 uncorrectAspect(vec2 v) {
+    return vec2(v.x / aspectRatio, v.y);
+}
+
+
+vec2 toNDC(vec2 point, int relativeIdx)
+// Position of a point, `relativeIdx` is its index relative to the segment start
+{
+    float xPosCenter = (dataLayout == 1) ? xDelta * point.y : xDelta * float(gl_InstanceID + relativeIdx);
+    float yPos = (dataLayout == 3) ? point.y : point.x;
+
+    return (NDCMatrix * vec4(xPosCenter - offset, yPos, 0.0f, 1.0)).xy;
+}
+
+
+vec2 normalTo(vec2 p0, vec2 p1)
+// Aspect-corrected normal of the segment p0 -> p1
+{
+    vec2 v = normalize(aspectCorrected(p1 - p0));
+    return vec2(-v.y, v.x);
+}
+
+
+void main()
+{
+    int startIdx = firstVertex + gl_InstanceID;
+
+    // There are no joints before the first or after the last point
+    bool hasPrev = startIdx > 0;
+    bool hasNext = startIdx + 2 < numVertices;
+
+    vec2 p0 = toNDC(StartPoint, 0);
+    vec2 p1 = toNDC(EndPoint, 1);
+
+    vec2 n1 = normalTo(p0, p1);
+    vec2 n0 = hasPrev ? normalTo(toNDC(PrevPoint, -1), p0) : n1;
+    vec2 n2 = hasNext ? normalTo(p1, toNDC(NextPoint, 2)) : n1;
+
+    // The sum of the normal vectors to the segment vectors
+    // gives the angle bisector at their joint.
+    bool atStart = (gl_VertexID < 2);
+
+    vec2 miter = atStart ? normalize(n0 + n1) : normalize(n1 + n2);
+
+    float cosAngle = abs(dot(miter, vec2(-n1.y, n1.x)));
+    float len = correctedWidth * 0.5 / max(dot(miter, n1), minMiterLenDivisor);
+
+    if (len > maxLen || cosAngle > cosLimit) {
+        miter = n1;
+        len = correctedWidth * 0.5;
+    }
+    vec2 miterOffset = uncorrectAspect(miter * len);
+
+    float side = (gl_VertexID % 2 == 0) ? 1.0 : -1.0;
+
+    gl_Position = vec4((atStart ? p0 : p1) + side * miterOffset, 0.0, 1.0);
+
+    if (dataLayout == 2 || dataLayout == 3)
+    {
+        vec2 openClose = atStart ? StartPoint : EndPoint;
+        gColor = (openClose.y > openClose.x) ? upColor : downColor;
+    }
+    else
+    {
+        gColor = color;
+    }
+}
@@ -1,8 +1,11 @@
 #version 330 core
 
 layout(location = 0) in float data;
+layout(location = 1) in float xIndex;  // only for the decimated line, see LinePlot::draw()
 
 uniform float xDelta;
+uniform int useXIndex;
+uniform int firstVertex;  // x is relative to the first drawn vertex (the offset is too)
 
 uniform mat4 NDCMatrix;
 uniform float offset;
@@ -17,7 +20,7 @@ uniform vec4 color;
 
 void main()
 {
-    float xPosCenter = xDelta * gl_VertexID;
+    float xPosCenter = (useXIndex == 1) ? xDelta * xIndex : xDelta * float(gl_VertexID - firstVertex);
 
     float xPos = xPosCenter - offset;
     float yPos = data;
@@ -2,10 +2,12 @@
 /*
 
 */
-layout(location = 0) in vec2 data;
+layout(location = 0) in int xIndex;
 layout(location = 1) in vec2 quadOffset;
+layout(location = 2) in float yData;
 
 uniform float xDelta;
+uniform int indexOrigin;  // x is relative to this index (the offset is too), see ScatterPlot::draw()
 
 uniform mat4 NDCMatrix;
 uniform float offset;
@@ -39,8 +41,8 @@ void main()
 
     yOffset *= aspectRatio;
 
-    float xPos = data.x - offset;
-    float yPos = data.y;
+    float xPos = xDelta * float(xIndex - indexOrigin) - offset;
+    float yPos = yData;
 
     gl_Position = NDCMatrix * vec4(xPos, yPos, 0.0f, 1.0f);
 
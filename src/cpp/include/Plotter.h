@@ -13,6 +13,8 @@
 #include <variant>
 #include <vector>
 #include <chrono>
+#include <cstdint>
+#include <atomic>
 
 
 // -------------------------------------------------------
@@ -22,17 +24,23 @@
 using StringVectorRef = std::reference_wrapper<const std::vector<std::string>>;
 using TimepointVectorRef = std::reference_wrapper<const std::vector<std::chrono::system_clock::time_point>>;
 
+// UTC datetimes as int64 nanoseconds since the Unix epoch (e.g. NumPy datetime64[ns]).
+// These are not copied, the array must outlive the plot.
+using EpochNsVector = StdPtrVector<std::int64_t>;
+
 
 using DateVector = std::variant<
     StringVectorRef,
-    TimepointVectorRef
+    TimepointVectorRef,
+    EpochNsVector
     >;
 
 
 using ScatterDateVector = std::variant<
     StdPtrVector<int>,
     StringVectorRef,
-    TimepointVectorRef
+    TimepointVectorRef,
+    EpochNsVector
     >;
 
 
@@ -108,7 +116,8 @@ struct CandleDataCSV
     std::vector<float> high;
     std::vector<float> low;
     std::vector<float> close;
-    std::vector<std::string> dates;
+    std::vector<std::string> dates;  ///< Date strings, if the "Date" column is not ISO-8601.
+    std::vector<std::int64_t> datesEpochNs;  ///< UTC dates as ns since the epoch, if the "Date" column is ISO-8601 and parsed (`dates` is then empty), see readCandleDataCSV().
 };
 
 
@@ -145,6 +154,25 @@ struct PlotterArgs
     /** Size of the margin between the x-axis and the bottom edge of the figure. */
     int heightMarginSize = 25;
 
+    /** If `true`, the figure is never displayed and is only rendered to images (see `renderToImage()`,
+        `savePng()`). Uses the "offscreen" Qt platform unless `QT_QPA_PLATFORM` is already set,
+        so no display server is required. `start()` cannot be called on a headless plotter. */
+    bool headless = false;
+
+    /** If `true`, the Qt event loop runs on a dedicated thread from construction, so the figure can be
+        displayed with `startAsync()` without blocking the caller. All Plotter calls are run on that thread
+        (the calling thread waits for each to finish). Closing the window hides it. Not supported on macOS,
+        where Qt must run on the main thread. */
+    bool uiThread = false;
+
+    /** If `true`, linked shader programs are stored on disk (where the driver supports program binaries)
+        and reused by later plotters and runs instead of compiling the shaders, which shortens startup. */
+    bool programBinaryCache = true;
+
+    /** Directory of the program binary cache. If empty, `rallyplot/program_binaries` in the user
+        cache directory is used (e.g. `~/.cache/rallyplot/program_binaries` on Linux). */
+    std::string programBinaryCacheDir = "";
+
 };
 
 
@@ -531,9 +559,6 @@ struct DrawLineSettings
     std::optional<std::vector<float>> color = std::nullopt;
 };
 
-// Plotter Class
-// -------------------------------------------------------
-
 #if defined(_WIN32) || defined(__CYGWIN__)
 #  ifdef RALLYPLOT_LIBRARY  // see CMakeLists.txt
 #    define RALLYPLOT_API __declspec(dllexport)
@@ -544,6 +569,262 @@ struct DrawLineSettings
 #  define RALLYPLOT_API             // not needed on Linux/macOS
 #endif
 
+// Candle Column File
+// -------------------------------------------------------
+
+/**
+ * @brief The float columns of a CandleColumnFile.
+ */
+enum class CandleColumn
+{
+    open,
+    high,
+    low,
+    close,
+    volume
+};
+
+
+/**
+ * @brief A memory-mapped columnar candle file (see writeCandleColumnFile()).
+ *
+ * The columns are stored as aligned little-endian arrays and are returned as
+ * views into the mapped file, without any copy or parse. Opening the file
+ * does not depend on its size, and only the pages that are read are loaded
+ * into memory.
+ *
+ * Each float column also stores a zone map, the min / max of every block
+ * of blockSize() rows (NaN ignored, +/- infinity for an all-NaN block).
+ * Plotting the file with Plotter::candlestick() uses the high / low zone maps
+ * to set up the y-axis range without scanning the data.
+ *
+ * The file must outlive any plot of its data.
+ */
+class RALLYPLOT_API CandleColumnFile
+{
+public:
+
+    /**
+     * @param filepath Path to a file written by writeCandleColumnFile().
+     */
+    explicit CandleColumnFile(const std::string& filepath);
+    ~CandleColumnFile();
+
+    CandleColumnFile(const CandleColumnFile&) = delete;
+    CandleColumnFile& operator=(const CandleColumnFile&) = delete;
+    CandleColumnFile(CandleColumnFile&&) = delete;
+    CandleColumnFile& operator=(CandleColumnFile&&) = delete;
+
+    /** Number of rows (candles). */
+    std::size_t size() const;
+
+    /** Number of rows summarised by each zone map entry. */
+    std::size_t blockSize() const;
+
+    /** True if the column is stored. Open, high, low and close are always stored. */
+    bool hasColumn(CandleColumn column) const;
+
+    /** True if the file stores dates. */
+    bool hasDates() const;
+
+    /** View of the column, throws if the column is not stored. */
+    StdPtrVector<float> column(CandleColumn column) const;
+
+    /** Min of each block of the column (the zone map), throws if the column is not stored. */
+    StdPtrVector<float> blockMin(CandleColumn column) const;
+
+    /** Max of each block of the column (the zone map), throws if the column is not stored. */
+    StdPtrVector<float> blockMax(CandleColumn column) const;
+
+    /** View of the dates (UTC, ns since the epoch), throws if the file stores no dates. */
+    EpochNsVector dates() const;
+
+private:
+
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+
+/**
+ * @brief Write candle data to a columnar candle file (see CandleColumnFile).
+ *
+ * @param filepath Path of the file to write, overwritten if it exists.
+ * @param open Candle open prices.
+ * @param high Candle high prices.
+ * @param low Candle low prices.
+ * @param close Candle close prices.
+ * @param volume Optional candle volumes.
+ * @param dates Optional dates (UTC, ns since the epoch).
+ */
+RALLYPLOT_API void writeCandleColumnFile(
+    const std::string& filepath,
+    const StdPtrVector<float>& open,
+    const StdPtrVector<float>& high,
+    const StdPtrVector<float>& low,
+    const StdPtrVector<float>& close,
+    std::optional<StdPtrVector<float>> volume = std::nullopt,
+    std::optional<EpochNsVector> dates = std::nullopt
+);
+
+
+// Candle Stream
+// -------------------------------------------------------
+
+/**
+ * @brief What a CandleStream does when its queue is full (the GUI
+ * thread is not draining as fast as candles are pushed).
+ */
+enum class BackpressurePolicy
+{
+    /** Discard the candle (counted in CandleStream::numDropped()). */
+    drop,
+    /** Keep the candle in an overflow buffer, merging overwrites of the last candle. The overflow holds
+        at most 2^22 appended candles, later candles are dropped (counted in CandleStream::numDropped()). */
+    merge,
+    /** Wait until the GUI thread has drained the queue. Throws if called from the GUI thread when the queue is full. */
+    block
+};
+
+
+/**
+ * @brief Settings for a CandleStream.
+ */
+struct CandleStreamSettings
+{
+    /** Behaviour when the queue is full. */
+    BackpressurePolicy backpressure = BackpressurePolicy::merge;
+};
+
+
+class UpdateQueue;
+
+
+/**
+ * @brief Feed candles to a candlestick plot from any thread (see Plotter::candleStream()).
+ *
+ * Candles are pushed to a lock-free queue that the GUI thread drains once per
+ * frame. All updates to the plot drained in a frame are applied together,
+ * so a high tick rate costs a single append per frame.
+ *
+ * Errors found when the candles are plotted (e.g. the plot was removed)
+ * cannot be raised to the calling thread and are printed.
+ */
+class RALLYPLOT_API CandleStream
+{
+public:
+
+    CandleStream(std::shared_ptr<UpdateQueue> queue, int seriesId, bool hasDates, CandleStreamSettings settings);
+
+    CandleStream(const CandleStream&) = delete;
+    CandleStream& operator=(const CandleStream&) = delete;
+    CandleStream(CandleStream&&) = delete;
+    CandleStream& operator=(CandleStream&&) = delete;
+
+    /**
+     * @brief Append a candle. Thread-safe.
+     *
+     * @param open Candle open price.
+     * @param high Candle high price.
+     * @param low Candle low price.
+     * @param close Candle close price.
+     * @param dateEpochNs Date of the candle (UTC, ns since the epoch). Must be passed if (and only if) the plot has dates.
+     */
+    void appendCandle(float open, float high, float low, float close, std::optional<std::int64_t> dateEpochNs = std::nullopt);
+
+    /**
+     * @brief Overwrite the most recent candle (e.g. a live, not yet closed, bar). Thread-safe.
+     *
+     * @param open New open price.
+     * @param high New high price.
+     * @param low New low price.
+     * @param close New close price.
+     */
+    void updateLastCandle(float open, float high, float low, float close);
+
+    /** Number of updates dropped because the queue was full (BackpressurePolicy::drop), the overflow
+        was full (BackpressurePolicy::merge) or the plot was closed. */
+    std::size_t numDropped() const;
+
+private:
+
+    std::shared_ptr<UpdateQueue> m_queue;
+    int m_seriesId;
+    bool m_hasDates;
+    CandleStreamSettings m_settings;
+    std::atomic<std::size_t> m_numDropped{0};
+};
+
+
+// Profiler
+// -------------------------------------------------------
+
+/**
+ * @brief Camera movements that can be scripted with Plotter::_moveCamera() (e.g. by the rendering benchmark).
+ */
+enum class CameraOperation
+{
+    /** Zoom the x-axis about the center of the view, `amount` is the scale factor (> 1 zooms in). */
+    zoomX,
+    /** Pan the x-axis as a left mouse drag of `amount` pixels. */
+    panX,
+    /** Scroll the mouse wheel at the center of the plot, `amount` is the wheel angle delta (120 per step, positive zooms in). */
+    wheelZoom
+};
+
+
+/**
+ * @brief Timings of one stage of the frame (e.g. tick labels, candlestick draws) over
+ * the recently profiled frames, see Plotter::enableProfiler().
+ */
+struct ProfilerStageStats
+{
+    /** Stage name: "frame", "plotLayer", "axes", "ticks", "tickLabels", "candlestickPlot", "linePlot",
+        "barPlot", "scatterPlot", "drawLines", "legend", "pinnedYLimits" or "overlays". */
+    std::string stage;
+    /** Number of profiled frames in which the stage was drawn (the percentiles are over these frames). */
+    std::size_t numFrames;
+    /** Median CPU time of the stage per frame, in milliseconds. */
+    double cpuP50Ms;
+    /** 95th percentile CPU time of the stage per frame, in milliseconds. */
+    double cpuP95Ms;
+    /** 99th percentile CPU time of the stage per frame, in milliseconds. */
+    double cpuP99Ms;
+    /** Median GPU time of the stage per frame, in milliseconds. */
+    double gpuP50Ms;
+    /** 95th percentile GPU time of the stage per frame, in milliseconds. */
+    double gpuP95Ms;
+    /** 99th percentile GPU time of the stage per frame, in milliseconds. */
+    double gpuP99Ms;
+};
+
+
+/**
+ * @brief Time from constructing the Plotter to the first frame, see Plotter::startupStats().
+ *
+ * All times are in milliseconds from the start of the Plotter's construction. Times
+ * not yet reached (e.g. no frame has been drawn) are NaN.
+ */
+struct StartupStats
+{
+    /** The QApplication is constructed. */
+    double applicationMs;
+    /** The window and OpenGL context are setup (the end of the Plotter's construction). */
+    double windowSetupMs;
+    /** The first frame has been drawn (time to first frame). Includes the plots added before it is shown. */
+    double firstFrameMs;
+    /** Time to draw the first frame (including the data uploaded to draw it). */
+    double firstFrameDrawMs;
+    /** Total time of the work deferred until after the first frame (e.g. uploading the LOD levels not yet drawn). */
+    double deferredWorkMs;
+    /** All deferred work is done. */
+    double deferredWorkDoneMs;
+};
+
+
+// Plotter Class
+// -------------------------------------------------------
+
 class RALLYPLOT_API Plotter
 /*
     Top-level class for plotting. Coordinate the plot window
@@ -572,9 +853,27 @@ public:
 
     /**
      * @brief Start the event loop to display and interact with plots.
+     *
+     * Blocks until the window is closed. If the Plotter was created with `PlotterArgs::uiThread`,
+     * the window is shown on the UI thread and this waits for it to be closed.
      */
     void start();
 
+    /**
+     * @brief Display the plots and return immediately, the event loop runs on the UI thread.
+     *
+     * Requires the Plotter to be created with `PlotterArgs::uiThread`. Plotter calls made
+     * afterwards (e.g. appendCandles()) update the displayed window. Can be called again
+     * to re-open the window once it is closed.
+     */
+    void startAsync();
+
+    /**
+     * @brief Whether the Plotter was created with `PlotterArgs::uiThread`, i.e. its
+     * event loop runs on a dedicated thread rather than the thread calling start().
+     */
+    bool hasUiThread() const;
+
     // Settings
     // ---------------------------------------------------------------------------------------------------------------
 
@@ -845,7 +1144,7 @@ public:
      * @param lowSize Size of the low prices array.
      * @param closePtr  Pointer to array of floats of close prices.
      * @param closeSize Size of the close prices array.
-     * @param dates Array of string or timepoints used as x-axis labels. If `nullopt`, integers starting at 0 are used.
+     * @param dates Array of string, timepoints or EpochNsVector (int64 ns since epoch, not copied) used as x-axis labels. If `nullopt`, integers starting at 0 are used.
      * @param candlestickSettings
      * @param linkedSubplotIdx The index of the linked subplot on which to plot the candlesticks. By default, it is the most recently added linked subplot.
      */
@@ -859,6 +1158,131 @@ public:
         int linkedSubplotIdx = -1
     );
 
+    /**
+     * @brief Add a candlestick plot of a columnar candle file.
+     *
+     * The columns are plotted directly from the mapped file, without a copy.
+     * The dates stored in the file (if any) are used as x-axis labels.
+     *
+     * @param file The candle file, must outlive the plot.
+     * @param candlestickSettings
+     * @param linkedSubplotIdx The index of the linked subplot on which to plot the candlesticks. By default, it is the most recently added linked subplot.
+     */
+    void candlestick(
+        const CandleColumnFile& file,
+        std::optional<CandlestickSettings> candlestickSettings = std::nullopt,
+        int linkedSubplotIdx = -1
+    );
+
+    /**
+     * @brief Append candles to an existing candlestick plot (e.g. from a live feed).
+     *
+     * The candlestick plot must be the only plot on the linked subplot. On the first
+     * append, the plot data is copied so the originally passed vectors no longer need to
+     * outlive the plot. Only the new candles are uploaded to the GPU.
+     *
+     * @param open Vector of candle open prices to append.
+     * @param high Vector of candle high prices to append.
+     * @param low Vector of candle low prices to append.
+     * @param close Vector of candle close prices to append.
+     * @param linkedSubplotIdx The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+     */
+    void appendCandles(
+        const std::vector<float>& open,
+        const std::vector<float>& high,
+        const std::vector<float>& low,
+        const std::vector<float>& close,
+        int linkedSubplotIdx = -1
+    );
+
+    /**
+     * @brief Append candles with string x-labels to an existing candlestick plot.
+     *
+     * @param open Vector of candle open prices to append.
+     * @param high Vector of candle high prices to append.
+     * @param low Vector of candle low prices to append.
+     * @param close Vector of candle close prices to append.
+     * @param dates Vector of strings for the new candles. The plot must already use string x-labels.
+     * @param linkedSubplotIdx The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+     */
+    void appendCandles(
+        const std::vector<float>& open,
+        const std::vector<float>& high,
+        const std::vector<float>& low,
+        const std::vector<float>& close,
+        const std::vector<std::string>& dates,
+        int linkedSubplotIdx = -1
+    );
+
+    /**
+     * @brief Append candles with UTC chrono-timepoints x-labels to an existing candlestick plot.
+     *
+     * @param open Vector of candle open prices to append.
+     * @param high Vector of candle high prices to append.
+     * @param low Vector of candle low prices to append.
+     * @param close Vector of candle close prices to append.
+     * @param dates Vector of chrono::timepoints (UTC) for the new candles. The plot must already use timepoint x-labels.
+     * @param linkedSubplotIdx The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+     */
+    void appendCandles(
+        const std::vector<float>& open,
+        const std::vector<float>& high,
+        const std::vector<float>& low,
+        const std::vector<float>& close,
+        const std::vector<std::chrono::system_clock::time_point>& dates,
+        int linkedSubplotIdx = -1
+    );
+
+    /**
+     * @brief Append candles to an existing candlestick plot.
+     *
+     * This is mostly for internal use and instead of std::vector<float>&
+     * takes pointers and size to such an array. The data is copied.
+     *
+     * @param openPtr Pointer to array of floats of open prices.
+     * @param highPtr Pointer to array of floats of high prices.
+     * @param lowPtr Pointer to array of floats of low prices.
+     * @param closePtr Pointer to array of floats of close prices.
+     * @param size Size of each of the arrays.
+     * @param dates Array of string or timepoints for the new candles. Must be passed if (and only if) the plot has dates.
+     * @param linkedSubplotIdx The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+     */
+    void appendCandles(
+        const float* openPtr,
+        const float* highPtr,
+        const float* lowPtr,
+        const float* closePtr,
+        std::size_t size,
+        const OptionalDateVector dates = std::nullopt,
+        int linkedSubplotIdx = -1
+    );
+
+    /**
+     * @brief Overwrite the most recent candle of a candlestick plot (e.g. a live, not yet closed, bar).
+     *
+     * @param open New open price.
+     * @param high New high price.
+     * @param low New low price.
+     * @param close New close price.
+     * @param linkedSubplotIdx The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+     */
+    void updateLastCandle(float open, float high, float low, float close, int linkedSubplotIdx = -1);
+
+    /**
+     * @brief Create a stream to feed candles to a candlestick plot from other threads.
+     *
+     * Must be called from the thread that created the Plotter. The candlestick plot must
+     * be the only plot on the linked subplot, and have no dates or timepoint dates.
+     *
+     * @param linkedSubplotIdx The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+     * @param streamSettings CandleStreamSettings struct.
+     * @return A thread-safe CandleStream, it may outlive the plot (later candles are dropped).
+     */
+    std::shared_ptr<CandleStream> candleStream(
+        int linkedSubplotIdx = -1,
+        std::optional<CandleStreamSettings> streamSettings = std::nullopt
+    );
+
     /**
      * @brief Add a line plot.
      *
@@ -893,7 +1317,7 @@ public:
      *
      * @param yPtr Pointer to a vector of floats to plot.
      * @param ySize Size of the float vector.
-     * @param dates string or chrono::timepoint (UTC) to use as x-tick labels. If `nullopt`, integers starting at 0 are used.
+     * @param dates string, chrono::timepoint (UTC) or EpochNsVector (int64 ns since epoch, not copied) to use as x-tick labels. If `nullopt`, integers starting at 0 are used.
      * @param lineSettings
      * @param linkedSubplotIdx The index of the linked subplot on which to plot the line plot. By default, it is the most recently added linked subplot.
      */
@@ -938,7 +1362,7 @@ public:
      *
      * @param yPtr Pointer to a vector of floats to plot.
      * @param ySize Size of the float vector.
-     * @param dates string or chrono::timepoint (UTC) to use as x-tick labels. If `nullopt`, integers starting at 0 are used.
+     * @param dates string, chrono::timepoint (UTC) or EpochNsVector (int64 ns since epoch, not copied) to use as x-tick labels. If `nullopt`, integers starting at 0 are used.
      * @param barSettings
      * @param linkedSubplotIdx The index of the linked subplot on which to plot the bar plot. By default, it is the most recently added linked subplot.
      */
@@ -955,7 +1379,7 @@ public:
      *
      * A scatter plot cannot be the first plot, it must be overlaid onto an existing plot.
      *
-     * @param xData A vector of chrono::time_point (UTC) of x-axis position of the scatter points. The type must match the current x tick label type.
+     * @param xData A vector of chrono::time_point (UTC) of x-axis position of the scatter points. The type must match the current x tick label type. Each is placed at the last x-axis date at or before it.
      * @param yData Vector of floats containing y-axis data. Must match xData in length.
      * @param scatterSettings
      * @param linkedSubplotIdx The index of the linked subplot on which to plot the scatter plot. By default, it is the most recently added linked subplot.
@@ -972,7 +1396,7 @@ public:
      *
      * A scatter plot cannot be the first plot, it must be overlaid onto an existing plot.
      *
-     * @param xData A vector of chrono::time_point (UTC) of x-axis position of the scatter points. The type must match the current x tick label type.
+     * @param xData A vector of chrono::time_point (UTC) of x-axis position of the scatter points. The type must match the current x tick label type. Each is placed at the last x-axis date at or before it.
      * @param yPtr Pointer to vector of floats containing y-axis data.
      * @param ySize Size of vector of floats yPtr points to. Must match xData in length.
      * @param scatterSettings
@@ -986,6 +1410,25 @@ public:
         int linkedSubplotIdx = -1
         );
 
+    /**
+     * @brief scatter
+     *
+     * A scatter plot cannot be the first plot, it must be overlaid onto an existing plot.
+     *
+     * @param xData UTC datetimes as int64 nanoseconds since the epoch (not copied) of x-axis position of the scatter points. The type must match the current x tick label type. Each is placed at the last x-axis date at or before it.
+     * @param yPtr Pointer to vector of floats containing y-axis data.
+     * @param ySize Size of vector of floats yPtr points to. Must match xData in length.
+     * @param scatterSettings
+     * @param linkedSubplotIdx The index of the linked subplot on which to plot the scatter plot. By default, it is the most recently added linked subplot.
+     */
+    void scatter(
+        const EpochNsVector& xData,
+        const float* yPtr,
+        std::size_t ySize,
+        std::optional<ScatterSettings> scatterSettings = std::nullopt,
+        int linkedSubplotIdx = -1
+        );
+
     /**
      * @brief scatter
      *
@@ -1070,21 +1513,128 @@ public:
      * @brief Read data from a csv file.
      *
      * Requires a .csv with "Open", "Close", "Low", "High" columns and optional "Date" column.
-     *
+     * Dates are returned as strings in `dates` (also if ISO-8601), see readCandleDataCSV().
      *
      * @param dataFilepath Path to the .csv file.
      */
     CandleDataCSV _readDataFromCSV(const std::string& dataFilepath) const;
 
+    /**
+     * @brief Render the whole figure (all subplots) offscreen to an image.
+     *
+     * The figure is laid out at the requested size for the render only,
+     * the window size is not changed. Works in headless mode.
+     *
+     * @param width Image width in pixels.
+     * @param height Image height in pixels.
+     * @param dpi Resolution stored in the image metadata (does not change the rendering).
+     * @return Tuple of (RGBA8888 pixel buffer, row-major from the top row, width, height).
+     */
+    std::tuple<std::vector<std::uint8_t>, int, int> renderToImage(int width, int height, int dpi = 96);
+
+    /**
+     * @brief Render the whole figure offscreen and save it as a .png file.
+     *
+     * @param filepath Path to the output .png file.
+     * @param width Image width in pixels. If `nullopt`, the current window width is used.
+     * @param height Image height in pixels. If `nullopt`, the current window height is used.
+     * @param dpi Resolution stored in the .png metadata.
+     */
+    void savePng(
+        const std::string& filepath,
+        std::optional<int> width = std::nullopt,
+        std::optional<int> height = std::nullopt,
+        int dpi = 96
+    );
+
+    /**
+     * @brief Record the CPU and GPU time of each stage of every frame drawn (all subplots).
+     *
+     * The last 512 frames drawn by each subplot are kept, see profilerStats() and
+     * saveProfilerTrace(). Enabling clears the previously recorded frames. GPU times
+     * are read a few frames after they are drawn, so the most recent frames may not
+     * be included yet. When disabled (the default), the profiler has no measurable cost.
+     *
+     * @param enabled If `true` frames are recorded, otherwise recording is stopped (the recorded frames are kept).
+     */
+    void enableProfiler(bool enabled = true);
+
+    /**
+     * @brief p50 / p95 / p99 per-frame CPU and GPU time of each stage, for the active subplot.
+     *
+     * Only stages drawn in at least one recorded frame are returned. The "frame" stage is the whole
+     * frame. Stages drawn more than once per frame (e.g. the axes of each linked subplot) are summed.
+     */
+    std::vector<ProfilerStageStats> profilerStats();
+
+    /**
+     * @brief Time to first frame of the Plotter, from its construction (see StartupStats).
+     *
+     * Work not needed to draw the first frame is done after it is shown, when the window
+     * is idle. The first frame of the last window shown is reported, or (headless) the
+     * first frame rendered.
+     */
+    StartupStats startupStats();
+
+    /**
+     * @brief Save the recorded frames of the active subplot in the Chrome trace event format.
+     *
+     * The .json file can be opened in chrome://tracing or https://ui.perfetto.dev. CPU
+     * stages are shown on the "CPU" thread and GPU stages on the "GPU" thread.
+     *
+     * @param filepath Path to the output .json file.
+     */
+    void saveProfilerTrace(const std::string& filepath);
+
     std::tuple<std::vector<std::uint8_t>, int, int> _grabFrameBuffer(
         std::optional<int> row = std::nullopt, std::optional<int> col = std::nullopt
     );
 
+    /**
+     * @brief Move the camera of all linked subplots of the active subplot, as a user interaction would.
+     *
+     * Used to replay scripted interactions (e.g. in benchmarks). The plot is re-drawn on the next render.
+     *
+     * @param operation The camera movement.
+     * @param amount Size of the movement, see CameraOperation.
+     */
+    void _moveCamera(CameraOperation operation, double amount);
+
 private:
 
     class Impl;
     std::unique_ptr<Impl> pImpl;
+
+    class UiThread;
+    std::unique_ptr<UiThread> m_uiThread;  // only with PlotterArgs::uiThread
+
+    template <typename Func>
+    auto runOnUiThread(Func&& func);
 };
 
 
+/**
+ * @brief Read OHLC data from a .csv file, in parallel.
+ *
+ * Requires "Open", "High", "Low", "Close" columns (any order, case-insensitive)
+ * and an optional "Date" column, other columns are ignored. Empty or "nan"
+ * values are read as NaN.
+ *
+ * The file is memory mapped and parsed by several threads, each into its
+ * own range of the (once-allocated) output columns.
+ *
+ * If the dates are ISO-8601 (e.g. "2024-01-02", "2024-01-02T09:30:00Z") and
+ * `parseIsoDates` is set, they are returned in `datesEpochNs` (datetimes without
+ * a UTC offset are taken as UTC). Otherwise the date strings are returned in `dates`.
+ *
+ * @param dataFilepath Path to the .csv file.
+ * @param numThreads Number of threads, 0 to use one per hardware thread.
+ *        Small files are read with fewer threads.
+ * @param parseIsoDates If `false`, ISO-8601 dates are also returned as strings in `dates`.
+ */
+RALLYPLOT_API CandleDataCSV readCandleDataCSV(
+    const std::string& dataFilepath, unsigned int numThreads = 0, bool parseIsoDates = true
+);
+
+
 #endif
@@ -0,0 +1,393 @@
+#include <QFile>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "../include/Plotter.h"
+#include "../structure/RangeMinMaxIndex.h"
+#include "../Utils.h"
+
+
+namespace
+{
+    /*
+        File layout (all values little-endian):
+
+            CandleColumnFileHeader
+            columns          numRows values each (float, dates int64)
+            zone maps        numBlocks mins then numBlocks maxes per float column (float)
+
+        Every section starts on a `sectionAlignment` byte boundary. The mapping
+        is page-aligned so the columns can be read in place.
+    */
+
+    constexpr char fileMagic[8] = {'R', 'A', 'L', 'L', 'Y', 'C', 'F', '\0'};
+    constexpr std::uint32_t fileVersion = 1;
+    constexpr std::uint64_t sectionAlignment = 64;
+
+    constexpr std::size_t numFloatColumns = 5;  // CandleColumn
+
+
+    struct CandleColumnFileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t numRows;
+        std::uint64_t blockSize;
+        std::uint64_t numBlocks;
+
+        // Byte offset of each section, 0 if it is not stored
+        std::uint64_t columnOffsets[numFloatColumns];
+        std::uint64_t datesOffset;
+        std::uint64_t zoneMapOffsets[numFloatColumns];
+    };
+
+    static_assert(sizeof(CandleColumnFileHeader) == 128, "The file header layout must not change.");
+
+
+    std::uint64_t alignUp(std::uint64_t offset)
+    {
+        return (offset + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+    }
+}
+
+
+// Reader
+// -------------------------------------------------------------------------------------------------
+
+class CandleColumnFile::Impl
+{
+public:
+    Impl(const std::string& filepath)
+        : m_filepath(filepath),
+        m_file(QString::fromStdString(filepath))
+    {
+        if (!utils_isLittleEndianHost())
+        {
+            throw std::runtime_error("Candle column files can only be read on little-endian platforms.");
+        }
+
+        if (!m_file.open(QIODevice::ReadOnly))
+        {
+            throw std::invalid_argument("Could not open the candle column file: " + filepath);
+        }
+
+        m_fileSize = static_cast<std::uint64_t>(m_file.size());
+
+        if (m_fileSize < sizeof(CandleColumnFileHeader))
+        {
+            throwInvalidFile("it is too small");
+        }
+
+        m_data = m_file.map(0, m_file.size());
+
+        if (m_data == nullptr)
+        {
+            throw std::invalid_argument("Could not memory map the candle column file: " + filepath);
+        }
+
+        std::memcpy(&m_header, m_data, sizeof(CandleColumnFileHeader));
+
+        validateHeader();
+    }
+
+    const CandleColumnFileHeader& header() const { return m_header; };
+
+    template <typename T>
+    StdPtrVector<T> section(std::uint64_t offset, std::uint64_t size, const std::string& name) const
+    {
+        if (offset == 0)
+        {
+            throw std::invalid_argument("The candle column file does not store " + name + ".");
+        }
+        return StdPtrVector<T>(reinterpret_cast<const T*>(m_data + offset), size);
+    }
+
+private:
+    std::string m_filepath;
+    QFile m_file;  // unmaps on destruction
+    const unsigned char* m_data = nullptr;
+    std::uint64_t m_fileSize = 0;
+    CandleColumnFileHeader m_header;
+
+    [[noreturn]] void throwInvalidFile(const std::string& reason) const
+    {
+        throw std::invalid_argument("Invalid candle column file (" + reason + "): " + m_filepath);
+    }
+
+    void validateSection(std::uint64_t offset, std::uint64_t numBytes) const
+    {
+        if (offset % sectionAlignment != 0 || offset < sizeof(CandleColumnFileHeader) ||
+            offset > m_fileSize || numBytes > m_fileSize - offset)
+        {
+            throwInvalidFile("a column is out of bounds");
+        }
+    }
+
+    void validateHeader() const
+    /*
+        Check every section lies within the file, so views can never read past the mapping.
+     */
+    {
+        if (std::memcmp(m_header.magic, fileMagic, sizeof(fileMagic)) != 0)
+        {
+            throwInvalidFile("not a candle column file");
+        }
+        if (m_header.version != fileVersion || m_header.headerSize != sizeof(CandleColumnFileHeader))
+        {
+            throwInvalidFile("unsupported version " + std::to_string(m_header.version));
+        }
+        if (m_header.blockSize == 0 ||
+            m_header.numBlocks != (m_header.numRows + m_header.blockSize - 1) / m_header.blockSize ||
+            m_header.numRows > m_fileSize)
+        {
+            throwInvalidFile("bad block size");
+        }
+
+        for (std::size_t i = 0; i < numFloatColumns; i++)
+        {
+            bool isRequired = i != static_cast<std::size_t>(CandleColumn::volume);
+
+            if (m_header.columnOffsets[i] == 0 && isRequired)
+            {
+                throwInvalidFile("a required column is missing");
+            }
+            if ((m_header.columnOffsets[i] == 0) != (m_header.zoneMapOffsets[i] == 0))
+            {
+                throwInvalidFile("a zone map is missing");
+            }
+            if (m_header.columnOffsets[i] != 0)
+            {
+                validateSection(m_header.columnOffsets[i], m_header.numRows * sizeof(float));
+                validateSection(m_header.zoneMapOffsets[i], 2 * m_header.numBlocks * sizeof(float));
+            }
+        }
+
+        if (m_header.datesOffset != 0)
+        {
+            validateSection(m_header.datesOffset, m_header.numRows * sizeof(std::int64_t));
+        }
+    }
+};
+
+
+CandleColumnFile::CandleColumnFile(const std::string& filepath)
+    : pImpl(std::make_unique<Impl>(filepath))
+{
+}
+
+
+CandleColumnFile::~CandleColumnFile() = default;
+
+
+std::size_t CandleColumnFile::size() const
+{
+    return pImpl->header().numRows;
+}
+
+
+std::size_t CandleColumnFile::blockSize() const
+{
+    return pImpl->header().blockSize;
+}
+
+
+bool CandleColumnFile::hasColumn(CandleColumn column) const
+{
+    return pImpl->header().columnOffsets[static_cast<std::size_t>(column)] != 0;
+}
+
+
+bool CandleColumnFile::hasDates() const
+{
+    return pImpl->header().datesOffset != 0;
+}
+
+
+StdPtrVector<float> CandleColumnFile::column(CandleColumn column) const
+{
+    const CandleColumnFileHeader& header = pImpl->header();
+
+    return pImpl->section<float>(header.columnOffsets[static_cast<std::size_t>(column)], header.numRows, "this column");
+}
+
+
+StdPtrVector<float> CandleColumnFile::blockMin(CandleColumn column) const
+{
+    const CandleColumnFileHeader& header = pImpl->header();
+
+    return pImpl->section<float>(header.zoneMapOffsets[static_cast<std::size_t>(column)], header.numBlocks, "this column");
+}
+
+
+StdPtrVector<float> CandleColumnFile::blockMax(CandleColumn column) const
+{
+    const CandleColumnFileHeader& header = pImpl->header();
+    std::uint64_t offset = header.zoneMapOffsets[static_cast<std::size_t>(column)];
+
+    if (offset != 0)
+    {
+        offset += header.numBlocks * sizeof(float);
+    }
+    return pImpl->section<float>(offset, header.numBlocks, "this column");
+}
+
+
+EpochNsVector CandleColumnFile::dates() const
+{
+    const CandleColumnFileHeader& header = pImpl->header();
+
+    return pImpl->section<std::int64_t>(header.datesOffset, header.numRows, "dates");
+}
+
+
+// Writer
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+    void computeZoneMap(const StdPtrVector<float>& column, std::size_t blockSize, std::vector<float>& zoneMap)
+    /*
+        Fill `zoneMap` with the min of each block, then the max of each block.
+        NaN values are skipped, as in RangeMinMaxIndex.
+     */
+    {
+        std::size_t numBlocks = (column.size() + blockSize - 1) / blockSize;
+
+        zoneMap.assign(2 * numBlocks, 0.0f);
+
+        const float* data = column.data();
+
+        for (std::size_t blockIdx = 0; blockIdx < numBlocks; blockIdx++)
+        {
+            float min = std::numeric_limits<float>::infinity();
+            float max = -std::numeric_limits<float>::infinity();
+
+            std::size_t end = std::min((blockIdx + 1) * blockSize, column.size());
+
+            for (std::size_t i = blockIdx * blockSize; i < end; i++)
+            {
+                min = data[i] < min ? data[i] : min;
+                max = data[i] > max ? data[i] : max;
+            }
+            zoneMap[blockIdx] = min;
+            zoneMap[numBlocks + blockIdx] = max;
+        }
+    }
+}
+
+
+void writeCandleColumnFile(
+    const std::string& filepath,
+    const StdPtrVector<float>& open,
+    const StdPtrVector<float>& high,
+    const StdPtrVector<float>& low,
+    const StdPtrVector<float>& close,
+    std::optional<StdPtrVector<float>> volume,
+    std::optional<EpochNsVector> dates
+)
+/*
+    The zone map block size is that of RangeMinMaxIndex, so the
+    high / low zone maps can be used as its blocks when plotting.
+ */
+{
+    if (!utils_isLittleEndianHost())
+    {
+        throw std::runtime_error("Candle column files can only be written on little-endian platforms.");
+    }
+
+    std::size_t numRows = open.size();
+
+    if (high.size() != numRows || low.size() != numRows || close.size() != numRows ||
+        (volume.has_value() && volume->size() != numRows) || (dates.has_value() && dates->size() != numRows))
+    {
+        throw std::invalid_argument("Candle open, high, low, close, volume and dates must all be the same size.");
+    }
+
+    std::array<std::optional<StdPtrVector<float>>, numFloatColumns> columns = {open, high, low, close, volume};
+
+    CandleColumnFileHeader header{};
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.headerSize = sizeof(CandleColumnFileHeader);
+    header.numRows = numRows;
+    header.blockSize = RangeMinMaxIndex::blockSize;
+    header.numBlocks = (numRows + header.blockSize - 1) / header.blockSize;
+
+    // Lay out the sections
+    std::uint64_t offset = alignUp(sizeof(CandleColumnFileHeader));
+
+    for (std::size_t i = 0; i < numFloatColumns; i++)
+    {
+        if (columns[i].has_value())
+        {
+            header.columnOffsets[i] = offset;
+            offset = alignUp(offset + numRows * sizeof(float));
+        }
+    }
+    if (dates.has_value())
+    {
+        header.datesOffset = offset;
+        offset = alignUp(offset + numRows * sizeof(std::int64_t));
+    }
+    for (std::size_t i = 0; i < numFloatColumns; i++)
+    {
+        if (columns[i].has_value())
+        {
+            header.zoneMapOffsets[i] = offset;
+            offset = alignUp(offset + 2 * header.numBlocks * sizeof(float));
+        }
+    }
+
+    // Write the sections in order, zero-padding up to each offset
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+
+    if (!file)
+    {
+        throw std::invalid_argument("Could not open the candle column file for writing: " + filepath);
+    }
+
+    std::uint64_t written = 0;
+
+    auto writeSection = [&](std::uint64_t sectionOffset, const void* data, std::uint64_t numBytes)
+    {
+        static const char padding[sectionAlignment] = {};
+
+        file.write(padding, static_cast<std::streamsize>(sectionOffset - written));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(numBytes));
+        written = sectionOffset + numBytes;
+    };
+
+    writeSection(0, &header, sizeof(CandleColumnFileHeader));
+
+    for (std::size_t i = 0; i < numFloatColumns; i++)
+    {
+        if (columns[i].has_value())
+        {
+            writeSection(header.columnOffsets[i], columns[i]->data(), numRows * sizeof(float));
+        }
+    }
+    if (dates.has_value())
+    {
+        writeSection(header.datesOffset, dates->data(), numRows * sizeof(std::int64_t));
+    }
+
+    std::vector<float> zoneMap;
+
+    for (std::size_t i = 0; i < numFloatColumns; i++)
+    {
+        if (columns[i].has_value())
+        {
+            computeZoneMap(columns[i].value(), header.blockSize, zoneMap);
+            writeSection(header.zoneMapOffsets[i], zoneMap.data(), zoneMap.size() * sizeof(float));
+        }
+    }
+
+    if (!file.flush())
+    {
+        throw std::invalid_argument("Could not write the candle column file: " + filepath);
+    }
+}
@@ -0,0 +1,652 @@
+#include "CandleCsvReader.h"
+#include <QFile>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../../vendor/date-master/date/date.h"
+#include "../ParallelFor.h"
+#include "../Utils.h"
+
+
+namespace
+{
+    // Reading is split into chunks of at least this size, one thread per chunk.
+    constexpr std::size_t minChunkBytes = 1 << 20;
+
+
+    struct CsvLayout
+    /*
+        Column index of each field, from the header. `date` is -1 if there is no date column.
+     */
+    {
+        int open = -1;
+        int high = -1;
+        int low = -1;
+        int close = -1;
+        int date = -1;
+        int lastRequiredColumn = -1;
+    };
+
+
+    // Field parsing
+    // -------------------------------------------------------------------------------------------------
+
+    std::uint32_t parseEightDigitsSwar(std::uint64_t chars)
+    /*
+        Convert 8 ASCII digits (loaded little-endian) to their value, combining
+        pairs of digits, then pairs of pairs etc. within the 64-bit register.
+     */
+    {
+        chars -= 0x3030303030303030ULL;
+        chars = (chars * 10) + (chars >> 8);
+        chars = (((chars & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                 (((chars >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        return static_cast<std::uint32_t>(chars);
+    }
+
+
+    bool isEightDigitsSwar(std::uint64_t chars)
+    {
+        return (((chars & 0xF0F0F0F0F0F0F0F0ULL) |
+                 (((chars + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+    }
+
+
+    void parseDigits(const char*& ptr, const char* end, std::uint64_t& mantissa, int& numDigits, int& droppedDigits)
+    /*
+        Accumulate a run of digits into `mantissa`. Digits beyond the 19 that
+        fit in a uint64 are counted in `droppedDigits` (to scale the exponent).
+        Runs of 8 digits are parsed at once (SWAR) on little-endian platforms.
+     */
+    {
+        static const bool useSwar = utils_isLittleEndianHost();
+
+        while (useSwar && end - ptr >= 8 && numDigits <= 11)
+        {
+            std::uint64_t chars;
+            std::memcpy(&chars, ptr, 8);
+
+            if (!isEightDigitsSwar(chars))
+            {
+                break;
+            }
+            mantissa = mantissa * 100000000ULL + parseEightDigitsSwar(chars);
+            numDigits += 8;
+            ptr += 8;
+        }
+
+        while (ptr < end && *ptr >= '0' && *ptr <= '9')
+        {
+            if (numDigits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*ptr - '0');
+                numDigits += (mantissa != 0);
+            }
+            else
+            {
+                droppedDigits++;
+            }
+            ptr++;
+        }
+    }
+
+
+    bool parseFixedDigits(const char*& ptr, const char* end, int numDigits, int& out)
+    {
+        if (end - ptr < numDigits)
+        {
+            return false;
+        }
+        out = 0;
+        for (int i = 0; i < numDigits; i++)
+        {
+            if (ptr[i] < '0' || ptr[i] > '9')
+            {
+                return false;
+            }
+            out = out * 10 + (ptr[i] - '0');
+        }
+        ptr += numDigits;
+        return true;
+    }
+}
+
+
+bool csvParseFloat(const char*& ptr, const char* end, float& out)
+/*
+    Parse a decimal number (e.g. "-12.5", "1e-3") or "nan" / empty (as NaN, a gap).
+
+    The digits are accumulated as an integer and scaled by a power of ten once,
+    exactly in double precision for up to 15 significant digits, then
+    rounded to float.
+ */
+{
+    static const std::array<double, 23> powersOfTen = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    if (ptr == end || *ptr == ',' || *ptr == '\r' || *ptr == '\n')
+    {
+        out = std::numeric_limits<float>::quiet_NaN();
+        return true;
+    }
+
+    bool negative = (*ptr == '-');
+    if (*ptr == '-' || *ptr == '+')
+    {
+        ptr++;
+    }
+
+    if (end - ptr >= 3 && (ptr[0] == 'n' || ptr[0] == 'N') && (ptr[1] == 'a' || ptr[1] == 'A') && (ptr[2] == 'n' || ptr[2] == 'N'))
+    {
+        ptr += 3;
+        out = std::numeric_limits<float>::quiet_NaN();
+        return true;
+    }
+
+    std::uint64_t mantissa = 0;
+    int numDigits = 0;
+    int droppedDigits = 0;
+    const char* digitsStart = ptr;
+
+    parseDigits(ptr, end, mantissa, numDigits, droppedDigits);
+
+    int exponent = droppedDigits;
+
+    if (ptr < end && *ptr == '.')
+    {
+        ptr++;
+        const char* fractionStart = ptr;
+        int fractionDropped = 0;
+
+        parseDigits(ptr, end, mantissa, numDigits, fractionDropped);
+
+        exponent -= static_cast<int>(ptr - fractionStart) - fractionDropped;
+    }
+
+    if (ptr == digitsStart || (ptr == digitsStart + 1 && *digitsStart == '.'))
+    {
+        return false;
+    }
+
+    if (ptr < end && (*ptr == 'e' || *ptr == 'E'))
+    {
+        ptr++;
+        bool negativeExponent = (ptr < end && *ptr == '-');
+        if (ptr < end && (*ptr == '-' || *ptr == '+'))
+        {
+            ptr++;
+        }
+        if (ptr == end || *ptr < '0' || *ptr > '9')
+        {
+            return false;
+        }
+        int explicitExponent = 0;
+        while (ptr < end && *ptr >= '0' && *ptr <= '9')
+        {
+            explicitExponent = std::min(explicitExponent * 10 + (*ptr - '0'), 10000);
+            ptr++;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    double value = static_cast<double>(mantissa);
+
+    if (mantissa == 0)
+    {
+        value = 0.0;
+    }
+    else if (exponent >= 0 && exponent <= 22)
+    {
+        value *= powersOfTen[exponent];
+    }
+    else if (exponent < 0 && exponent >= -22)
+    {
+        value /= powersOfTen[-exponent];
+    }
+    else
+    {
+        value *= std::pow(10.0, exponent);
+    }
+
+    out = static_cast<float>(negative ? -value : value);
+    return true;
+}
+
+
+bool csvParseIsoDatetime(const char*& ptr, const char* end, std::int64_t& outEpochNs)
+/*
+    Parse an ISO-8601 date or datetime: "YYYY-MM-DD", optionally followed by
+    "[T ]HH:MM[:SS[.fraction]]" and a "Z" or "+HH:MM" / "-HHMM" UTC offset.
+    Datetimes without an offset are taken as UTC.
+ */
+{
+    using namespace std::chrono;
+
+    int year, month, day;
+    int hours = 0, minutes = 0, seconds = 0;
+    std::int64_t fractionNs = 0;
+    int offsetMinutes = 0;
+
+    if (!parseFixedDigits(ptr, end, 4, year) || ptr == end || *ptr++ != '-' ||
+        !parseFixedDigits(ptr, end, 2, month) || ptr == end || *ptr++ != '-' ||
+        !parseFixedDigits(ptr, end, 2, day))
+    {
+        return false;
+    }
+
+    if (ptr < end && (*ptr == 'T' || *ptr == ' ') && end - ptr > 1 && ptr[1] >= '0' && ptr[1] <= '9')
+    {
+        ptr++;
+
+        if (!parseFixedDigits(ptr, end, 2, hours) || ptr == end || *ptr++ != ':' ||
+            !parseFixedDigits(ptr, end, 2, minutes))
+        {
+            return false;
+        }
+
+        if (ptr < end && *ptr == ':')
+        {
+            ptr++;
+            if (!parseFixedDigits(ptr, end, 2, seconds))
+            {
+                return false;
+            }
+
+            if (ptr < end && (*ptr == '.' || *ptr == ','))
+            {
+                ptr++;
+                std::int64_t scale = 100000000;
+                while (ptr < end && *ptr >= '0' && *ptr <= '9')
+                {
+                    fractionNs += (*ptr - '0') * scale;
+                    scale /= 10;
+                    ptr++;
+                }
+            }
+        }
+
+        if (ptr < end && *ptr == 'Z')
+        {
+            ptr++;
+        }
+        else if (ptr < end && (*ptr == '+' || *ptr == '-'))
+        {
+            int sign = (*ptr++ == '-') ? -1 : 1;
+            int offsetHours, offsetMins = 0;
+
+            if (!parseFixedDigits(ptr, end, 2, offsetHours))
+            {
+                return false;
+            }
+            if (ptr < end && *ptr == ':')
+            {
+                ptr++;
+            }
+            parseFixedDigits(ptr, end, 2, offsetMins);
+
+            offsetMinutes = sign * (offsetHours * 60 + offsetMins);
+        }
+    }
+
+    date::year_month_day ymd{date::year{year}, date::month{static_cast<unsigned>(month)}, date::day{static_cast<unsigned>(day)}};
+
+    if (!ymd.ok() || hours > 23 || minutes > 59 || seconds > 60)
+    {
+        return false;
+    }
+
+    std::int64_t daysSinceEpoch = date::sys_days{ymd}.time_since_epoch().count();
+    std::int64_t secondsSinceEpoch = daysSinceEpoch * 86400 + hours * 3600 + minutes * 60 + seconds - offsetMinutes * 60;
+
+    outEpochNs = secondsSinceEpoch * 1000000000LL + fractionNs;
+    return true;
+}
+
+
+namespace
+{
+    // Line and field splitting
+    // -------------------------------------------------------------------------------------------------
+
+    const char* findLineEnd(const char* ptr, const char* end)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(ptr, '\n', end - ptr));
+        return lineEnd ? lineEnd : end;
+    }
+
+
+    const char* findNextLine(const char* ptr, const char* end)
+    {
+        const char* lineEnd = findLineEnd(ptr, end);
+        return (lineEnd == end) ? end : lineEnd + 1;
+    }
+
+
+    bool isBlankLine(const char* lineStart, const char* lineEnd)
+    {
+        return lineStart == lineEnd || (lineEnd - lineStart == 1 && *lineStart == '\r');
+    }
+
+
+    template <typename Function>
+    void forEachLine(const char* begin, const char* end, Function function)
+    /*
+        Call `function(lineStart, lineEnd)` for every non-blank line in [begin, end),
+        `lineEnd` excludes the newline (and a trailing carriage return).
+     */
+    {
+        const char* ptr = begin;
+
+        while (ptr < end)
+        {
+            const char* lineEnd = findLineEnd(ptr, end);
+
+            if (!isBlankLine(ptr, lineEnd))
+            {
+                function(ptr, (lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd);
+            }
+            ptr = (lineEnd == end) ? end : lineEnd + 1;
+        }
+    }
+
+
+    std::string trimField(const char* start, const char* end)
+    {
+        while (start < end && (std::isspace(static_cast<unsigned char>(*start)) || *start == '"'))
+        {
+            start++;
+        }
+        while (end > start && (std::isspace(static_cast<unsigned char>(end[-1])) || end[-1] == '"'))
+        {
+            end--;
+        }
+        return std::string(start, end);
+    }
+
+
+    CsvLayout parseHeader(const char* lineStart, const char* lineEnd)
+    /*
+        Find the column of each field (case-insensitive). Extra columns are ignored.
+     */
+    {
+        CsvLayout layout;
+
+        // Skip a UTF-8 byte order mark
+        if (lineEnd - lineStart >= 3 && std::memcmp(lineStart, "\xEF\xBB\xBF", 3) == 0)
+        {
+            lineStart += 3;
+        }
+
+        int column = 0;
+        const char* fieldStart = lineStart;
+
+        while (fieldStart <= lineEnd)
+        {
+            const char* fieldEnd = std::find(fieldStart, lineEnd, ',');
+
+            std::string name = trimField(fieldStart, fieldEnd);
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+
+            if (name == "open") layout.open = column;
+            else if (name == "high") layout.high = column;
+            else if (name == "low") layout.low = column;
+            else if (name == "close") layout.close = column;
+            else if (name == "date") layout.date = column;
+
+            column++;
+            fieldStart = fieldEnd + 1;
+        }
+
+        if (layout.open < 0 || layout.high < 0 || layout.low < 0 || layout.close < 0)
+        {
+            throw std::invalid_argument("The .csv file must have \"Open\", \"High\", \"Low\" and \"Close\" columns.");
+        }
+
+        layout.lastRequiredColumn = std::max({layout.open, layout.high, layout.low, layout.close, layout.date});
+
+        return layout;
+    }
+
+
+    struct CsvColumns
+    /*
+        Non-owning view of the preallocated output columns, each thread
+        writes its rows starting at its own row offset.
+     */
+    {
+        float* open;
+        float* high;
+        float* low;
+        float* close;
+        std::int64_t* datesEpochNs;  // nullptr if no date column or dates are not ISO-8601
+        std::string* dates;          // nullptr if no date column or dates are ISO-8601
+    };
+
+
+    bool isFieldEnd(const char* ptr, const char* fieldEnd)
+    /*
+        Only whitespace or a closing quote may follow a parsed value.
+     */
+    {
+        while (ptr < fieldEnd && (*ptr == ' ' || *ptr == '"' || *ptr == '\t'))
+        {
+            ptr++;
+        }
+        return ptr == fieldEnd;
+    }
+
+
+    void parseRow(const char* lineStart, const char* lineEnd, const CsvLayout& layout, const CsvColumns& columns, std::size_t rowIdx)
+    {
+        const char* ptr = lineStart;
+
+        for (int column = 0; column <= layout.lastRequiredColumn; column++)
+        {
+            if (ptr > lineEnd)
+            {
+                throw std::invalid_argument("Row " + std::to_string(rowIdx + 1) + " of the .csv file has too few columns.");
+            }
+
+            const char* fieldEnd = static_cast<const char*>(std::memchr(ptr, ',', lineEnd - ptr));
+            fieldEnd = fieldEnd ? fieldEnd : lineEnd;
+
+            const char* fieldStart = ptr;
+            while (fieldStart < fieldEnd && (*fieldStart == ' ' || *fieldStart == '"'))
+            {
+                fieldStart++;
+            }
+
+            bool ok = true;
+            float* floatColumn = nullptr;
+
+            if (column == layout.open) floatColumn = columns.open;
+            else if (column == layout.high) floatColumn = columns.high;
+            else if (column == layout.low) floatColumn = columns.low;
+            else if (column == layout.close) floatColumn = columns.close;
+
+            const char* valueEnd = fieldStart;
+
+            if (floatColumn)
+            {
+                ok = csvParseFloat(valueEnd, fieldEnd, floatColumn[rowIdx]) && isFieldEnd(valueEnd, fieldEnd);
+            }
+            else if (column == layout.date && columns.datesEpochNs)
+            {
+                ok = csvParseIsoDatetime(valueEnd, fieldEnd, columns.datesEpochNs[rowIdx]) && isFieldEnd(valueEnd, fieldEnd);
+            }
+            else if (column == layout.date && columns.dates)
+            {
+                columns.dates[rowIdx] = trimField(fieldStart, fieldEnd);
+            }
+
+            if (!ok)
+            {
+                throw std::invalid_argument(
+                    "Could not parse \"" + trimField(fieldStart, fieldEnd) + "\" in row " + std::to_string(rowIdx + 1) + " of the .csv file."
+                );
+            }
+
+            ptr = fieldEnd + 1;
+        }
+    }
+}
+
+
+// Reader
+// -------------------------------------------------------------------------------------------------
+
+CandleDataCSV readCandleDataCSV(const std::string& dataFilepath, unsigned int numThreads, bool parseIsoDates)
+/*
+    Read a .csv with columns (Open, High, Low, Close) and optionally (Date).
+
+    The file is memory mapped and split into chunks on line boundaries. Each
+    thread first counts the rows in its chunk; the counts give every chunk's
+    first row, so that (after allocating the columns once) each thread parses
+    its rows directly into place.
+
+    If the first date is ISO-8601 (and `parseIsoDates`), all dates are parsed to UTC
+    nanoseconds since the epoch (`datesEpochNs`). Otherwise, the date strings are
+    kept (`dates`).
+ */
+{
+    QFile file(QString::fromStdString(dataFilepath));
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        throw std::invalid_argument("Could not open the .csv file: " + dataFilepath);
+    }
+
+    CandleDataCSV candleData;
+
+    if (file.size() == 0)
+    {
+        throw std::invalid_argument("The .csv file is empty: " + dataFilepath);
+    }
+
+    const char* fileBegin = reinterpret_cast<const char*>(file.map(0, file.size()));
+
+    if (fileBegin == nullptr)
+    {
+        throw std::invalid_argument("Could not memory map the .csv file: " + dataFilepath);
+    }
+    const char* fileEnd = fileBegin + file.size();
+
+    // Header
+    const char* headerEnd = findLineEnd(fileBegin, fileEnd);
+    CsvLayout layout = parseHeader(fileBegin, (headerEnd > fileBegin && headerEnd[-1] == '\r') ? headerEnd - 1 : headerEnd);
+
+    const char* dataBegin = findNextLine(fileBegin, fileEnd);
+
+    // Split into chunks on line boundaries
+    if (numThreads == 0)
+    {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t dataSize = fileEnd - dataBegin;
+    std::size_t numChunks = std::max<std::size_t>(1, std::min<std::size_t>(numThreads, dataSize / minChunkBytes));
+
+    std::vector<const char*> chunkStarts(numChunks + 1, fileEnd);
+    chunkStarts[0] = dataBegin;
+
+    for (std::size_t i = 1; i < numChunks; i++)
+    {
+        const char* split = std::max(dataBegin + i * (dataSize / numChunks), chunkStarts[i - 1]);
+        chunkStarts[i] = findNextLine(split, fileEnd);
+    }
+
+    // Chunks are already split on line boundaries, so each is one item of parallelFor
+    auto runChunks = [&](auto function)
+    {
+        parallelFor(numChunks, 1, [&](std::size_t firstChunk, std::size_t endChunk)
+        {
+            for (std::size_t chunkIdx = firstChunk; chunkIdx < endChunk; chunkIdx++)
+            {
+                function(chunkIdx);
+            }
+        });
+    };
+
+    // Count the rows in each chunk, to find each chunk's first row
+    std::vector<std::size_t> chunkRowOffsets(numChunks + 1, 0);
+
+    runChunks([&](std::size_t chunkIdx)
+    {
+        std::size_t numRows = 0;
+        forEachLine(chunkStarts[chunkIdx], chunkStarts[chunkIdx + 1], [&](const char*, const char*) { numRows++; });
+        chunkRowOffsets[chunkIdx + 1] = numRows;
+    });
+
+    for (std::size_t i = 1; i <= numChunks; i++)
+    {
+        chunkRowOffsets[i] += chunkRowOffsets[i - 1];
+    }
+    std::size_t numRows = chunkRowOffsets[numChunks];
+
+    // Dates are ISO-8601 if the first one is
+    bool isoDates = false;
+
+    if (parseIsoDates && layout.date >= 0 && numRows > 0)
+    {
+        const char* firstRowEnd = findLineEnd(dataBegin, fileEnd);
+        const char* field = dataBegin;
+
+        for (int column = 0; column < layout.date && field < firstRowEnd; column++)
+        {
+            field = std::find(field, firstRowEnd, ',') + 1;
+        }
+        while (field < firstRowEnd && (*field == ' ' || *field == '"'))
+        {
+            field++;
+        }
+        std::int64_t unused;
+        isoDates = csvParseIsoDatetime(field, firstRowEnd, unused);
+    }
+
+    // Allocate the columns once and parse into them
+    candleData.open.resize(numRows);
+    candleData.high.resize(numRows);
+    candleData.low.resize(numRows);
+    candleData.close.resize(numRows);
+
+    if (layout.date >= 0)
+    {
+        if (isoDates)
+        {
+            candleData.datesEpochNs.resize(numRows);
+        }
+        else
+        {
+            candleData.dates.resize(numRows);
+        }
+    }
+
+    CsvColumns columns{
+        candleData.open.data(),
+        candleData.high.data(),
+        candleData.low.data(),
+        candleData.close.data(),
+        (layout.date >= 0 && isoDates) ? candleData.datesEpochNs.data() : nullptr,
+        (layout.date >= 0 && !isoDates) ? candleData.dates.data() : nullptr
+    };
+
+    runChunks([&](std::size_t chunkIdx)
+    {
+        std::size_t rowIdx = chunkRowOffsets[chunkIdx];
+
+        forEachLine(chunkStarts[chunkIdx], chunkStarts[chunkIdx + 1], [&](const char* lineStart, const char* lineEnd)
+        {
+            parseRow(lineStart, lineEnd, layout, columns, rowIdx);
+            rowIdx++;
+        });
+    });
+
+    return candleData;
+}
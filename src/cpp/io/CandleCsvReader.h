@@ -0,0 +1,16 @@
+#ifndef CANDLECSVREADER_H
+#define CANDLECSVREADER_H
+
+#include <cstdint>
+#include "../include/Plotter.h"
+
+
+// Field parsers used by readCandleDataCSV() (declared in Plotter.h). `ptr` is
+// advanced past the parsed characters. Both return false if the field could
+// not be parsed.
+
+bool csvParseFloat(const char*& ptr, const char* end, float& out);
+bool csvParseIsoDatetime(const char*& ptr, const char* end, std::int64_t& outEpochNs);
+
+
+#endif // CANDLECSVREADER_H
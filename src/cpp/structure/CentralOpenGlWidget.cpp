@@ -9,7 +9,9 @@
 #include "CentralOpenGlWidget.h"
 #include "../charts/plots/CandlestickPlot.h"
 #include "../charts/plots/LinePlot.h"
+#include "../charts/shaders/ProgramCache.h"
 #include <qlibrary.h>
+#include <iostream>
 
 
 CentralOpenGlWidget::CentralOpenGlWidget(QWidget *parent, Configs& configs)
@@ -29,13 +31,32 @@ CentralOpenGlWidget::CentralOpenGlWidget(QWidget *parent, Configs& configs)
 }
 
 
+CentralOpenGlWidget::~CentralOpenGlWidget()
+{
+    if (m_updateQueue)
+    {
+        m_updateQueue->close();
+    }
+
+    // The context goes with the widget, a new one may reuse the address of its functions
+    if (m_gl)
+    {
+        ProgramCache::releaseContext(*m_gl);
+    }
+}
+
+
 void CentralOpenGlWidget::initializeGL()
 {
     m_gl = QOpenGLVersionFunctionsFactory::get<QOpenGLFunctions_3_3_Core>(QOpenGLContext::currentContext());
 
     m_gl->initializeOpenGLFunctions();
 
+    // Before the RenderManager, which links the programs
+    ProgramCache::setBinaryCacheDirectory(*m_gl, m_configs.m_plotOptions.programBinaryCacheDir);
+
     m_rm = std::make_unique<RenderManager>(*this, m_configs, *m_gl);
+    m_plotLayerCache = std::make_unique<PlotLayerCache>(*m_gl);
 
     // If the mouse is not over the plot,  the gridlines don't update. This is a weird
     // experience for the user (the gridlines only appear when the mouse is moved over
@@ -50,13 +71,23 @@ void CentralOpenGlWidget::initializeGL()
 
 void CentralOpenGlWidget::paintGL()
 {
+    std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+    m_rm->m_profiler.beginFrame();
+
     // Perform any previously qued actions that must be run in paintGL.
+    if (!m_paintGlQueue.empty())
+    {
+        m_plotLayerDirty = true;
+    }
     while (!m_paintGlQueue.empty())
     {
         m_paintGlQueue.front()();
         m_paintGlQueue.pop();
     };
 
+    applyQueuedUpdates();
+
     // Handle zooming with left or right mousebuttons
     if (m_leftMouseButtonPressed || m_rightMouseButtonPressed)
     {
@@ -119,25 +150,217 @@ void CentralOpenGlWidget::paintGL()
     painter.setRenderHint(QPainter::TextAntialiasing);
 
     painter.beginNativePainting();
-    m_rm->paint();
+    paintPlotLayer();
     painter.endNativePainting();
 
-    if (m_showPopup && m_hoverValueSettings.displayMode != HoverValueDisplayMode::off)
     {
-        showValuePopup(painter);
+        ProfileScope scope(m_rm->m_profiler, ProfileStage::overlays);
+
+        if (m_showPopup && m_hoverValueSettings.displayMode != HoverValueDisplayMode::off)
+        {
+            showValuePopup(painter);
+        }
+        if (m_showCrosshair && m_crosshairSettings.on)
+        {
+            showCrosshairs(painter);
+        }
+
+        painter.end();
+    }
+
+    m_rm->m_profiler.endFrame();
+
+    if (!m_firstFrameTime.has_value())
+    {
+        m_firstFrameTime = std::chrono::steady_clock::now();
+        m_firstFrameDrawMs = std::chrono::duration<double, std::milli>(m_firstFrameTime.value() - frameStart).count();
+    }
+
+    scheduleDeferredWork();
+}
+
+
+void CentralOpenGlWidget::scheduleDeferredWork()
+/*
+    Run the deferred work once control returns to the event loop, so it
+    never delays a frame (or the first frame). Nothing runs without an
+    event loop (e.g. headless), the plots then do it on demand when drawing.
+ */
+{
+    if (m_deferredWorkScheduled || m_rm->m_deferredWork.empty())
+    {
+        return;
     }
-    if (m_showCrosshair && m_crosshairSettings.on)
+    m_deferredWorkScheduled = true;
+
+    QTimer::singleShot(0, this, [this]() { runDeferredWork(); });
+}
+
+
+void CentralOpenGlWidget::runDeferredWork()
+/*
+    Run one slice of deferred work, and schedule the next slice (after
+    any pending events, e.g. input and repaints) if work remains.
+ */
+{
+    m_deferredWorkScheduled = false;
+
+    makeCurrent();
+    m_rm->m_deferredWork.runFor(DeferredWorkQueue::sliceBudgetMs);
+    doneCurrent();
+
+    scheduleDeferredWork();
+}
+
+
+void CentralOpenGlWidget::paintPlotLayer()
+/*
+    Draw the plots, axes and labels. These are rendered into the plot layer
+    cache and then copied to the widget, so that frames in which only the
+    overlays change (e.g. moving the crosshair) do not re-draw all plots.
+
+    The layer is only re-rendered if it was marked dirty (data, settings or
+    legend changes, key presses, resizing) or the camera / tick / plot state
+    has changed since the last render. If the state changes while rendering
+    (e.g. ticks are updated following a pan) the next frame re-renders too.
+ */
+{
+    ProfileScope scope(m_rm->m_profiler, ProfileStage::plotLayer);
+
+    const GLsizei physicalWidth  = static_cast<GLsizei>(std::round(width() * devicePixelRatio()));
+    const GLsizei physicalHeight = static_cast<GLsizei>(std::round(height() * devicePixelRatio()));
+
+    int numSamples = 0;
+    m_gl->glGetIntegerv(GL_SAMPLES, &numSamples);
+
+    if (!m_plotLayerCache->bindForRender(physicalWidth, physicalHeight, numSamples))
     {
-        showCrosshairs(painter);
+        m_gl->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+        m_rm->paint();
+        return;
     }
 
-    painter.end();
+    std::vector<double> state = m_rm->plotLayerState();
+
+    if (m_plotLayerDirty || state != m_plotLayerState)
+    {
+        m_rm->paint();
+
+        m_plotLayerState = m_rm->plotLayerState();
+        m_plotLayerDirty = (m_plotLayerState != state);
+    }
 
+    m_plotLayerCache->blitTo(defaultFramebufferObject());
+}
+
+
+void CentralOpenGlWidget::markPlotLayerDirty()
+/*
+    Force the plot layer to be re-rendered on the next paint. Must be called
+    on any change to the plots that is not captured by RenderManager::plotLayerState().
+ */
+{
+    m_plotLayerDirty = true;
+}
+
+
+std::shared_ptr<UpdateQueue> CentralOpenGlWidget::updateQueue()
+/*
+    The queue is created with the first stream. Producers cannot call
+    update() from their thread, so a timer checks the queue each frame
+    interval and only schedules a paint when it holds updates.
+ */
+{
+    if (!m_updateQueue)
+    {
+        m_updateQueue = std::make_shared<UpdateQueue>(UpdateQueue::defaultCapacity);
+
+        m_updateQueueTimer = new QTimer(this);
+        connect(m_updateQueueTimer, &QTimer::timeout, this, [this]
+        {
+            if (!m_updateQueue->empty())
+            {
+                this->update();
+            }
+        });
+        m_updateQueueTimer->start(16);
+    }
+    return m_updateQueue;
+}
+
+
+void CentralOpenGlWidget::applyQueuedUpdates()
+/*
+    Drain the streamed candles and apply them with one append (and at
+    most one overwrite of the last candle) per series, so the GPU upload
+    and min / max update happen once per frame rather than per tick.
+    Errors cannot be returned to the producer thread, so they are printed.
+ */
+{
+    if (!m_updateQueue || m_updateQueue->drain(m_drainedUpdates) == 0)
+    {
+        return;
+    }
+
+    m_plotLayerDirty = true;
+
+    for (auto& [seriesId, updates] : m_drainedUpdates)
+    {
+        if (!updates.hasLastCandleUpdate && updates.open.empty())
+        {
+            continue;  // kept from an earlier frame so its vectors are reused
+        }
+
+        try
+        {
+            if (seriesId >= static_cast<int>(m_rm->m_linkedSubplots.size()))
+            {
+                throw std::invalid_argument("The streamed linked subplot no longer exists.");
+            }
+
+            LinkedSubplot& linkedSubplot = *m_rm->m_linkedSubplots[seriesId];
+
+            if (linkedSubplot.jointPlotData().numPlots() != 1 ||
+                !dynamic_cast<CandlestickPlot*>(linkedSubplot.jointPlotData().plotVector()[0].get()))
+            {
+                throw std::invalid_argument("The streamed linked subplot no longer contains a single candlestick plot.");
+            }
+
+            if (updates.hasLastCandleUpdate)
+            {
+                const CandleUpdate& last = updates.lastCandleUpdate;
+                linkedSubplot.updateLastCandle(last.open, last.high, last.low, last.close);
+            }
+
+            if (!updates.open.empty())
+            {
+                OptionalDateVector dates = std::nullopt;
+
+                if (!updates.datesEpochNs.empty())
+                {
+                    dates = EpochNsVector(updates.datesEpochNs.data(), updates.datesEpochNs.size());
+                }
+
+                linkedSubplot.appendCandles(
+                    updates.open.data(), updates.high.data(), updates.low.data(), updates.close.data(),
+                    updates.open.size(), dates
+                );
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "WARNING: streamed candles could not be plotted: " << e.what() << std::endl;
+        }
+
+        updates.clear();
+    }
 }
 
 
 void CentralOpenGlWidget::resizeGL(int width, int height)
 {
+    m_plotLayerDirty = true;
+
     m_rm->updateWindowSize(width, height);
     m_gl->glViewport(0, 0, width, height);
     const qreal dpr = devicePixelRatio();
@@ -164,6 +387,7 @@ void CentralOpenGlWidget::keyPressEvent(QKeyEvent *event)
  */
 {
     m_keyStates[event->key()] = true;
+    m_plotLayerDirty = true;
 
     if (!m_timer->isActive())
     {
@@ -7,9 +7,13 @@
 #include <qmainwindow.h>
 #include <QObject>
 #include <QMetaObject>
+#include <chrono>
+#include <optional>
 #include <queue>
 
+#include "PlotLayerCache.h"
 #include "RenderManager.h"
+#include "UpdateQueue.h"
 
 
 class CentralOpenGlWidget : public QOpenGLWidget
@@ -19,6 +23,7 @@ class CentralOpenGlWidget : public QOpenGLWidget
 
 public:
     CentralOpenGlWidget(QWidget *parent, Configs& configs);
+    ~CentralOpenGlWidget() override;
 
     CentralOpenGlWidget(const CentralOpenGlWidget&) = delete;
     CentralOpenGlWidget& operator=(const CentralOpenGlWidget&) = delete;
@@ -36,6 +41,14 @@ public:
 
     QSize getMainwindowSize();
 
+    void markPlotLayerDirty();
+
+    std::shared_ptr<UpdateQueue> updateQueue();
+
+    // End of the first frame drawn, and its CPU time, for Plotter::startupStats()
+    std::optional<std::chrono::steady_clock::time_point> firstFrameTime() const { return m_firstFrameTime; };
+    double firstFrameDrawMs() const { return m_firstFrameDrawMs; };
+
     std::unique_ptr<RenderManager> m_rm;
     Configs& m_configs;
 
@@ -75,6 +88,30 @@ private:
 
     std::queue<std::function<void()>> m_paintGlQueue;    
 
+    // Cached render of the plots, so overlay-only frames (crosshair,
+    // hover popup) do not re-draw the plots, see paintPlotLayer().
+    std::unique_ptr<PlotLayerCache> m_plotLayerCache;
+    std::vector<double> m_plotLayerState;
+    bool m_plotLayerDirty = true;
+
+    void paintPlotLayer();
+
+    // Candles streamed from other threads (see CandleStream), polled
+    // by m_updateQueueTimer and drained once per frame in paintGL.
+    std::shared_ptr<UpdateQueue> m_updateQueue;
+    QTimer* m_updateQueueTimer = nullptr;
+    std::map<int, CoalescedCandleUpdates> m_drainedUpdates;
+
+    void applyQueuedUpdates();
+
+    // Idle-time GL work (see DeferredWorkQueue), run in slices after frames are drawn
+    bool m_deferredWorkScheduled = false;
+    void scheduleDeferredWork();
+    void runDeferredWork();
+
+    std::optional<std::chrono::steady_clock::time_point> m_firstFrameTime = std::nullopt;
+    double m_firstFrameDrawMs = 0.0;
+
     void onFrameSwapped();
 
     void initializeGL() override;
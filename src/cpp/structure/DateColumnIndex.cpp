@@ -0,0 +1,109 @@
+#include "DateColumnIndex.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+void DateColumnIndex::reset(EpochNsVector dates)
+/*
+    Index a new date column. Nothing is computed until the first lookup.
+ */
+{
+    m_dates = dates;
+    m_sorted = std::nullopt;
+    m_unsortedIndex = std::nullopt;
+}
+
+
+void DateColumnIndex::append(EpochNsVector dates)
+/*
+    `dates` is the full column after new dates were appended to the end of
+    the previous column (it may have been reallocated). Only the new dates
+    are checked / hashed, so streaming appends are O(1) amortised per date.
+ */
+{
+    std::size_t numExisting = m_dates.size();
+
+    if (dates.size() < numExisting)
+    {
+        throw std::runtime_error("CRITICAL ERROR: appended date column is smaller than the existing column.");
+    }
+
+    m_dates = dates;
+
+    const std::int64_t* data = m_dates.data();
+
+    if (m_sorted.value_or(false))
+    {
+        for (std::size_t i = std::max<std::size_t>(numExisting, 1); i < m_dates.size(); i++)
+        {
+            if (data[i] < data[i - 1])
+            {
+                m_sorted = false;
+                break;
+            }
+        }
+    }
+
+    if (m_unsortedIndex.has_value())
+    {
+        for (std::size_t i = numExisting; i < m_dates.size(); i++)
+        {
+            m_unsortedIndex.value().emplace(data[i], (int)i);
+        }
+    }
+}
+
+
+int DateColumnIndex::asOfIndex(std::int64_t epochNs) const
+/*
+    Return the index of the last date at or before `epochNs`. Throws if
+    `epochNs` is before the first date (or, for an unsorted column, is not
+    in the column). A repeated date resolves to its first occurrence, as
+    for string dates.
+ */
+{
+    const std::int64_t* first = m_dates.begin();
+    const std::int64_t* last = m_dates.end();
+
+    if (isSorted())
+    {
+        const std::int64_t* it = std::upper_bound(first, last, epochNs);
+
+        if (it == first)
+        {
+            throw std::runtime_error("Datetime is before the first datetime on the x-axis.");
+        }
+        return (int)(std::lower_bound(first, it, *(it - 1)) - first);
+    }
+
+    if (!m_unsortedIndex.has_value())
+    {
+        std::unordered_map<std::int64_t, int> index;
+        index.reserve(m_dates.size());
+
+        // Keep the first occurrence of a repeated date
+        for (std::size_t i = 0; i < m_dates.size(); i++)
+        {
+            index.emplace(first[i], (int)i);
+        }
+        m_unsortedIndex = std::move(index);
+    }
+
+    auto it = m_unsortedIndex.value().find(epochNs);
+
+    if (it == m_unsortedIndex.value().end())
+    {
+        throw std::runtime_error("Scatterplot datetime not found in x-axis labels.");
+    }
+    return it->second;
+}
+
+
+bool DateColumnIndex::isSorted() const
+{
+    if (!m_sorted.has_value())
+    {
+        m_sorted = std::is_sorted(m_dates.begin(), m_dates.end());
+    }
+    return m_sorted.value();
+}
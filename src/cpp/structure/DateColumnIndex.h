@@ -0,0 +1,47 @@
+#ifndef DATECOLUMNINDEX_H
+#define DATECOLUMNINDEX_H
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include "../include/Plotter.h"
+
+
+class DateColumnIndex
+/*
+    Lookup of the x-axis index of a datetime (int64 ns since the epoch)
+    in a date column, without copying the column.
+
+    Datetime axes are almost always sorted, in which case the column itself
+    is binary searched and nothing is stored. Whether the column is sorted is
+    checked (one pass, no allocation) on the first lookup and then maintained
+    on append. Only an unsorted column falls back to a hash of all dates.
+
+    Lookups are as-of: the index of the last date at or before the requested
+    date. For an unsorted column, only exact matches can be found.
+*/
+{
+
+public:
+    DateColumnIndex() = default;
+
+    DateColumnIndex(const DateColumnIndex&) = delete;
+    DateColumnIndex& operator=(const DateColumnIndex&) = delete;
+    DateColumnIndex(DateColumnIndex&&) = delete;
+    DateColumnIndex& operator=(DateColumnIndex&&) = delete;
+
+    void reset(EpochNsVector dates);
+    void append(EpochNsVector dates);
+
+    int asOfIndex(std::int64_t epochNs) const;
+
+private:
+    bool isSorted() const;
+
+    EpochNsVector m_dates;
+
+    mutable std::optional<bool> m_sorted = std::nullopt;
+    mutable std::optional<std::unordered_map<std::int64_t, int>> m_unsortedIndex = std::nullopt;
+};
+
+#endif // DATECOLUMNINDEX_H
@@ -0,0 +1,57 @@
+#include "DeferredWorkQueue.h"
+#include <algorithm>
+
+
+void DeferredWorkQueue::post(const void* owner, std::function<void()> task)
+{
+    m_tasks.push_back(Task{owner, std::move(task)});
+    m_doneTime = std::nullopt;
+}
+
+
+void DeferredWorkQueue::cancel(const void* owner)
+{
+    m_tasks.erase(
+        std::remove_if(m_tasks.begin(), m_tasks.end(), [owner](const Task& task) { return task.owner == owner; }),
+        m_tasks.end()
+    );
+}
+
+
+bool DeferredWorkQueue::runFor(double budgetMs)
+/*
+    Run tasks until the budget is used. At least one task is run, so a
+    task longer than the budget still progresses. Returns `true` if
+    tasks remain.
+ */
+{
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start = Clock::now();
+    double elapsedMs = 0.0;
+
+    while (!m_tasks.empty())
+    {
+        // Popped before running, a task may post or cancel tasks
+        Task task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        task.run();
+
+        elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (elapsedMs >= budgetMs)
+        {
+            break;
+        }
+    }
+
+    m_totalRunMs += elapsedMs;
+
+    if (m_tasks.empty())
+    {
+        m_doneTime = Clock::now();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef DEFERREDWORKQUEUE_H
+#define DEFERREDWORKQUEUE_H
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <optional>
+
+
+class DeferredWorkQueue
+/*
+    GL work that is not needed to draw the current view, done when the GUI
+    thread is idle rather than when a plot is added. For example, when the whole
+    dataset is in view only a coarse LOD level of the candles is drawn, so the
+    finer levels (and the full-resolution candles) are uploaded after the first
+    frame is shown, so it is not held up by uploading data it does not draw.
+
+    Tasks are run in order (owners post them coarse-first, so detail fills in
+    progressively) after a frame is drawn, in slices of at most `sliceBudgetMs`
+    so the window stays responsive (see CentralOpenGlWidget::runDeferredWork()).
+    They run on the GUI thread with the context current.
+
+    Work needed to draw a frame is never waited for, the owner does it on demand
+    when drawing (the posted task then finds nothing to do). Owners must cancel
+    their tasks when destroyed.
+ */
+{
+
+public:
+    DeferredWorkQueue() = default;
+
+    DeferredWorkQueue(const DeferredWorkQueue&) = delete;
+    DeferredWorkQueue& operator=(const DeferredWorkQueue&) = delete;
+    DeferredWorkQueue(DeferredWorkQueue&&) = delete;
+    DeferredWorkQueue& operator=(DeferredWorkQueue&&) = delete;
+
+    void post(const void* owner, std::function<void()> task);
+    void cancel(const void* owner);
+
+    bool runFor(double budgetMs);
+    bool empty() const { return m_tasks.empty(); };
+
+    double totalRunMs() const { return m_totalRunMs; };
+    std::optional<std::chrono::steady_clock::time_point> doneTime() const { return m_doneTime; };
+
+    static constexpr double sliceBudgetMs = 8.0;
+
+private:
+
+    struct Task
+    {
+        const void* owner;
+        std::function<void()> run;
+    };
+
+    std::deque<Task> m_tasks;
+
+    double m_totalRunMs = 0.0;
+    std::optional<std::chrono::steady_clock::time_point> m_doneTime = std::nullopt;  // last time the queue was emptied by runFor()
+};
+
+#endif // DEFERREDWORKQUEUE_H
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include "FrameProfiler.h"
+
+
+namespace
+{
+    std::int64_t steadyNowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    double percentile(std::vector<double>& sortedValues, double p)
+    /*
+        Nearest-rank percentile of already sorted values.
+     */
+    {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sortedValues.size()));
+        return sortedValues[std::clamp<std::size_t>(rank, 1, sortedValues.size()) - 1];
+    }
+
+    constexpr std::size_t numStages = static_cast<std::size_t>(ProfileStage::numStages);
+    constexpr GLsizei queryBlockSize = 64;
+}
+
+
+FrameProfiler::FrameProfiler(QOpenGLFunctions_3_3_Core& glFunctions)
+    : m_gl(glFunctions)
+{
+}
+
+
+FrameProfiler::~FrameProfiler()
+{
+    if (!m_allQueries.empty())
+    {
+        m_gl.glDeleteQueries(static_cast<GLsizei>(m_allQueries.size()), m_allQueries.data());
+    }
+}
+
+
+const char* FrameProfiler::stageName(ProfileStage stage)
+{
+    switch (stage)
+    {
+    case ProfileStage::frame: return "frame";
+    case ProfileStage::plotLayer: return "plotLayer";
+    case ProfileStage::axes: return "axes";
+    case ProfileStage::ticks: return "ticks";
+    case ProfileStage::tickLabels: return "tickLabels";
+    case ProfileStage::candlestickPlot: return "candlestickPlot";
+    case ProfileStage::linePlot: return "linePlot";
+    case ProfileStage::barPlot: return "barPlot";
+    case ProfileStage::scatterPlot: return "scatterPlot";
+    case ProfileStage::drawLines: return "drawLines";
+    case ProfileStage::legend: return "legend";
+    case ProfileStage::pinnedYLimits: return "pinnedYLimits";
+    case ProfileStage::overlays: return "overlays";
+    default:
+        throw std::runtime_error("CRITICAL ERROR: ProfileStage not recognised.");
+    }
+}
+
+
+void FrameProfiler::setEnabled(bool enabled)
+/*
+    Enabling clears any previously recorded frames. Frames still waiting
+    on the GPU are discarded, their queries are re-used.
+ */
+{
+    if (enabled && !m_enabled)
+    {
+        if (m_records.empty())
+        {
+            m_records.resize(numFrameRecords);
+        }
+        m_numRecorded = 0;
+        discardInFlightFrames();
+    }
+    m_enabled = enabled;
+}
+
+
+/* --------------------------------------------------------------
+    Recording
+ --------------------------------------------------------------*/
+
+void FrameProfiler::beginFrame()
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    // A frame that did not end (e.g. an exception was thrown while drawing) is dropped.
+    if (m_inFrame)
+    {
+        releaseQueries(currentFrame());
+        currentFrame().events.clear();
+        m_inFrame = false;
+    }
+
+    resolveFrames(false);
+
+    if (m_numInFlight == maxFramesInFlight)
+    {
+        resolveFrames(true);
+    }
+
+    m_inFrame = true;
+    beginStage(ProfileStage::frame);
+}
+
+
+void FrameProfiler::endFrame()
+{
+    if (!m_inFrame)
+    {
+        return;
+    }
+
+    endStage(0);
+
+    m_inFrame = false;
+    m_numInFlight += 1;
+}
+
+
+int FrameProfiler::beginStage(ProfileStage stage)
+/*
+    Returns the index of the stage event in the current frame, to pass
+    to endStage(), or -1 if outside of a frame (nothing is recorded).
+ */
+{
+    if (!m_inFrame)
+    {
+        return -1;
+    }
+
+    std::vector<Event>& events = currentFrame().events;
+
+    events.push_back(Event{stage, steadyNowNs(), 0, acquireQuery(), acquireQuery(), 0, 0});
+    m_gl.glQueryCounter(events.back().gpuStartQuery, GL_TIMESTAMP);
+
+    return static_cast<int>(events.size() - 1);
+}
+
+
+void FrameProfiler::endStage(int eventIdx)
+{
+    if (!m_inFrame)
+    {
+        return;
+    }
+
+    Event& event = currentFrame().events[eventIdx];
+
+    m_gl.glQueryCounter(event.gpuEndQuery, GL_TIMESTAMP);
+    event.cpuEndNs = steadyNowNs();
+}
+
+
+FrameProfiler::FrameRecord& FrameProfiler::currentFrame()
+{
+    return m_inFlight[(m_inFlightStart + m_numInFlight) % maxFramesInFlight];
+}
+
+
+GLuint FrameProfiler::acquireQuery()
+{
+    if (m_freeQueries.empty())
+    {
+        std::size_t start = m_allQueries.size();
+        m_allQueries.resize(start + queryBlockSize);
+        m_gl.glGenQueries(queryBlockSize, m_allQueries.data() + start);
+        m_freeQueries.insert(m_freeQueries.end(), m_allQueries.begin() + start, m_allQueries.end());
+    }
+
+    GLuint query = m_freeQueries.back();
+    m_freeQueries.pop_back();
+    return query;
+}
+
+
+void FrameProfiler::releaseQueries(FrameRecord& frame)
+{
+    for (const Event& event : frame.events)
+    {
+        m_freeQueries.push_back(event.gpuStartQuery);
+        m_freeQueries.push_back(event.gpuEndQuery);
+    }
+}
+
+
+void FrameProfiler::resolveFrames(bool waitForOldest)
+/*
+    Move in-flight frames whose GPU queries have completed to the records.
+    Queries complete in order, so a frame is complete once the end of its
+    frame event is. If `waitForOldest`, the oldest frame is read (blocking
+    until the GPU reaches it) and no others.
+ */
+{
+    while (m_numInFlight > 0)
+    {
+        FrameRecord& frame = m_inFlight[m_inFlightStart];
+
+        if (!waitForOldest)
+        {
+            GLuint available = 0;
+            m_gl.glGetQueryObjectuiv(frame.events[0].gpuEndQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+
+            if (!available)
+            {
+                return;
+            }
+        }
+
+        for (Event& event : frame.events)
+        {
+            GLuint64 startNs = 0;
+            GLuint64 endNs = 0;
+            m_gl.glGetQueryObjectui64v(event.gpuStartQuery, GL_QUERY_RESULT, &startNs);
+            m_gl.glGetQueryObjectui64v(event.gpuEndQuery, GL_QUERY_RESULT, &endNs);
+            event.gpuStartNs = startNs;
+            event.gpuEndNs = endNs;
+        }
+        releaseQueries(frame);
+
+        FrameRecord& record = m_records[m_numRecorded % numFrameRecords];
+        std::swap(record.events, frame.events);
+        frame.events.clear();
+        m_numRecorded += 1;
+
+        m_inFlightStart = (m_inFlightStart + 1) % maxFramesInFlight;
+        m_numInFlight -= 1;
+
+        if (waitForOldest)
+        {
+            return;
+        }
+    }
+}
+
+
+void FrameProfiler::discardInFlightFrames()
+{
+    for (std::size_t i = 0; i < m_numInFlight; i++)
+    {
+        FrameRecord& frame = m_inFlight[(m_inFlightStart + i) % maxFramesInFlight];
+        releaseQueries(frame);
+        frame.events.clear();
+    }
+    m_inFlightStart = 0;
+    m_numInFlight = 0;
+}
+
+
+/* --------------------------------------------------------------
+    Reporting
+ --------------------------------------------------------------*/
+
+std::vector<ProfilerStageStats> FrameProfiler::stats() const
+/*
+    Percentiles of the per-frame time of each stage, over the recorded
+    frames in which the stage was drawn. Stages drawn more than once
+    in a frame (e.g. the axes of each linked subplot) are summed.
+ */
+{
+    std::size_t numFrames = std::min(m_numRecorded, numFrameRecords);
+
+    std::array<std::vector<double>, numStages> cpuMs;
+    std::array<std::vector<double>, numStages> gpuMs;
+
+    for (std::size_t i = 0; i < numFrames; i++)
+    {
+        std::array<double, numStages> frameCpuMs{};
+        std::array<double, numStages> frameGpuMs{};
+        std::array<bool, numStages> drawn{};
+
+        for (const Event& event : m_records[i].events)
+        {
+            std::size_t stageIdx = static_cast<std::size_t>(event.stage);
+
+            frameCpuMs[stageIdx] += (event.cpuEndNs - event.cpuStartNs) / 1e6;
+            frameGpuMs[stageIdx] += (event.gpuEndNs - event.gpuStartNs) / 1e6;
+            drawn[stageIdx] = true;
+        }
+
+        for (std::size_t stageIdx = 0; stageIdx < numStages; stageIdx++)
+        {
+            if (drawn[stageIdx])
+            {
+                cpuMs[stageIdx].push_back(frameCpuMs[stageIdx]);
+                gpuMs[stageIdx].push_back(frameGpuMs[stageIdx]);
+            }
+        }
+    }
+
+    std::vector<ProfilerStageStats> stageStats;
+
+    for (std::size_t stageIdx = 0; stageIdx < numStages; stageIdx++)
+    {
+        if (cpuMs[stageIdx].empty())
+        {
+            continue;
+        }
+
+        std::sort(cpuMs[stageIdx].begin(), cpuMs[stageIdx].end());
+        std::sort(gpuMs[stageIdx].begin(), gpuMs[stageIdx].end());
+
+        stageStats.push_back(ProfilerStageStats{
+            stageName(static_cast<ProfileStage>(stageIdx)),
+            cpuMs[stageIdx].size(),
+            percentile(cpuMs[stageIdx], 50.0),
+            percentile(cpuMs[stageIdx], 95.0),
+            percentile(cpuMs[stageIdx], 99.0),
+            percentile(gpuMs[stageIdx], 50.0),
+            percentile(gpuMs[stageIdx], 95.0),
+            percentile(gpuMs[stageIdx], 99.0)
+        });
+    }
+
+    return stageStats;
+}
+
+
+std::string FrameProfiler::chromeTrace() const
+/*
+    The recorded frames in the Chrome trace event format (chrome://tracing,
+    Perfetto). CPU stages are on thread 1 and GPU stages on thread 2. The
+    GPU clock is not the CPU clock, so GPU stages are placed relative to
+    the start of their frame on the CPU. Times are in microseconds from
+    the start of the oldest recorded frame.
+ */
+{
+    std::size_t numFrames = std::min(m_numRecorded, numFrameRecords);
+    std::size_t oldest = (m_numRecorded > numFrameRecords) ? m_numRecorded % numFrameRecords : 0;
+
+    std::ostringstream trace;
+    trace << std::fixed << std::setprecision(3);
+
+    trace << "{\"traceEvents\":[\n"
+          << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+          << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+    std::int64_t traceStartNs = (numFrames > 0) ? m_records[oldest].events[0].cpuStartNs : 0;
+
+    for (std::size_t i = 0; i < numFrames; i++)
+    {
+        const std::vector<Event>& events = m_records[(oldest + i) % numFrameRecords].events;
+
+        const Event& frame = events[0];
+        double frameStartUs = (frame.cpuStartNs - traceStartNs) / 1e3;
+
+        for (const Event& event : events)
+        {
+            const char* name = stageName(event.stage);
+
+            trace << ",\n{\"name\":\"" << name << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+                  << ",\"ts\":" << (event.cpuStartNs - traceStartNs) / 1e3
+                  << ",\"dur\":" << (event.cpuEndNs - event.cpuStartNs) / 1e3 << "}";
+
+            trace << ",\n{\"name\":\"" << name << "\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":2"
+                  << ",\"ts\":" << frameStartUs + static_cast<std::int64_t>(event.gpuStartNs - frame.gpuStartNs) / 1e3
+                  << ",\"dur\":" << (event.gpuEndNs - event.gpuStartNs) / 1e3 << "}";
+        }
+    }
+
+    trace << "\n]}\n";
+
+    return trace.str();
+}
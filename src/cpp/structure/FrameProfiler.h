@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <QOpenGLFunctions_3_3_Core>
+#include "../include/Plotter.h"
+
+
+enum class ProfileStage
+/*
+    The parts of a frame that are timed, see FrameProfiler.
+ */
+{
+    frame,
+    plotLayer,
+    axes,
+    ticks,
+    tickLabels,
+    candlestickPlot,
+    linePlot,
+    barPlot,
+    scatterPlot,
+    drawLines,
+    legend,
+    pinnedYLimits,
+    overlays,
+    numStages
+};
+
+
+class FrameProfiler
+/*
+    Record the CPU and GPU time of each stage of the frames drawn by
+    a CentralOpenGlWidget (see ProfileScope for marking a stage).
+
+    CPU time is taken from a steady clock. GPU time is taken from pairs of
+    GL_TIMESTAMP queries around the stage, rather than GL_TIME_ELAPSED, as
+    elapsed-time queries cannot be nested (e.g. tick labels inside the frame).
+    Query results are read a few frames later, once available, so the
+    profiler never stalls the pipeline (unless `maxFramesInFlight` frames
+    are still waiting on the GPU).
+
+    Completed frames are written to a fixed-size ring of records. The
+    event vectors are swapped between the in-flight frames and the ring, so
+    once warmed up no memory is allocated and nothing is locked. Everything
+    runs on the GUI thread. When disabled, each stage costs a flag check.
+*/
+{
+
+public:
+    FrameProfiler(QOpenGLFunctions_3_3_Core& glFunctions);
+    ~FrameProfiler();
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+    FrameProfiler(FrameProfiler&&) = delete;
+    FrameProfiler& operator=(FrameProfiler&&) = delete;
+
+    void setEnabled(bool enabled);
+    bool enabled() const { return m_enabled; };
+
+    void beginFrame();
+    void endFrame();
+
+    int beginStage(ProfileStage stage);
+    void endStage(int eventIdx);
+
+    std::vector<ProfilerStageStats> stats() const;
+    std::string chromeTrace() const;
+
+    static const char* stageName(ProfileStage stage);
+
+    static constexpr std::size_t numFrameRecords = 512;
+    static constexpr std::size_t maxFramesInFlight = 4;
+
+private:
+
+    struct Event
+    {
+        ProfileStage stage;
+        std::int64_t cpuStartNs;
+        std::int64_t cpuEndNs;
+        GLuint gpuStartQuery;
+        GLuint gpuEndQuery;
+        std::uint64_t gpuStartNs;
+        std::uint64_t gpuEndNs;
+    };
+
+    struct FrameRecord
+    {
+        std::vector<Event> events;  // events[0] is the whole frame
+    };
+
+    QOpenGLFunctions_3_3_Core& m_gl;
+
+    bool m_enabled = false;
+    bool m_inFrame = false;
+
+    // Frames waiting on their GPU query results, oldest at m_inFlightStart.
+    std::array<FrameRecord, maxFramesInFlight> m_inFlight;
+    std::size_t m_inFlightStart = 0;
+    std::size_t m_numInFlight = 0;
+
+    // Ring of completed frames, allocated when first enabled.
+    std::vector<FrameRecord> m_records;
+    std::size_t m_numRecorded = 0;
+
+    std::vector<GLuint> m_freeQueries;
+    std::vector<GLuint> m_allQueries;
+
+    FrameRecord& currentFrame();
+    GLuint acquireQuery();
+    void releaseQueries(FrameRecord& frame);
+    void resolveFrames(bool waitForOldest);
+    void discardInFlightFrames();
+};
+
+
+class ProfileScope
+/*
+    Time the enclosing scope as `stage` of the current frame.
+ */
+{
+
+public:
+    ProfileScope(FrameProfiler& profiler, ProfileStage stage)
+        : m_profiler(profiler),
+          m_eventIdx(profiler.enabled() ? profiler.beginStage(stage) : -1)
+    {
+    };
+
+    ~ProfileScope()
+    {
+        if (m_eventIdx >= 0)
+        {
+            m_profiler.endStage(m_eventIdx);
+        }
+    };
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    ProfileScope(ProfileScope&&) = delete;
+    ProfileScope& operator=(ProfileScope&&) = delete;
+
+private:
+    FrameProfiler& m_profiler;
+    int m_eventIdx;
+};
@@ -1,25 +1,31 @@
 #include "JointPlotData.h"
 #include "LinkedSubplot.h"
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include "../charts/plots/BasePlot.h"
 #include "../charts/plots/CandlestickPlot.h"
 #include "../charts/Camera.h"
 #include "../charts/plots/ScatterPlot.h"
+#include "../ParallelFor.h"
 
 
-JointPlotData::JointPlotData(const LinkedSubplot& subplot)
-    : m_sp(subplot),
-    m_minVector(m_computedMinVector.data(), m_computedMinVector.size()),
+JointPlotData::JointPlotData()
+    : m_minVector(m_computedMinVector.data(), m_computedMinVector.size()),
     m_maxVector(m_computedMaxVector.data(), m_computedMaxVector.size())
 {}
 
 
-void JointPlotData::addPlot(std::unique_ptr<BasePlot> plot)
+void JointPlotData::addPlot(std::unique_ptr<BasePlot> plot, std::optional<PrecomputedBlockMinMax> blockMinMax)
 /*
     Add a plot. As it is enforced all x-axis
     must be exactly the same as the axis is shared
     on all plots, this is checked here.
+
+    `blockMinMax` optionally holds the precomputed min / max of each block
+    of the plot's min / max vectors (see RangeMinMaxIndex), used if this
+    is the only plot so the y-range state is set up without a data scan.
  */
 {
     if (!isEmpty())
@@ -36,7 +42,7 @@ void JointPlotData::addPlot(std::unique_ptr<BasePlot> plot)
 
     m_plotVector.push_back(std::move(plot));
 
-    recomputeMinMax();
+    recomputeMinMax(blockMinMax);
 }
 
 
@@ -58,7 +64,7 @@ MinMaxVectorType JointPlotData::getMinMaxVector(const std::unique_ptr<BasePlot>&
 
 
 
-void JointPlotData::recomputeMinMax()
+void JointPlotData::recomputeMinMax(const std::optional<PrecomputedBlockMinMax>& blockMinMax)
 /*
     The min / max value across all shared plots as separate vectors `m_computedMinVector`, `m_computedMaxVector`.
     This is used to pin the y-axis to the min / max value shown on the graph.
@@ -71,6 +77,21 @@ void JointPlotData::recomputeMinMax()
     {
         m_minVector = firstPlotMinMax.first;
         m_maxVector = firstPlotMinMax.second;
+
+        if (blockMinMax.has_value())
+        {
+            m_minValue = (double)*std::min_element(blockMinMax->blockMin.begin(), blockMinMax->blockMin.end());
+            m_maxValue = (double)*std::max_element(blockMinMax->blockMax.begin(), blockMinMax->blockMax.end());
+
+            if (m_minValue > m_maxValue)  // all NaN
+            {
+                m_minValue = std::numeric_limits<double>::quiet_NaN();
+                m_maxValue = std::numeric_limits<double>::quiet_NaN();
+            }
+
+            m_rangeMinMaxIndex.build(m_minVector, m_maxVector, blockMinMax.value());
+            return;
+        }
     }
     else
     {
@@ -88,11 +109,14 @@ void JointPlotData::recomputeMinMax()
         const StdPtrVector<float>& firstMin = firstPlotMinMax.first;
         const StdPtrVector<float>& firstMax =  firstPlotMinMax.second;
 
-        for (int i = 0; i < numDataPoints; i++)
+        parallelFor(numDataPoints, parallelChunkSize, [&](std::size_t chunkStart, std::size_t chunkEnd)
         {
-            m_computedMinVector[i] = firstMin[i];
-            m_computedMaxVector[i] = firstMax[i];
-        }
+            for (std::size_t i = chunkStart; i < chunkEnd; i++)
+            {
+                m_computedMinVector[i] = firstMin[i];
+                m_computedMaxVector[i] = firstMax[i];
+            }
+        });
 
         // Update computedMin/Max vectors based on the values of all other plots.
         for (int plotIdx = 1; plotIdx < m_plotVector.size(); plotIdx++)
@@ -126,17 +150,20 @@ void JointPlotData::recomputeMinMax()
                 const StdPtrVector<float>& minVector = minMaxVectors.first;
                 const StdPtrVector<float>& maxVector = minMaxVectors.second;
 
-                for (int i = 0; i < numDataPoints; i++)
+                parallelFor(numDataPoints, parallelChunkSize, [&](std::size_t chunkStart, std::size_t chunkEnd)
                 {
-                    if (minVector[i] < m_computedMinVector[i] || std::isnan(m_computedMinVector[i]))
+                    for (std::size_t i = chunkStart; i < chunkEnd; i++)
                     {
-                        m_computedMinVector[i] = minVector[i];
+                        if (minVector[i] < m_computedMinVector[i] || std::isnan(m_computedMinVector[i]))
+                        {
+                            m_computedMinVector[i] = minVector[i];
+                        }
+                        if (maxVector[i] > m_computedMaxVector[i] || std::isnan(m_computedMaxVector[i]))
+                        {
+                            m_computedMaxVector[i] = maxVector[i];
+                        }
                     }
-                    if (maxVector[i] > m_computedMaxVector[i] || std::isnan(m_computedMaxVector[i]))
-                    {
-                        m_computedMaxVector[i] = maxVector[i];
-                    }
-                }
+                });
             }
         }
 
@@ -144,14 +171,62 @@ void JointPlotData::recomputeMinMax()
         m_maxVector = StdPtrVector<float>(m_computedMaxVector.data(), m_computedMaxVector.size());
     }
 
-    m_minValue = (double)*std::min_element(m_minVector.begin(), m_minVector.end());
-    m_maxValue = (double)*std::max_element(m_maxVector.begin(), m_maxVector.end());
+    // The index scans the data once (across threads), the min / max are read from its blocks
+    m_rangeMinMaxIndex.build(m_minVector, m_maxVector);
+
+    std::pair<float, float> minMax = m_rangeMinMaxIndex.getMinMax();
+    m_minValue = (double)minMax.first;
+    m_maxValue = (double)minMax.second;
 }
 
 
-void JointPlotData::draw(glm::mat4& NDCMatrix, Camera& camera)
+void JointPlotData::updateMinMaxFromIndex(int firstChangedIdx)
 /*
-    Draw every plot attached to the JointPlotData.
+    Incrementally update the min / max state after the plot has been
+    streamed to (candles appended or the last candle updated). Only
+    datapoints from `firstChangedIdx` onwards are touched, so the cost is
+    proportional to the number of changed datapoints, not the plot size.
+
+    Streaming is only supported on a linked subplot with a single plot (see
+    LinkedSubplot::appendCandles) so the min / max vectors are the plot data.
+    The global min / max are only ever widened here. If an updated candle
+    shrinks they remain a conservative bound rather than triggering a rescan.
+ */
+{
+    if (m_plotVector.size() != 1)
+    {
+        throw std::runtime_error("CRITICAL ERROR: streamed min / max update requires a single plot.");
+    }
+
+    // The underlying data may have been reallocated
+    MinMaxVectorType firstPlotMinMax = getMinMaxVector(m_plotVector[0]);
+
+    m_minVector = firstPlotMinMax.first;
+    m_maxVector = firstPlotMinMax.second;
+
+    m_rangeMinMaxIndex.update(m_minVector, m_maxVector, firstChangedIdx);
+
+    // The index skips NaN, which is NaN only if all the changed datapoints are
+    std::pair<float, float> changedMinMax = m_rangeMinMaxIndex.getMinMax(firstChangedIdx, m_minVector.size());
+
+    if (!std::isnan(changedMinMax.first))
+    {
+        if (std::isnan(m_minValue) || changedMinMax.first < m_minValue)
+        {
+            m_minValue = (double)changedMinMax.first;
+        }
+        if (std::isnan(m_maxValue) || changedMinMax.second > m_maxValue)
+        {
+            m_maxValue = (double)changedMinMax.second;
+        }
+    }
+}
+
+
+void JointPlotData::draw(glm::mat4& NDCMatrix, Camera& camera, FrameProfiler& profiler)
+/*
+    Draw every plot attached to the JointPlotData, each timed
+    as its plot type stage (see FrameProfiler).
  */
 {
     if (m_plotVector.empty())
@@ -164,6 +239,7 @@ void JointPlotData::draw(glm::mat4& NDCMatrix, Camera& camera)
     // to appear on top of plots at the start.
     for (int i = m_plotVector.size() - 1; i >= 0; i--)
     {
+        ProfileScope scope(profiler, m_plotVector[i]->profileStage());
         m_plotVector[i]->draw(NDCMatrix, camera);
     }
 }
@@ -258,25 +334,19 @@ std::tuple<double, double> JointPlotData::getMinMaxInViewRange(double leftBorder
     if (startIdx < 0)
         startIdx = 0;
 
-    if (startIdx >= endIdx)
-    {
-        return {0.0, 0.0};
-    }
-
     if (endIdx > m_plotVector[0]->getNumDatapoints())
     {
         endIdx = m_plotVector[0]->getNumDatapoints();
     }
 
-    double min, max;
-
-    // This is not very well optimised, if the first plot is not candlestick then
-    // m_minVector == m_maxVector (it is just the data) and we could use std::min_max_element
-    auto minValue = std::min_element(m_minVector.begin() + startIdx, m_minVector.begin() + endIdx);
-    auto maxValue = std::max_element(m_maxVector.begin() + startIdx, m_maxVector.begin() + endIdx);
+    if (startIdx >= endIdx)
+    {
+        return {0.0, 0.0};
+    }
 
-    min = (double)*minValue;
-    max = (double)*maxValue;
+    // Uses the range min / max index so the cost does not scale with the
+    // number of datapoints in view (this is called every frame when pinned).
+    std::pair<float, float> minMax = m_rangeMinMaxIndex.getMinMax(startIdx, endIdx);
 
-    return {min, max};
+    return {(double)minMax.first, (double)minMax.second};
 }
@@ -3,11 +3,10 @@
 
 #include "../charts/plots/BasePlot.h"
 #include "../charts/Camera.h"
+#include "RangeMinMaxIndex.h"
 
 using MinMaxVectorType = const std::pair<const StdPtrVector<float>&, const StdPtrVector<float>&>;
 
-class LinkedSubplot;  // forward declaration
-
 class JointPlotData
 /*
     This class coordinates the all plots shown on a subplot.
@@ -22,7 +21,7 @@ class JointPlotData
 {
 
 public:
-    JointPlotData(const LinkedSubplot& m_sp);
+    JointPlotData();
 
     JointPlotData(const JointPlotData&) = delete;
     JointPlotData& operator=(const JointPlotData&) = delete;
@@ -30,12 +29,13 @@ public:
     JointPlotData& operator=(JointPlotData&&) = delete;
 
     const std::vector<std::unique_ptr<BasePlot>>& plotVector() const { return m_plotVector; };
-    void addPlot(std::unique_ptr<BasePlot> plot);
+    void addPlot(std::unique_ptr<BasePlot> plot, std::optional<PrecomputedBlockMinMax> blockMinMax = std::nullopt);
+    void updateMinMaxFromIndex(int firstChangedIdx);
 
     bool isEmpty() const { return m_plotVector.empty(); }
     int numPlots() const { return m_plotVector.size(); }
 
-    void draw(glm::mat4& NDCMatrix, Camera& camera);
+    void draw(glm::mat4& NDCMatrix, Camera& camera, FrameProfiler& profiler);
 
     int getNumDatapoints() const;
     double getDelta() const;
@@ -53,7 +53,6 @@ public:
 private:
 
     std::vector<std::unique_ptr<BasePlot>> m_plotVector;
-    const LinkedSubplot& m_sp;
     // If we have only one plot, the min / max vector is just the
     // plot data itself. Otherwise, we need to compute this if we
     // are pinning the y-axis.
@@ -66,7 +65,12 @@ private:
     double m_minValue = 0;
     double m_maxValue = 0;
 
-    void recomputeMinMax();
+    // Fast min / max lookup over the visible range of m_minVector / m_maxVector
+    RangeMinMaxIndex m_rangeMinMaxIndex;
+
+    static constexpr std::size_t parallelChunkSize = 1 << 18;  // datapoints per thread, see recomputeMinMax()
+
+    void recomputeMinMax(const std::optional<PrecomputedBlockMinMax>& blockMinMax);
     MinMaxVectorType getMinMaxVector(const std::unique_ptr<BasePlot>& plot);
 };
 
@@ -31,7 +31,7 @@ LinkedSubplot::LinkedSubplot(
     m_sharedXData(sharedXData),
     m_gl(glFunctions),
     m_windowViewport(windowViewport),
-    m_JointPlotData(*this),
+    m_JointPlotData(),
     m_camera(configs, *this, windowViewport, m_JointPlotData),
     m_axisTickLabels(m_configs, *this, glFunctions),
     m_axesObject(configs, sharedXData, *this, glFunctions)
@@ -57,7 +57,10 @@ void LinkedSubplot::draw()
     // -----------------------------------------------------------------
 
     glm::mat4 viewportTransform = m_windowViewport.setForLinkedSubplotYAxis(m_yStartProportion, m_yHeightProportion);
-    m_axesObject.drawAxes(viewportTransform, "y");
+    {
+        ProfileScope scope(profiler(), ProfileStage::axes);
+        m_axesObject.drawAxes(viewportTransform, "y");
+    }
     m_axesObject.drawYAxesAndTicks(viewportTransform, NDCMatrix, m_yHeightProportion);
 
     // Draw the Plots within the restricted viewport (inside the axes)
@@ -66,10 +69,12 @@ void LinkedSubplot::draw()
 
     m_windowViewport.setForLinkedSubplotPlot(m_yStartProportion, m_yHeightProportion);
 
-    m_JointPlotData.draw(NDCMatrix, m_camera);
+    m_JointPlotData.draw(NDCMatrix, m_camera, profiler());
 
     if (m_drawLines.size() > 0)
     {
+        ProfileScope scope(profiler(), ProfileStage::drawLines);
+
         for (const std::unique_ptr<DrawLine>& linePlot : m_drawLines)
         {
             linePlot->draw(NDCMatrix, m_camera);
@@ -78,11 +83,30 @@ void LinkedSubplot::draw()
 
     if (m_legend)
     {
+        ProfileScope scope(profiler(), ProfileStage::legend);
         m_legend->draw(m_camera);
     }
 }
 
 
+FrameProfiler& LinkedSubplot::profiler()
+/*
+    The profiler is shared by all linked subplots of the RenderManager.
+ */
+{
+    return m_rm.m_profiler;
+}
+
+
+DeferredWorkQueue& LinkedSubplot::deferredWork()
+/*
+    The idle-time GL work of the RenderManager, shared like the profiler.
+ */
+{
+    return m_rm.m_deferredWork;
+}
+
+
 void LinkedSubplot::setupFirstPlot(int numElements)
 {
     m_camera.setupView();
@@ -100,7 +124,8 @@ void LinkedSubplot::candlestick(
     const float* lowPtr, std::size_t lowSize,
     const float* closePtr, std::size_t closeSize,
     OptionalDateVector dates,
-    BackendCandlestickSettings backendSettings
+    BackendCandlestickSettings backendSettings,
+    std::optional<PrecomputedBlockMinMax> blockMinMax
 )
 {
     if (dates.has_value())
@@ -120,7 +145,8 @@ void LinkedSubplot::candlestick(
     );
 
     m_JointPlotData.addPlot(
-        std::move(candlestick)
+        std::move(candlestick),
+        blockMinMax
     );
 
     if (m_JointPlotData.numPlots() == 1)
@@ -137,6 +163,61 @@ void LinkedSubplot::candlestick(
 }
 
 
+void LinkedSubplot::appendCandles(
+    const float* openPtr,
+    const float* highPtr,
+    const float* lowPtr,
+    const float* closePtr,
+    std::size_t size,
+    OptionalDateVector dates
+)
+/*
+    Stream new candles onto the (single) candlestick plot on this linked
+    subplot. Inputs are checked in Plotter. The camera is rescaled so the
+    x-axis normalisation does not cause the view to jump.
+*/
+{
+    CandlestickPlot* candlestickPlot = dynamic_cast<CandlestickPlot*>(m_JointPlotData.plotVector()[0].get());
+
+    int oldNumDatapoints = m_JointPlotData.getNumDatapoints();
+
+    if (dates.has_value())
+    {
+        m_sharedXData.appendXData(dates.value());
+    }
+
+    candlestickPlot->appendCandles(openPtr, highPtr, lowPtr, closePtr, size);
+
+    m_JointPlotData.updateMinMaxFromIndex(oldNumDatapoints);
+
+    int newNumDatapoints = m_JointPlotData.getNumDatapoints();
+
+    m_camera.rescaleXView(oldNumDatapoints, newNumDatapoints);
+    m_axesObject.initXTicks(newNumDatapoints);
+
+    m_camera.setYLimitsFromView();
+    if (m_linkedSubplotCameraSettings.yAxisLimitMode == YAxisMode::FixedAuto)
+    {
+        updateYAxisLimits();
+    }
+}
+
+
+void LinkedSubplot::updateLastCandle(float open, float high, float low, float close)
+{
+    CandlestickPlot* candlestickPlot = dynamic_cast<CandlestickPlot*>(m_JointPlotData.plotVector()[0].get());
+
+    candlestickPlot->updateLastCandle(open, high, low, close);
+
+    m_JointPlotData.updateMinMaxFromIndex(m_JointPlotData.getNumDatapoints() - 1);
+
+    if (m_linkedSubplotCameraSettings.yAxisLimitMode == YAxisMode::FixedAuto)
+    {
+        updateYAxisLimits();
+    }
+}
+
+
 /* Scatter Plot
 --------------------------------------------------------------------- */
 
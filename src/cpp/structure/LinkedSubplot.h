@@ -13,6 +13,7 @@
 #include "../charts/legend/Legend.h"
 
 class RenderManager;
+class DeferredWorkQueue;
 
 class LinkedSubplot
 {
@@ -48,9 +49,21 @@ public:
         const float* lowPtr, std::size_t lowSize,
         const float* closePtr, std::size_t closeSize,
         OptionalDateVector date,
-        BackendCandlestickSettings backendSettings
+        BackendCandlestickSettings backendSettings,
+        std::optional<PrecomputedBlockMinMax> blockMinMax = std::nullopt
     );
 
+    void appendCandles(
+        const float* openPtr,
+        const float* highPtr,
+        const float* lowPtr,
+        const float* closePtr,
+        std::size_t size,
+        OptionalDateVector dates
+    );
+
+    void updateLastCandle(float open, float high, float low, float close);
+
     void line(
         const float* yPtr, std::size_t ySize,
         OptionalDateVector date,
@@ -103,6 +116,8 @@ public:
     AxisTickLabels& axisTickLabels() { return m_axisTickLabels; };
     SharedXData& sharedXData() { return m_sharedXData; };
     const std::vector<std::unique_ptr<DrawLine>>& drawLines() { return m_drawLines; };
+    FrameProfiler& profiler();
+    DeferredWorkQueue& deferredWork();
 
     // hold the position of the subplot on the plot
     // as a proportion of  plot height
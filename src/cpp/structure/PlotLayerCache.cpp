@@ -0,0 +1,117 @@
+#include <iostream>
+#include "PlotLayerCache.h"
+
+
+PlotLayerCache::PlotLayerCache(QOpenGLFunctions_3_3_Core& glFunctions)
+    : m_gl(glFunctions)
+{
+}
+
+
+PlotLayerCache::~PlotLayerCache()
+{
+    destroy();
+}
+
+
+bool PlotLayerCache::bindForRender(int width, int height, int numSamples)
+/*
+    Bind the cache framebuffer to render the plot layer into, (re)creating
+    it if the widget framebuffer has changed size or sampling.
+
+    Returns false if the framebuffer could not be created, in which case
+    nothing is bound and the plot layer should be drawn directly.
+*/
+{
+    if (width != m_width || height != m_height || numSamples != m_numSamples || m_framebuffer == 0)
+    {
+        destroy();
+        create(width, height, numSamples);
+    }
+
+    if (!m_complete)
+    {
+        return false;
+    }
+
+    m_gl.glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+
+    return true;
+}
+
+
+void PlotLayerCache::blitTo(unsigned int targetFramebuffer)
+/*
+    Copy the cached plot layer into `targetFramebuffer`,
+    which is left bound for drawing the overlays.
+*/
+{
+    m_gl.glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    m_gl.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFramebuffer);
+
+    m_gl.glBlitFramebuffer(
+        0, 0, m_width, m_height,
+        0, 0, m_width, m_height,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST
+    );
+
+    m_gl.glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+}
+
+
+void PlotLayerCache::create(int width, int height, int numSamples)
+/*
+    Create the framebuffer with a color and depth renderbuffer (the
+    plots use depth testing). Renderbuffers rather than textures, as
+    the layer is only ever blitted and may be multisampled.
+*/
+{
+    m_width = width;
+    m_height = height;
+    m_numSamples = numSamples;
+
+    m_gl.glGenFramebuffers(1, &m_framebuffer);
+    m_gl.glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+
+    m_gl.glGenRenderbuffers(1, &m_colorRenderbuffer);
+    m_gl.glBindRenderbuffer(GL_RENDERBUFFER, m_colorRenderbuffer);
+    m_gl.glRenderbufferStorageMultisample(GL_RENDERBUFFER, numSamples, GL_RGBA8, width, height);
+    m_gl.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorRenderbuffer);
+
+    m_gl.glGenRenderbuffers(1, &m_depthRenderbuffer);
+    m_gl.glBindRenderbuffer(GL_RENDERBUFFER, m_depthRenderbuffer);
+    m_gl.glRenderbufferStorageMultisample(GL_RENDERBUFFER, numSamples, GL_DEPTH24_STENCIL8, width, height);
+    m_gl.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRenderbuffer);
+
+    m_complete = (m_gl.glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+    if (!m_complete)
+    {
+        std::cerr << "WARNING: Could not create the plot layer framebuffer, plots will be redrawn every frame." << std::endl;
+    }
+
+    m_gl.glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    m_gl.glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+
+void PlotLayerCache::destroy()
+{
+    if (m_framebuffer != 0)
+    {
+        m_gl.glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    if (m_colorRenderbuffer != 0)
+    {
+        m_gl.glDeleteRenderbuffers(1, &m_colorRenderbuffer);
+        m_colorRenderbuffer = 0;
+    }
+    if (m_depthRenderbuffer != 0)
+    {
+        m_gl.glDeleteRenderbuffers(1, &m_depthRenderbuffer);
+        m_depthRenderbuffer = 0;
+    }
+    m_complete = false;
+}
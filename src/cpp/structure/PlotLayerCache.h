@@ -0,0 +1,47 @@
+#pragma once
+
+#include <qopenglfunctions_3_3_core.h>
+
+
+class PlotLayerCache
+/*
+    Offscreen framebuffer holding the last render of the plot layer
+    (data, axes, gridlines and labels) of a CentralOpenGlWidget.
+
+    When only the overlays (crosshair, hover value popup, drawn with QPainter)
+    change, the cached layer is copied to the widget framebuffer rather
+    than re-drawing every plot. The copy is a single framebuffer blit,
+    so its cost does not depend on the amount of data.
+
+    The framebuffer matches the size and multisampling of the widget
+    framebuffer, as required to blit between them.
+*/
+{
+
+public:
+    PlotLayerCache(QOpenGLFunctions_3_3_Core& glFunctions);
+    ~PlotLayerCache();
+
+    PlotLayerCache(const PlotLayerCache&) = delete;
+    PlotLayerCache& operator=(const PlotLayerCache&) = delete;
+    PlotLayerCache(PlotLayerCache&&) = delete;
+    PlotLayerCache& operator=(PlotLayerCache&&) = delete;
+
+    bool bindForRender(int width, int height, int numSamples);
+    void blitTo(unsigned int targetFramebuffer);
+
+private:
+    QOpenGLFunctions_3_3_Core& m_gl;
+
+    void create(int width, int height, int numSamples);
+    void destroy();
+
+    unsigned int m_framebuffer = 0;
+    unsigned int m_colorRenderbuffer = 0;
+    unsigned int m_depthRenderbuffer = 0;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_numSamples = 0;
+    bool m_complete = false;
+};
@@ -0,0 +1,287 @@
+#include "RangeMinMaxIndex.h"
+#include <algorithm>
+#include "../ParallelFor.h"
+#include <limits>
+#include <stdexcept>
+
+
+void RangeMinMaxIndex::build(const StdPtrVector<float>& minVector, const StdPtrVector<float>& maxVector)
+/*
+    Build the index from scratch.
+ */
+{
+    m_minTable.clear();
+    m_maxTable.clear();
+    m_size = 0;
+    m_firstStaleBlock = noStaleBlocks;
+
+    update(minVector, maxVector, 0);
+}
+
+
+void RangeMinMaxIndex::build(
+    const StdPtrVector<float>& minVector,
+    const StdPtrVector<float>& maxVector,
+    const PrecomputedBlockMinMax& blockMinMax
+)
+/*
+    Build the index from the precomputed min / max of each block. Only
+    the sparse table is built, the data itself is not read (the partial
+    blocks at the edges of a query are still scanned).
+ */
+{
+    if (minVector.size() != maxVector.size())
+    {
+        throw std::runtime_error("CRITICAL ERROR: RangeMinMaxIndex min and max vectors must be the same size.");
+    }
+
+    std::size_t numBlocks = (minVector.size() + blockSize - 1) / blockSize;
+
+    if (blockMinMax.blockMin.size() != numBlocks || blockMinMax.blockMax.size() != numBlocks)
+    {
+        throw std::runtime_error("CRITICAL ERROR: RangeMinMaxIndex precomputed blocks do not match the data size.");
+    }
+
+    m_minData = minVector.data();
+    m_maxData = maxVector.data();
+    m_size = minVector.size();
+
+    m_minTable.clear();
+    m_maxTable.clear();
+    m_firstStaleBlock = noStaleBlocks;
+
+    if (numBlocks == 0)
+    {
+        return;
+    }
+
+    m_minTable.emplace_back(blockMinMax.blockMin.begin(), blockMinMax.blockMin.end());
+    m_maxTable.emplace_back(blockMinMax.blockMax.begin(), blockMinMax.blockMax.end());
+
+    m_firstStaleBlock = 0;
+}
+
+
+void RangeMinMaxIndex::update(
+    const StdPtrVector<float>& minVector,
+    const StdPtrVector<float>& maxVector,
+    std::size_t firstChangedIdx
+)
+/*
+    Update the index after all datapoints from `firstChangedIdx` onwards
+    have changed or been appended. The data may also have been reallocated,
+    so the data pointers are always re-set.
+
+    Only the blocks from the block containing `firstChangedIdx` are
+    recomputed. On each level of the sparse table, an entry depends on
+    a changed block only if its span overlaps that block, so only
+    entries from (firstChangedBlock - 2^k + 1) onwards are recomputed
+    (on the next range query, see ensureLevels()).
+ */
+{
+    if (minVector.size() != maxVector.size())
+    {
+        throw std::runtime_error("CRITICAL ERROR: RangeMinMaxIndex min and max vectors must be the same size.");
+    }
+
+    m_minData = minVector.data();
+    m_maxData = maxVector.data();
+    m_size = minVector.size();
+
+    std::size_t numBlocks = (m_size + blockSize - 1) / blockSize;
+    std::size_t firstChangedBlock = std::min(firstChangedIdx, m_size) / blockSize;
+
+    if (numBlocks == 0)
+    {
+        m_minTable.clear();
+        m_maxTable.clear();
+        m_firstStaleBlock = noStaleBlocks;
+        return;
+    }
+
+    // Level 0, the min / max of each block
+    if (m_minTable.empty())
+    {
+        m_minTable.emplace_back();
+        m_maxTable.emplace_back();
+    }
+
+    m_minTable[0].resize(numBlocks);
+    m_maxTable[0].resize(numBlocks);
+
+    parallelFor(numBlocks - firstChangedBlock, parallelChunkBlocks, [&](std::size_t chunkStart, std::size_t chunkEnd)
+    {
+        for (std::size_t blockIdx = firstChangedBlock + chunkStart; blockIdx < firstChangedBlock + chunkEnd; blockIdx++)
+        {
+            float min = std::numeric_limits<float>::infinity();
+            float max = -std::numeric_limits<float>::infinity();
+
+            scanRange(blockIdx * blockSize, std::min((blockIdx + 1) * blockSize, m_size), min, max);
+
+            m_minTable[0][blockIdx] = min;
+            m_maxTable[0][blockIdx] = max;
+        }
+    });
+
+    m_firstStaleBlock = std::min(m_firstStaleBlock, firstChangedBlock);
+}
+
+
+void RangeMinMaxIndex::ensureLevels() const
+/*
+    Build the levels above level 0 from the first block changed since
+    they were last built.
+ */
+{
+    if (m_firstStaleBlock == noStaleBlocks)
+    {
+        return;
+    }
+
+    buildLevels(m_minTable[0].size(), m_firstStaleBlock);
+
+    m_firstStaleBlock = noStaleBlocks;
+}
+
+
+void RangeMinMaxIndex::buildLevels(std::size_t numBlocks, std::size_t firstChangedBlock) const
+/*
+    Build the levels above level 0 (the min / max of each block),
+    each entry merges two entries on the level below.
+ */
+{
+    std::size_t numLevels = floorLog2(numBlocks) + 1;
+
+    m_minTable.resize(numLevels);
+    m_maxTable.resize(numLevels);
+
+    for (std::size_t level = 1; level < numLevels; level++)
+    {
+        std::size_t span = std::size_t(1) << level;
+        std::size_t halfSpan = span / 2;
+        std::size_t levelSize = numBlocks - span + 1;
+
+        std::vector<float>& levelMin = m_minTable[level];
+        std::vector<float>& levelMax = m_maxTable[level];
+        const std::vector<float>& belowMin = m_minTable[level - 1];
+        const std::vector<float>& belowMax = m_maxTable[level - 1];
+
+        std::size_t firstEntry = firstChangedBlock + 1 > span ? firstChangedBlock + 1 - span : 0;
+        firstEntry = std::min(firstEntry, levelMin.size());
+
+        levelMin.resize(levelSize);
+        levelMax.resize(levelSize);
+
+        for (std::size_t i = firstEntry; i < levelSize; i++)
+        {
+            levelMin[i] = std::min(belowMin[i], belowMin[i + halfSpan]);
+            levelMax[i] = std::max(belowMax[i], belowMax[i + halfSpan]);
+        }
+    }
+}
+
+
+std::pair<float, float> RangeMinMaxIndex::getMinMax(std::size_t startIdx, std::size_t endIdx) const
+/*
+    Get the min / max over the datapoints [startIdx, endIdx). NaN is
+    returned if the range is empty or contains only NaN values.
+ */
+{
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+
+    endIdx = std::min(endIdx, m_size);
+
+    if (startIdx >= endIdx)
+    {
+        return toResult(min, max);
+    }
+
+    std::size_t startBlock = startIdx / blockSize;
+    std::size_t lastBlock = (endIdx - 1) / blockSize;
+
+    // There are no whole blocks between the edges, just scan
+    if (lastBlock - startBlock <= 1)
+    {
+        scanRange(startIdx, endIdx, min, max);
+        return toResult(min, max);
+    }
+
+    // Partial blocks at the edges
+    scanRange(startIdx, (startBlock + 1) * blockSize, min, max);
+    scanRange(lastBlock * blockSize, endIdx, min, max);
+
+    // Whole blocks in between, covered by two (overlapping) table entries
+    ensureLevels();
+
+    std::size_t firstWholeBlock = startBlock + 1;
+    std::size_t numWholeBlocks = lastBlock - firstWholeBlock;
+
+    std::size_t level = floorLog2(numWholeBlocks);
+    std::size_t secondEntry = lastBlock - (std::size_t(1) << level);
+
+    min = std::min({min, m_minTable[level][firstWholeBlock], m_minTable[level][secondEntry]});
+    max = std::max({max, m_maxTable[level][firstWholeBlock], m_maxTable[level][secondEntry]});
+
+    return toResult(min, max);
+}
+
+
+std::pair<float, float> RangeMinMaxIndex::getMinMax() const
+/*
+    The min / max of all the data, from the min / max of each block
+    (without building the levels). NaN if there are only NaN values.
+ */
+{
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+
+    if (!m_minTable.empty())
+    {
+        for (std::size_t blockIdx = 0; blockIdx < m_minTable[0].size(); blockIdx++)
+        {
+            min = std::min(min, m_minTable[0][blockIdx]);
+            max = std::max(max, m_maxTable[0][blockIdx]);
+        }
+    }
+    return toResult(min, max);
+}
+
+
+void RangeMinMaxIndex::scanRange(std::size_t startIdx, std::size_t endIdx, float& min, float& max) const
+/*
+    Any comparison with NaN is false, so NaN values are skipped. This
+    form (rather than std::fmin) allows the compiler to vectorise the loop.
+ */
+{
+    for (std::size_t i = startIdx; i < endIdx; i++)
+    {
+        min = m_minData[i] < min ? m_minData[i] : min;
+        max = m_maxData[i] > max ? m_maxData[i] : max;
+    }
+}
+
+
+std::pair<float, float> RangeMinMaxIndex::toResult(float min, float max)
+/*
+    The min / max are accumulated from +/- infinity, if they
+    are unchanged there were no (non-NaN) values in the range.
+ */
+{
+    if (min > max)
+    {
+        return {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN()};
+    }
+    return {min, max};
+}
+
+
+std::size_t RangeMinMaxIndex::floorLog2(std::size_t value)
+{
+    std::size_t result = 0;
+    while (value >>= 1)
+    {
+        result++;
+    }
+    return result;
+}
@@ -0,0 +1,89 @@
+#ifndef RANGEMINMAXINDEX_H
+#define RANGEMINMAXINDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "../include/UserVector.h"
+
+
+struct PrecomputedBlockMinMax
+/*
+    The min / max of each block of RangeMinMaxIndex::blockSize datapoints
+    (e.g. the zone maps of a CandleColumnFile), NaN ignored and +/- infinity
+    for an all-NaN block. Used to build the index without reading the data.
+ */
+{
+    StdPtrVector<float> blockMin;
+    StdPtrVector<float> blockMax;
+};
+
+
+class RangeMinMaxIndex
+/*
+    Index for fast min / max queries over any index range of the
+    min / max vectors of a JointPlotData (used to pin the y-axis).
+
+    The data is split into fixed-size blocks. The min / max of each
+    block is stored, and a sparse table is built over these block
+    values (level k holds the min / max of 2^k consecutive blocks).
+    A query is then two table lookups for the whole blocks in the range,
+    plus a scan of at most two partial blocks at the edges, so the cost
+    does not depend on the size of the range (i.e. the zoom level).
+
+    Appending data or changing the last datapoint only touches one
+    table entry per level, so updates are O(log n) per changed block.
+
+    The block min / max are computed when the data is set (split across
+    threads for a new plot), the levels above are only built on the first
+    range query (i.e. when the y-axis is first pinned), so adding a plot
+    does not wait for them. The min / max of all the data is read from
+    the blocks, without the levels (see getMinMax()).
+
+    The index does not own the data, it must be updated (`update`)
+    whenever the data changes or is reallocated. NaN values are ignored.
+ */
+{
+
+public:
+    RangeMinMaxIndex() = default;
+
+    RangeMinMaxIndex(const RangeMinMaxIndex&) = delete;
+    RangeMinMaxIndex& operator=(const RangeMinMaxIndex&) = delete;
+    RangeMinMaxIndex(RangeMinMaxIndex&&) = delete;
+    RangeMinMaxIndex& operator=(RangeMinMaxIndex&&) = delete;
+
+    void build(const StdPtrVector<float>& minVector, const StdPtrVector<float>& maxVector);
+    void build(const StdPtrVector<float>& minVector, const StdPtrVector<float>& maxVector, const PrecomputedBlockMinMax& blockMinMax);
+    void update(const StdPtrVector<float>& minVector, const StdPtrVector<float>& maxVector, std::size_t firstChangedIdx);
+
+    std::pair<float, float> getMinMax(std::size_t startIdx, std::size_t endIdx) const;
+    std::pair<float, float> getMinMax() const;
+
+    std::size_t size() const { return m_size; }
+
+    static constexpr std::size_t blockSize = 256;
+
+private:
+
+    static constexpr std::size_t parallelChunkBlocks = 1024;  // blocks per thread when scanning
+    static constexpr std::size_t noStaleBlocks = static_cast<std::size_t>(-1);
+
+    const float* m_minData = nullptr;
+    const float* m_maxData = nullptr;
+    std::size_t m_size = 0;
+
+    // m_minTable[k][i] is the min of blocks [i, i + 2^k). Levels
+    // above 0 are built on the first query after a change (mutable).
+    mutable std::vector<std::vector<float>> m_minTable;
+    mutable std::vector<std::vector<float>> m_maxTable;
+    mutable std::size_t m_firstStaleBlock = noStaleBlocks;
+
+    void buildLevels(std::size_t numBlocks, std::size_t firstChangedBlock) const;
+    void ensureLevels() const;
+    void scanRange(std::size_t startIdx, std::size_t endIdx, float& min, float& max) const;
+    static std::pair<float, float> toResult(float min, float max);
+    static std::size_t floorLog2(std::size_t value);
+};
+
+#endif
@@ -4,6 +4,7 @@
 RenderManager::RenderManager(CentralOpenGlWidget& window, Configs& configs, QOpenGLFunctions_3_3_Core& glFunctions)
     : m_configs(configs),
     m_gl(glFunctions),
+    m_profiler(glFunctions),
     m_windowViewport(configs, window, glFunctions),
     m_sharedXData{}
 {
@@ -53,7 +54,10 @@ void RenderManager::paint()
 
     glm::mat4 viewportTransform = m_linkedSubplots[0]->windowViewport().setForSharedXAxis();
 
-    m_linkedSubplots[0]->axesObject().drawAxes(viewportTransform, "x");
+    {
+        ProfileScope scope(m_profiler, ProfileStage::axes);
+        m_linkedSubplots[0]->axesObject().drawAxes(viewportTransform, "x");
+    }
     m_linkedSubplots[0]->axesObject().drawXAxesAndTicks(viewportTransform);
 
     // Draw all subplots
@@ -67,6 +71,39 @@ void RenderManager::paint()
 }
 
 
+std::vector<double> RenderManager::plotLayerState() const
+/*
+    The state that the drawn plot layer depends on, which can change from
+    user interaction or during the draw itself (e.g. tick positions converging
+    after a pan, or pinned y-axis limits). If this is unchanged between frames
+    and the layer was not marked dirty (see CentralOpenGlWidget::paintGL()),
+    the cached plot layer can be reused.
+*/
+{
+    std::vector<double> state{
+        (double)m_windowViewport.getWindowWidth(),
+        (double)m_windowViewport.getWindowHeight()
+    };
+
+    for (const std::unique_ptr<LinkedSubplot>& subplot : m_linkedSubplots)
+    {
+        const Camera& camera = subplot->camera();
+        std::array<double, 4> tickState = subplot->axesObject().tickState();
+
+        state.insert(state.end(), {
+            camera.getLeft(), camera.getRight(), camera.getBottom(), camera.getTop(),
+            tickState[0], tickState[1], tickState[2], tickState[3],
+            subplot->m_yStartProportion, subplot->m_yHeightProportion,
+            (double)subplot->jointPlotData().numPlots(),
+            (double)subplot->jointPlotData().getNumDatapoints(),
+            (double)subplot->drawLines().size()
+        });
+    }
+
+    return state;
+}
+
+
 void RenderManager::addLinkedSubplot(double heightAsProportion)
 /*
     Add a subplot to the plot.
@@ -10,6 +10,8 @@
 #include "../Configs.h"
 #include "LinkedSubplot.h"
 #include "SharedXData.h"
+#include "FrameProfiler.h"
+#include "DeferredWorkQueue.h"
 
 
 class RenderManager
@@ -34,6 +36,7 @@ public:
     RenderManager& operator=(RenderManager&&) = delete;
 
     void paint();
+    std::vector<double> plotLayerState() const;
 
     void addLinkedSubplot(double heightAsProportion);
     void resizeLinkedSubplots(std::vector<double> yHeights);
@@ -44,6 +47,8 @@ public:
 
     Configs& m_configs;
     QOpenGLFunctions_3_3_Core& m_gl;
+    FrameProfiler m_profiler;
+    DeferredWorkQueue m_deferredWork;  // before the subplots, their plots cancel their work when destroyed
     WindowViewportObject m_windowViewport;
     std::vector<std::unique_ptr<LinkedSubplot>> m_linkedSubplots;
     SharedXData m_sharedXData;
@@ -1,4 +1,5 @@
 #include "SharedXData.h"
+#include <algorithm>
 #include <iostream>
 #include "../../vendor/fmt/include/fmt/core.h"
 #include <chrono>
@@ -7,6 +8,22 @@
 #include <stdexcept>
 #include <string>
 #include "../../vendor/date-master/date/date.h"  // Howard Hinnant's date library
+#include "../ParallelFor.h"
+
+
+using EpochNsTimepoint = date::sys_time<std::chrono::nanoseconds>;
+
+
+EpochNsTimepoint epochNsToTimepoint(std::int64_t epochNs)
+{
+    return EpochNsTimepoint{std::chrono::nanoseconds{epochNs}};
+}
+
+
+std::int64_t timepointToEpochNs(const std::chrono::system_clock::time_point& timepoint)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timepoint.time_since_epoch()).count();
+}
 
 
 SharedXData::SharedXData() {}
@@ -32,13 +49,13 @@ std::string SharedXData::getSingleFormattedLabel(int tickIndex)
         return vector[tickIndex];
     }
 
-    if (std::holds_alternative<TimepointVectorRef>(*m_xData)) {
-        const auto& vector = std::get<TimepointVectorRef>(*m_xData).get();
+    if (std::holds_alternative<EpochNsVector>(*m_xData)) {
+        const EpochNsVector& vector = std::get<EpochNsVector>(*m_xData);
         if (tickIndex < 0 || tickIndex >= static_cast<int>(vector.size())) {
             return "";
         }
 
-        auto tickTime = vector[tickIndex];
+        EpochNsTimepoint tickTime = epochNsToTimepoint(vector[tickIndex]);
         auto dayPoint = floor<days>(tickTime);
         year_month_day ymd = dayPoint;
 
@@ -81,11 +98,11 @@ std::vector<std::string> SharedXData::getXTickLabelDatetime(std::vector<int> all
     std::vector<std::string> labels;
 
     if (!m_xData.has_value() ||
-        !std::holds_alternative<TimepointVectorRef>(*m_xData)) {
+        !std::holds_alternative<EpochNsVector>(*m_xData)) {
         return labels;
     }
 
-    const auto& labelVector = std::get<TimepointVectorRef>(*m_xData).get();
+    const EpochNsVector& labelVector = std::get<EpochNsVector>(*m_xData);
     if (allTickLabels.empty() || allTickLabels.front() < 0 || allTickLabels.back() >= static_cast<int>(labelVector.size())) {
         return labels;
     }
@@ -94,8 +111,8 @@ std::vector<std::string> SharedXData::getXTickLabelDatetime(std::vector<int> all
     std::string timeFormat = showSeconds ? "%H:%M:%S" : "%H:%M";
     std::string dateTimeFormat = "%b %d " + timeFormat;
 
-    system_clock::time_point startTime = labelVector[allTickLabels.front()];
-    system_clock::time_point endTime = labelVector[allTickLabels.back()];
+    EpochNsTimepoint startTime = epochNsToTimepoint(labelVector[allTickLabels.front()]);
+    EpochNsTimepoint endTime = epochNsToTimepoint(labelVector[allTickLabels.back()]);
     auto totalMinutes = std::abs(
         duration_cast<duration<int, std::ratio<60>>>(endTime - startTime).count()
         );
@@ -122,7 +139,7 @@ std::vector<std::string> SharedXData::getXTickLabelDatetime(std::vector<int> all
 
     // Protect against invalid access
     if (allTickLabels.size() < 2) return labels;
-    auto timeDiff = labelVector[allTickLabels[1]] - labelVector[allTickLabels[0]];
+    auto timeDiff = epochNsToTimepoint(labelVector[allTickLabels[1]]) - epochNsToTimepoint(labelVector[allTickLabels[0]]);
 
     for (size_t j = 0; j < allTickLabels.size(); ++j)
     {
@@ -132,7 +149,7 @@ std::vector<std::string> SharedXData::getXTickLabelDatetime(std::vector<int> all
             continue;
         }
 
-        auto tickTime = labelVector[tickIndex];
+        EpochNsTimepoint tickTime = epochNsToTimepoint(labelVector[tickIndex]);
         auto nextTickTime = tickTime + timeDiff;
 
         std::ostringstream oss;
@@ -205,10 +222,12 @@ std::vector<int> SharedXData::convertDateToIndex(const std::vector<std::string>&
     if (stringVector.empty())
         return {};
 
+    buildStringDateIndex();
+
     std::vector<int> indexes;
     indexes.reserve(stringVector.size());
 
-    const auto& dateMap = std::get<std::unordered_map<std::string, int>>(m_dateIndex);
+    const auto& dateMap = m_stringDateIndex.value();
 
     for (const auto& label : stringVector) {
 
@@ -227,31 +246,60 @@ std::vector<int> SharedXData::convertDateToIndex(const std::vector<std::string>&
 
 std::vector<int> SharedXData::convertDateToIndex(const std::vector<std::chrono::system_clock::time_point>& timeVector) const
 /*
-
+    Datetimes are matched as-of, i.e. to the last x-axis date at or before them.
 */
 {
-    if (timeVector.empty())
-        return {};
-
     std::vector<int> indexes;
     indexes.reserve(timeVector.size());
 
-    const auto& dateMap = std::get<TimepointMap>(m_dateIndex);
     for (const auto& tp : timeVector) {
-        auto it = dateMap.find(tp);
+        indexes.push_back(m_dateColumnIndex.asOfIndex(timepointToEpochNs(tp)));
+    }
 
-        if (it == dateMap.end())
-        {
-            throw std::runtime_error("Scatterplot datetime Datetime not found in x-axis labels.");
-        }
+    return indexes;
+}
 
-        indexes.push_back(it->second);
+
+std::vector<int> SharedXData::convertDateToIndex(const EpochNsVector& epochNsVector) const
+/*
+    Datetimes are matched as-of, i.e. to the last x-axis date at or before them.
+*/
+{
+    std::vector<int> indexes;
+    indexes.reserve(epochNsVector.size());
+
+    for (std::int64_t epochNs : epochNsVector) {
+        indexes.push_back(m_dateColumnIndex.asOfIndex(epochNs));
     }
 
     return indexes;
 }
 
 
+void SharedXData::buildStringDateIndex() const
+/*
+    Hash all string dates to their index, if not already done since the dates were set.
+    A repeated date keeps its first index.
+ */
+{
+    if (m_stringDateIndex.has_value() || !m_xData.has_value())
+    {
+        return;
+    }
+
+    const std::vector<std::string>& data = std::get<StringVectorRef>(m_xData.value()).get();
+
+    std::unordered_map<std::string, int> dateIndex;
+    dateIndex.reserve(data.size());
+
+    for (int i = 0; i < data.size(); i++)
+    {
+        dateIndex.emplace(data[i], i);
+    }
+    m_stringDateIndex = std::move(dateIndex);
+}
+
+
 DateType SharedXData::getDateType()
 /*
 
@@ -261,7 +309,7 @@ DateType SharedXData::getDateType()
     {
         return DateType::NoDate;
     }
-    if (std::holds_alternative<TimepointVectorRef>(m_xData.value()))
+    if (std::holds_alternative<EpochNsVector>(m_xData.value()))
     {
         return DateType::Timepoint;
     }
@@ -276,45 +324,126 @@ DateType SharedXData::getDateType()
 
 void SharedXData::handleNewXDataVector(DateVector xData)
 /*
- *     Replace existing. This is checked up front.
+ *     Replace existing. This is checked up front. Dates are not
+ *     indexed here, see DateColumnIndex and buildStringDateIndex().
  */
 {
     if (std::holds_alternative<StringVectorRef>(xData))
     {
-        if (m_xData.has_value() && std::holds_alternative<TimepointVectorRef>(m_xData.value()))
+        if (m_xData.has_value() && std::holds_alternative<EpochNsVector>(m_xData.value()))
         {
             throw std::runtime_error("CRITIAL ERROR: plot contains timepoint dates but we are trying to set string. This should be caught further up.");
         }
 
-        const StringVectorRef data = std::get<StringVectorRef>(xData);
+        m_xData = std::get<StringVectorRef>(xData);
+    }
+    else
+    {
+        if (m_xData.has_value() && std::holds_alternative<StringVectorRef>(m_xData.value()))
+        {
+            throw std::runtime_error("plot contains string dates but we are trying to set timepoint. This should be caught further up.");
+        }
+
+        if (std::holds_alternative<EpochNsVector>(xData))
+        {
+            m_xData = std::get<EpochNsVector>(xData);
+        }
+        else
+        {
+            const std::vector<std::chrono::system_clock::time_point>& data = std::get<TimepointVectorRef>(xData).get();
+
+            std::vector<std::int64_t> epochNsDates(data.size());
+
+            parallelFor(data.size(), parallelChunkSize, [&](std::size_t chunkStart, std::size_t chunkEnd)
+            {
+                std::transform(data.begin() + chunkStart, data.begin() + chunkEnd, epochNsDates.begin() + chunkStart, timepointToEpochNs);
+            });
+
+            m_ownedEpochNsDates = std::move(epochNsDates);
+            m_xData = EpochNsVector(m_ownedEpochNsDates.data(), m_ownedEpochNsDates.size());
+        }
+    }
+
+    if (std::holds_alternative<EpochNsVector>(m_xData.value()))
+    {
+        m_dateColumnIndex.reset(std::get<EpochNsVector>(m_xData.value()));
+    }
+    m_stringDateIndex = std::nullopt;
+    m_xDataVersion++;
+};
 
-        m_xData = data;
 
-        std::unordered_map<std::string, int> dateIndex;
+void SharedXData::appendXData(DateVector xData)
+/*
+    Append dates to the end of the existing x-axis data (e.g. when streaming
+    new candles). On first append, the user-passed dates are copied into owned
+    storage. The date index is updated for only the new dates.
+ */
+{
+    if (!m_xData.has_value())
+    {
+        throw std::runtime_error("CRITICAL ERROR: cannot append dates to a plot without dates. This should be caught further up.");
+    }
 
-        for (int i = 0; i < data.get().size(); i++)
+    if (std::holds_alternative<StringVectorRef>(xData))
+    {
+        if (!std::holds_alternative<StringVectorRef>(m_xData.value()))
+        {
+            throw std::runtime_error("CRITICAL ERROR: plot contains timepoint dates but we are trying to append string. This should be caught further up.");
+        }
+
+        const std::vector<std::string>& existing = std::get<StringVectorRef>(m_xData.value()).get();
+
+        if (&existing != &m_ownedStringDates)
         {
-            dateIndex[data.get()[i]] = i;
+            m_ownedStringDates = existing;
+            m_xData = std::cref(m_ownedStringDates);
+        }
+
+        const std::vector<std::string>& newDates = std::get<StringVectorRef>(xData).get();
+
+        for (const std::string& date : newDates)
+        {
+            if (m_stringDateIndex.has_value())
+            {
+                m_stringDateIndex.value().emplace(date, (int)m_ownedStringDates.size());
+            }
+            m_ownedStringDates.push_back(date);
         }
-        m_dateIndex = dateIndex;
     }
     else
     {
-        if (m_xData.has_value() && std::holds_alternative<StringVectorRef>(m_xData.value()))
+        if (!std::holds_alternative<EpochNsVector>(m_xData.value()))
         {
-            throw std::runtime_error("plot contains string dates but we are trying to set timepoint. This should be caught further up.");
+            throw std::runtime_error("CRITICAL ERROR: plot contains string dates but we are trying to append timepoint. This should be caught further up.");
         }
 
-        const TimepointVectorRef data = std::get<TimepointVectorRef>(xData);
+        const EpochNsVector existing = std::get<EpochNsVector>(m_xData.value());
 
-        m_xData = data;
+        if (existing.data() != m_ownedEpochNsDates.data())
+        {
+            m_ownedEpochNsDates.assign(existing.begin(), existing.end());
+        }
 
-        TimepointMap dateIndex;
+        std::vector<std::int64_t> newDates;
 
-        for (int i = 0; i < data.get().size(); i++)
+        if (std::holds_alternative<EpochNsVector>(xData))
+        {
+            const EpochNsVector& newEpochNs = std::get<EpochNsVector>(xData);
+            newDates.assign(newEpochNs.begin(), newEpochNs.end());
+        }
+        else
         {
-            dateIndex[data.get()[i]] = i;
+            const std::vector<std::chrono::system_clock::time_point>& newTimepoints = std::get<TimepointVectorRef>(xData).get();
+            newDates.resize(newTimepoints.size());
+            std::transform(newTimepoints.begin(), newTimepoints.end(), newDates.begin(), timepointToEpochNs);
         }
-        m_dateIndex = dateIndex;
+
+        m_ownedEpochNsDates.insert(m_ownedEpochNsDates.end(), newDates.begin(), newDates.end());
+
+        // Re-point after every append, the vector may have reallocated.
+        m_xData = EpochNsVector(m_ownedEpochNsDates.data(), m_ownedEpochNsDates.size());
+        m_dateColumnIndex.append(std::get<EpochNsVector>(m_xData.value()));
     }
-};
+    m_xDataVersion++;
+}
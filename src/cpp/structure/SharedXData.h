@@ -1,12 +1,14 @@
 #ifndef SHAREDXDATA_H
 #define SHAREDXDATA_H
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <chrono>
 #include <variant>
 #include "../include/Plotter.h"
+#include "DateColumnIndex.h"
 
 
 enum class DateType
@@ -17,26 +19,6 @@ enum class DateType
 };
 
 
-struct TimePointHash {
-    std::size_t operator()(const std::chrono::system_clock::time_point& tp) const {
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      tp.time_since_epoch()).count();
-        return std::hash<std::int64_t>{}(ms);
-    }
-};
-
-
-struct TimePointEqual {
-    bool operator()(const std::chrono::system_clock::time_point& a,
-                    const std::chrono::system_clock::time_point& b) const {
-        return a == b;
-    }
-};
-
-
-using TimepointMap = std::unordered_map<std::chrono::system_clock::time_point, int, TimePointHash, TimePointEqual>;
-
-
 class SharedXData
 /*
     Class to handle the shared x-axis values shared
@@ -58,32 +40,45 @@ public:
 
     std::vector<int> convertDateToIndex(const std::vector<std::string>& stringVector) const;
     std::vector<int> convertDateToIndex(const std::vector<std::chrono::system_clock::time_point>& timeVector) const;
+    std::vector<int> convertDateToIndex(const EpochNsVector& epochNsVector) const;
 
     DateType getDateType();
 
     void handleNewXDataVector(DateVector xData);
+    void appendXData(DateVector xData);
+
+    // Incremented when the dates are replaced, so cached tick labels can be invalidated.
+    std::size_t xDataVersion() const { return m_xDataVersion; };
 
 private:
 
-    // The user can pass m_xData (string labels) by reference or it can be
-    // generated on the fly from an int array of indicies. In this case, we
-    // store the array and then reference it in m_xData.
-//    std::vector<std::string> m_xTickLabels{};
+    void buildStringDateIndex() const;
+
+    // The user can pass m_xData (string labels) by reference. Datetimes
+    // are always held as int64 nanoseconds since the epoch, either referencing
+    // the user-passed array directly (e.g. NumPy datetime64[ns], not copied)
+    // or m_ownedEpochNsDates when chrono timepoints were passed.
     std::optional<
         std::variant<
             StringVectorRef,
-            TimepointVectorRef
+            EpochNsVector
         >
     > m_xData = std::nullopt;
 
-    // Hash for quick comparison of new dates and quick conversion of
-    // scatterplot date to index. This requires a copy of all date +
-    // holding the integer, but it is a necessary evil. When combining
-    // multiple plots with different x-axis, this hashing will be required.
-    std::variant<
-        std::unordered_map<std::string, int>,
-        TimepointMap
-    > m_dateIndex;
+    // Conversion of scatterplot / x-limit dates to index. Datetimes binary search
+    // the (sorted) date column (see DateColumnIndex). String labels are unordered
+    // so are hashed, on first use only (it is not needed to display the plot).
+    DateColumnIndex m_dateColumnIndex;
+    mutable std::optional<std::unordered_map<std::string, int>> m_stringDateIndex = std::nullopt;
+
+    // When dates are appended (streaming), the user-passed dates are copied
+    // here and m_xData references these instead, so they can grow.
+    std::vector<std::string> m_ownedStringDates;
+    std::vector<std::int64_t> m_ownedEpochNsDates;
+
+    std::size_t m_xDataVersion = 0;
+
+    static constexpr std::size_t parallelChunkSize = 1 << 18;  // dates per thread when converting timepoints
 };
 
 #endif // SHAREDXDATA_H
@@ -0,0 +1,342 @@
+#include "UpdateQueue.h"
+#include <stdexcept>
+#include <thread>
+
+
+// Coalescing
+// -------------------------------------------------------------------------------------------------
+
+void CoalescedCandleUpdates::add(const CandleUpdate& update)
+/*
+    An appended candle adds a candle. An overwrite of the last candle
+    changes the last appended candle if there is one, otherwise it is kept
+    (only the most recent) to apply to the plot's existing last candle.
+ */
+{
+    if (update.isAppend)
+    {
+        open.push_back(update.open);
+        high.push_back(update.high);
+        low.push_back(update.low);
+        close.push_back(update.close);
+
+        if (update.hasDate)
+        {
+            datesEpochNs.push_back(update.dateEpochNs);
+        }
+    }
+    else if (!open.empty())
+    {
+        open.back() = update.open;
+        high.back() = update.high;
+        low.back() = update.low;
+        close.back() = update.close;
+    }
+    else
+    {
+        hasLastCandleUpdate = true;
+        lastCandleUpdate = update;
+    }
+}
+
+
+void CoalescedCandleUpdates::add(const CoalescedCandleUpdates& later)
+/*
+    Add updates coalesced after these, in their order (the
+    overwrite of the last candle came before the appends).
+ */
+{
+    if (later.hasLastCandleUpdate)
+    {
+        add(later.lastCandleUpdate);
+    }
+
+    open.insert(open.end(), later.open.begin(), later.open.end());
+    high.insert(high.end(), later.high.begin(), later.high.end());
+    low.insert(low.end(), later.low.begin(), later.low.end());
+    close.insert(close.end(), later.close.begin(), later.close.end());
+    datesEpochNs.insert(datesEpochNs.end(), later.datesEpochNs.begin(), later.datesEpochNs.end());
+}
+
+
+void CoalescedCandleUpdates::clear()
+{
+    hasLastCandleUpdate = false;
+    open.clear();
+    high.clear();
+    low.clear();
+    close.clear();
+    datesEpochNs.clear();
+}
+
+
+// Queue
+// -------------------------------------------------------------------------------------------------
+
+UpdateQueue::UpdateQueue(std::size_t capacity)
+    : m_consumerThread(std::this_thread::get_id())
+{
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+    {
+        throw std::runtime_error("CRITICAL ERROR: UpdateQueue capacity must be a power of two.");
+    }
+
+    m_cells = std::make_unique<Cell[]>(capacity);
+    m_mask = capacity - 1;
+
+    for (std::size_t i = 0; i < capacity; i++)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+bool UpdateQueue::push(const CandleUpdate& update, BackpressurePolicy policy)
+/*
+    Push from any thread. Returns false if the update was dropped.
+    Throws if a block push would wait on the GUI thread, which drains the queue.
+ */
+{
+    if (m_closed.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    switch (policy)
+    {
+        case BackpressurePolicy::drop:
+        {
+            return tryPush(update);
+        }
+        case BackpressurePolicy::block:
+        {
+            while (!tryPush(update))
+            {
+                if (std::this_thread::get_id() == m_consumerThread)
+                {
+                    throw std::invalid_argument(
+                        "The candle stream queue is full and cannot be drained while blocking the GUI thread. "
+                        "Push from another thread, or use the \"merge\" or \"drop\" backpressure policy."
+                    );
+                }
+                if (m_closed.load(std::memory_order_relaxed))
+                {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+            return true;
+        }
+        case BackpressurePolicy::merge:
+        {
+            if (m_hasOverflow.load(std::memory_order_acquire) || !tryPush(update))
+            {
+                return pushToOverflow(update);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool UpdateQueue::tryPush(const CandleUpdate& update)
+/*
+    Claim the next position if its cell has been consumed (its sequence
+    equals the position), write the update, then publish it to the
+    consumer by setting the sequence to position + 1.
+ */
+{
+    std::size_t position = m_pushPosition.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true)
+    {
+        cell = &m_cells[position & m_mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (difference == 0)
+        {
+            if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;  // full
+        }
+        else
+        {
+            position = m_pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->update = update;
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+bool UpdateQueue::tryPop(CandleUpdate& update)
+/*
+    Single consumer. The cell is handed back to the producers
+    for the position one lap later (position + capacity).
+ */
+{
+    std::size_t position = m_popPosition.load(std::memory_order_relaxed);
+    Cell& cell = m_cells[position & m_mask];
+
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+    {
+        return false;  // empty, or the producer has not finished writing
+    }
+
+    update = cell.update;
+    cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+    m_popPosition.store(position + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+
+bool UpdateQueue::pushToOverflow(const CandleUpdate& update)
+/*
+    Coalesced per series, so overwrites of the last candle do not grow the
+    overflow. Returns false if an append was dropped as the overflow is full.
+ */
+{
+    std::lock_guard<std::mutex> lock(m_overflowMutex);
+
+    if (update.isAppend)
+    {
+        if (m_numOverflowCandles >= maxOverflowCandles)
+        {
+            return false;
+        }
+        m_numOverflowCandles++;
+    }
+
+    m_overflow[update.seriesId].add(update);
+    m_numOverflowUpdates++;
+
+    m_hasOverflow.store(true, std::memory_order_release);
+
+    return true;
+}
+
+
+std::size_t UpdateQueue::drain(std::map<int, CoalescedCandleUpdates>& updatesBySeries)
+/*
+    Pop the queued updates and coalesce them per series. At most one ring
+    capacity is drained per call, so producers cannot stall the frame.
+    The overflow holds the newest updates, it is only taken once the
+    ring is empty. A pop also stops at a cell a producer is still writing,
+    so the ring is only empty if no position is claimed past the popped
+    ones. This is checked under the overflow lock, so every ring update
+    pushed before an update in the overflow has been popped.
+    Returns the number of updates drained.
+ */
+{
+    std::size_t numDrained = 0;
+    CandleUpdate update;
+
+    while (numDrained <= m_mask && tryPop(update))
+    {
+        updatesBySeries[update.seriesId].add(update);
+        numDrained++;
+    }
+
+    if (m_hasOverflow.load(std::memory_order_acquire))
+    {
+        std::map<int, CoalescedCandleUpdates> overflow;
+        {
+            std::lock_guard<std::mutex> lock(m_overflowMutex);
+
+            if (m_pushPosition.load(std::memory_order_acquire) == m_popPosition.load(std::memory_order_relaxed))
+            {
+                overflow.swap(m_overflow);
+                numDrained += m_numOverflowUpdates;
+                m_numOverflowCandles = 0;
+                m_numOverflowUpdates = 0;
+                m_hasOverflow.store(false, std::memory_order_release);
+            }
+        }
+
+        for (const auto& [seriesId, seriesUpdates] : overflow)
+        {
+            updatesBySeries[seriesId].add(seriesUpdates);
+        }
+    }
+
+    return numDrained;
+}
+
+
+bool UpdateQueue::empty() const
+{
+    const Cell& cell = m_cells[m_popPosition.load(std::memory_order_relaxed) & m_mask];
+
+    return cell.sequence.load(std::memory_order_acquire) != m_popPosition.load(std::memory_order_relaxed) + 1 &&
+           !m_hasOverflow.load(std::memory_order_acquire);
+}
+
+
+void UpdateQueue::close()
+/*
+    Called when the plot is destroyed, later pushes are dropped
+    and blocked producers return.
+ */
+{
+    m_closed.store(true, std::memory_order_relaxed);
+}
+
+
+// Stream
+// -------------------------------------------------------------------------------------------------
+
+CandleStream::CandleStream(std::shared_ptr<UpdateQueue> queue, int seriesId, bool hasDates, CandleStreamSettings settings)
+    : m_queue(std::move(queue)),
+    m_seriesId(seriesId),
+    m_hasDates(hasDates),
+    m_settings(settings)
+{
+}
+
+
+void CandleStream::appendCandle(float open, float high, float low, float close, std::optional<std::int64_t> dateEpochNs)
+{
+    if (dateEpochNs.has_value() != m_hasDates)
+    {
+        throw std::invalid_argument(
+            m_hasDates ? "The candlestick plot has dates, so a date must be passed when appending a candle."
+                       : "The candlestick plot was created without dates, so dates cannot be appended."
+        );
+    }
+
+    CandleUpdate update{m_seriesId, true, m_hasDates, open, high, low, close, dateEpochNs.value_or(0)};
+
+    if (!m_queue->push(update, m_settings.backpressure))
+    {
+        m_numDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+void CandleStream::updateLastCandle(float open, float high, float low, float close)
+{
+    CandleUpdate update{m_seriesId, false, false, open, high, low, close, 0};
+
+    if (!m_queue->push(update, m_settings.backpressure))
+    {
+        m_numDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+std::size_t CandleStream::numDropped() const
+{
+    return m_numDropped.load(std::memory_order_relaxed);
+}
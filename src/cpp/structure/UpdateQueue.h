@@ -0,0 +1,126 @@
+#ifndef UPDATEQUEUE_H
+#define UPDATEQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../include/Plotter.h"
+
+
+struct CandleUpdate
+/*
+    A single streamed candle, appended or overwriting the last candle
+    of the series (the candlestick plot on linked subplot `seriesId`).
+ */
+{
+    int seriesId;
+    bool isAppend;
+    bool hasDate;
+    float open;
+    float high;
+    float low;
+    float close;
+    std::int64_t dateEpochNs;
+};
+
+
+struct CoalescedCandleUpdates
+/*
+    All updates drained for one series in a frame, reduced to at most
+    one overwrite of the existing last candle followed by one append.
+ */
+{
+    bool hasLastCandleUpdate = false;
+    CandleUpdate lastCandleUpdate;
+
+    std::vector<float> open;
+    std::vector<float> high;
+    std::vector<float> low;
+    std::vector<float> close;
+    std::vector<std::int64_t> datesEpochNs;
+
+    void add(const CandleUpdate& update);
+    void add(const CoalescedCandleUpdates& later);
+    void clear();
+};
+
+
+class UpdateQueue
+/*
+    Queue of candle updates pushed from any thread (see CandleStream)
+    and drained by the GUI thread once per frame (CentralOpenGlWidget::paintGL).
+
+    The queue is a bounded lock-free multi-producer ring (D. Vyukov's
+    bounded queue). Each cell holds a sequence number that tells a producer
+    whether the cell is free for its claimed position, and the consumer
+    whether it has been written. Producers claim positions with a single
+    compare-and-swap, so pushing never takes a lock.
+
+    When the ring is full the BackpressurePolicy of the stream decides:
+    the update is dropped, waited on (the producer yields until the
+    GUI thread drains), or moved to an overflow buffer (merge). The overflow
+    is mutex-protected but only used while the ring is full. It is coalesced
+    per series as when drained (appended candles and the latest overwrite of
+    the last candle), and holds at most `maxOverflowCandles` appended candles,
+    later appends are dropped until it is drained. While it holds updates,
+    merge pushes continue to go to it, so the order of a stream's updates is kept.
+
+    The queue is constructed on the GUI thread, which is its only consumer.
+    Blocking there would never return, so a block push from the GUI thread
+    to a full ring throws instead.
+ */
+{
+
+public:
+    UpdateQueue(std::size_t capacity);
+
+    UpdateQueue(const UpdateQueue&) = delete;
+    UpdateQueue& operator=(const UpdateQueue&) = delete;
+    UpdateQueue(UpdateQueue&&) = delete;
+    UpdateQueue& operator=(UpdateQueue&&) = delete;
+
+    bool push(const CandleUpdate& update, BackpressurePolicy policy);
+
+    std::size_t drain(std::map<int, CoalescedCandleUpdates>& updatesBySeries);
+    bool empty() const;
+
+    void close();
+
+    static constexpr std::size_t defaultCapacity = 1 << 16;
+    static constexpr std::size_t maxOverflowCandles = 1 << 22;  // 64 MB of OHLC + dates
+
+private:
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        CandleUpdate update;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::size_t m_mask;
+
+    // On separate cache lines, as producers and the consumer write them concurrently
+    alignas(64) std::atomic<std::size_t> m_pushPosition{0};
+    alignas(64) std::atomic<std::size_t> m_popPosition{0};
+
+    alignas(64) std::atomic<bool> m_hasOverflow{false};
+    std::mutex m_overflowMutex;
+    std::map<int, CoalescedCandleUpdates> m_overflow;
+    std::size_t m_numOverflowCandles = 0;  // appended candles, bounded by maxOverflowCandles
+    std::size_t m_numOverflowUpdates = 0;  // including the merged overwrites
+
+    std::atomic<bool> m_closed{false};
+    std::thread::id m_consumerThread;
+
+    bool tryPush(const CandleUpdate& update);
+    bool tryPop(CandleUpdate& update);
+    bool pushToOverflow(const CandleUpdate& update);
+};
+
+#endif
@@ -29,6 +29,27 @@ double WindowViewportObject::pixelRatio()
     return m_window.devicePixelRatio();
 }
 
+
+double WindowViewportObject::plotWidthInPixels()
+/*
+    Width of the plot area (window without the y-axis
+    margin) in device pixels.
+ */
+{
+    return m_windowWidth - m_configs.m_plotOptions.widthMarginSize * pixelRatio();
+}
+
+
+double WindowViewportObject::plotHeightInPixels(double yHeightProportion)
+/*
+    Height of the plot area of a linked subplot taking `yHeightProportion`
+    of the window (without the x-axis margin) in device pixels, as set
+    in setForLinkedSubplotPlot().
+ */
+{
+    return yHeightProportion * (m_windowHeight - m_configs.m_plotOptions.heightMarginSize * pixelRatio());
+}
+
 /* -----------------------------------------------------------------------------------------------------------
     Public Functions
 ------------------------------------------------------------------------------------------------------------*/
@@ -68,6 +68,8 @@ public:
     int getHeightNoMargin() const { return m_windowHeight - m_configs.m_plotOptions.heightMarginSize; };
 
     double pixelRatio();
+    double plotWidthInPixels();
+    double plotHeightInPixels(double yHeightProportion);
 
 private:
 
@@ -1,2 +1,6 @@
 from .plotter import Plotter
-from .plotter import get_toy_candlestick_data
\ No newline at end of file
+from .plotter import get_toy_candlestick_data
+from .plotter import read_csv
+from .plotter import CandleFile
+from .plotter import write_candle_file
+from .plotter import CandleStream
@@ -27,13 +27,15 @@ if not BUILDING_DOCS:
 # -------------------------------------------------------------------------------------
 
 FontType = Literal["consola", "arial"]
+CandleColumnType = Literal["open", "high", "low", "close", "volume"]
+BackpressureType = Literal["drop", "merge", "block"]
 
 Array = Union[
     list, tuple, np.ndarray
 ]
 
 Dates = Union[
-    list[str], list[datetime], pd.Series, pd.DatetimeIndex
+    list[str], list[datetime], pd.Series, pd.DatetimeIndex, np.ndarray
 ]
 
 FontWeightType = Literal[
@@ -53,7 +55,7 @@ CandlestickMode = Literal[
     "no_caps",
     "body_only",
     "line_open",
-    "line_closed"
+    "line_close"
 ]
 ScatterShapeType = Literal[
     "circle",
@@ -82,6 +84,226 @@ def get_toy_candlestick_data(N: int = 100_000, seed: int = None):
     return data_df, volume, dates
 
 
+def _datetime64_to_epoch_ns(dates) -> np.ndarray | None:
+    """Return datetime64 dates (UTC Series or DatetimeIndex, or a numpy array, which has no
+    timezone and is assumed to be UTC) as int64 nanoseconds since the epoch, without copying
+    if already datetime64[ns]. Return `None` if the dates are not datetime64.
+    """
+    if isinstance(dates, (pd.Series, pd.DatetimeIndex)) and pd.api.types.is_datetime64_any_dtype(dates):
+        if isinstance(dates, pd.Series):
+            dates = pd.DatetimeIndex(dates)
+
+        if dates.tz is None or str(dates.tz) != "UTC":
+            raise ValueError("`dates` must be UTC datetime.")
+
+        dates = dates.tz_convert(None).to_numpy()
+
+    if isinstance(dates, np.ndarray) and np.issubdtype(dates.dtype, np.datetime64):
+        return np.ascontiguousarray(dates.astype("datetime64[ns]", copy=False)).view(np.int64)
+
+    return None
+
+
+def read_csv(filepath: Union[str, Path], num_threads: int = 0):
+    """ Read OHLC data from a .csv file, in parallel.
+
+    Parameters
+    ----------
+
+    filepath
+        Path to a .csv file with "Open", "High", "Low", "Close" columns
+        (any order, case-insensitive) and an optional "Date" column.
+        Other columns are ignored. Empty or "nan" values are read as NaN.
+    num_threads
+        Number of threads to read with, 0 to use one per CPU core.
+
+    Returns
+    -------
+
+    data_df
+        DataFrame with float32 "open", "high", "low", "close" columns.
+    dates
+        If the dates are ISO-8601 (e.g. "2024-01-02T09:30:00Z"), a pandas
+        Series of UTC datetimes (dates without an offset are taken as UTC).
+        Otherwise, a list of the date strings. `None` if there is no "Date" column.
+    """
+    data = pythonBindings.read_csv(str(filepath), num_threads=num_threads)
+
+    if "dates_epoch_ns" in data:
+        dates = pd.Series(data.pop("dates_epoch_ns").view("datetime64[ns]")).dt.tz_localize("UTC")
+    else:
+        dates = data.pop("dates", None)
+
+    data_df = pd.DataFrame(data)
+
+    return data_df, dates
+
+
+def write_candle_file(
+    filepath: Union[str, Path],
+    df: pd.DataFrame,
+    volume: np.ndarray | None = None,
+    dates: pd.Series | pd.DatetimeIndex | np.ndarray | None = None,
+):
+    """ Write candle data to a columnar candle file, to be opened with `CandleFile`.
+
+    The columns are stored as aligned float32 (dates int64) arrays with the min / max
+    of every block of rows (zone maps), so the file can be memory mapped and
+    plotted without any copy or parse.
+
+    Parameters
+    ----------
+
+    filepath
+        Path of the file to write, overwritten if it exists.
+    df
+        A Pandas dataframe with columns "Open", "High", "Low", "Close" (all lowercase accepted e.g. "open").
+    volume
+        Optional candle volumes.
+    dates
+        Optional UTC datetime64 dates (pd.Series, pd.DatetimeIndex or numpy datetime64 array).
+    """
+    col_map = {str(c).lower(): df[c] for c in df.columns}
+
+    for accepted_name in ["open", "high", "low", "close"]:
+        if accepted_name not in col_map:
+            raise ValueError(f"{accepted_name} (or {accepted_name.title()}) not found in the passed dataframe.")
+
+    if dates is not None:
+        epoch_ns = _datetime64_to_epoch_ns(dates)
+        if epoch_ns is None:
+            raise ValueError("`dates` must be UTC datetime64 (pd.Series, pd.DatetimeIndex or numpy array).")
+        dates = pythonBindings.EpochNsDates(epoch_ns)
+
+    pythonBindings.write_candle_column_file(
+        str(filepath),
+        open=col_map["open"].to_numpy(),
+        high=col_map["high"].to_numpy(),
+        low=col_map["low"].to_numpy(),
+        close=col_map["close"].to_numpy(),
+        volume=None if volume is None else np.asarray(volume),
+        dates=dates,
+    )
+
+
+class CandleFile:
+
+    def __init__(self, filepath: Union[str, Path]):
+        """ A memory-mapped columnar candle file, written with `write_candle_file()`.
+
+        Opening the file does not read it, the columns are read-only numpy arrays
+        viewing the mapped file. Plot it with `Plotter.candlestick_from_file()`.
+
+        Parameters
+        ----------
+
+        filepath
+            Path to the candle file.
+        """
+        self._file = pythonBindings.CandleColumnFile(str(filepath))
+
+    def __len__(self):
+        return len(self._file)
+
+    @property
+    def block_size(self) -> int:
+        """Number of rows summarised by each entry of the zone maps (`block_min`, `block_max`)."""
+        return self._file.block_size
+
+    def has_column(self, column: CandleColumnType) -> bool:
+        """True if the column is stored (open, high, low and close always are)."""
+        return self._file.has_column(column)
+
+    def column(self, column: CandleColumnType) -> np.ndarray:
+        """Read-only view of the column."""
+        return self._file.column(column)
+
+    def block_min(self, column: CandleColumnType) -> np.ndarray:
+        """Min of every block of `block_size` rows of the column (NaN ignored, inf if all NaN)."""
+        return self._file.block_min(column)
+
+    def block_max(self, column: CandleColumnType) -> np.ndarray:
+        """Max of every block of `block_size` rows of the column (NaN ignored, -inf if all NaN)."""
+        return self._file.block_max(column)
+
+    @property
+    def dates(self) -> pd.Series | None:
+        """The stored dates as UTC datetimes, or `None` if the file stores no dates."""
+        if not self._file.has_dates():
+            return None
+        return pd.Series(self._file.dates_epoch_ns().view("datetime64[ns]")).dt.tz_localize("UTC")
+
+
+class CandleStream:
+
+    def __init__(self, stream):
+        """ Feed candles to a candlestick plot from any thread, created with `Plotter.candle_stream()`.
+
+        Candles are queued and drawn together once per frame, so they can be pushed
+        at a high rate (e.g. every tick of a live feed). The GIL is released while
+        pushing. Errors when drawing the candles (e.g. the plot was closed) are printed.
+        """
+        self._stream = stream
+
+    def append_candle(
+        self,
+        open: float,
+        high: float,
+        low: float,
+        close: float,
+        date: datetime | pd.Timestamp | np.datetime64 | None = None,
+    ):
+        """Append a candle.
+
+        Parameters
+        ----------
+        open
+           Candle open price.
+        high
+           Candle high price.
+        low
+           Candle low price.
+        close
+           Candle close price.
+        date
+            Date of the candle, must be passed if (and only if) the plot was created with
+            UTC datetime `dates`. Must be UTC (a numpy datetime64 is assumed to be UTC).
+        """
+        date_epoch_ns = None
+
+        if date is not None:
+            if isinstance(date, np.datetime64):
+                date_epoch_ns = int(date.astype("datetime64[ns]").view(np.int64))
+            else:
+                date = pd.Timestamp(date)
+                if date.tz is None or str(date.tz) != "UTC":
+                    raise ValueError("`date` must be UTC datetime.")
+                date_epoch_ns = date.value
+
+        self._stream.append_candle(float(open), float(high), float(low), float(close), date_epoch_ns)
+
+    def update_last_candle(self, open: float, high: float, low: float, close: float):
+        """Overwrite the most recent candle (e.g. a live, not yet closed, bar).
+
+        Parameters
+        ----------
+        open
+           New open price.
+        high
+           New high price.
+        low
+           New low price.
+        close
+           New close price.
+        """
+        self._stream.update_last_candle(float(open), float(high), float(low), float(close))
+
+    @property
+    def num_dropped(self) -> int:
+        """Number of updates dropped because the queue was full (`backpressure="drop"`), the overflow was full (`backpressure="merge"`) or the plot was closed."""
+        return self._stream.num_dropped()
+
+
 # -------------------------------------------------------------------------------------
 # Plotter
 # -------------------------------------------------------------------------------------
@@ -98,7 +320,11 @@ class Plotter:
         axis_tick_label_font_size: int = 12,
         axis_right: bool = True,
         width_margin_size: int = 50,
-        height_margin_size: int = 25
+        height_margin_size: int = 25,
+        headless: bool = False,
+        ui_thread: bool = False,
+        program_binary_cache: bool = True,
+        program_binary_cache_dir: str | Path | None = None
     ):
         """ The Plotter class controls all plotting.
 
@@ -124,6 +350,23 @@ class Plotter:
             Size of margin between y-axis and the edge of the figure.
         height_margin_size
             Size of the margin between the x-axis and the bottom edge of the figure.
+        headless
+            If `True`, the figure is never displayed and is only rendered to images
+            (see `render_to_image()`, `save_png()`). Uses the "offscreen" Qt platform
+            unless `QT_QPA_PLATFORM` is already set, so no display is required.
+            `start()` cannot be called on a headless plotter.
+        ui_thread
+            If `True`, the Qt event loop runs on a dedicated thread, so the figure can be
+            displayed with `start_async()` while the calling thread keeps running. All
+            Plotter calls are run on that thread. Closing the window hides it. Not
+            supported on macOS.
+        program_binary_cache
+            If `True`, linked shader programs are stored on disk (where the driver
+            supports program binaries) and reused by later plotters and runs instead
+            of compiling the shaders, which shortens startup.
+        program_binary_cache_dir
+            Directory of the program binary cache. If `None`, `rallyplot/program_binaries`
+            in the user cache directory is used (e.g. `~/.cache/rallyplot/program_binaries`).
 
         """
         # Patch the QT_PLUGIN_PATH to use our vendored plugins. This only needs to
@@ -143,7 +386,11 @@ class Plotter:
             axis_tick_label_font_size=axis_tick_label_font_size,
             axis_right=axis_right,
             width_margin_size=width_margin_size,
-            height_margin_size=height_margin_size
+            height_margin_size=height_margin_size,
+            headless=headless,
+            ui_thread=ui_thread,
+            program_binary_cache=program_binary_cache,
+            program_binary_cache_dir=None if program_binary_cache_dir is None else str(program_binary_cache_dir)
         )
 
         if orig_paths:
@@ -155,9 +402,23 @@ class Plotter:
         return self._plotter._grab_frame_buffer(row, col)
 
     def start(self):
-        """Start the event loop to display and interact with plots. """
+        """Start the event loop to display and interact with plots.
+
+        Blocks until the window is closed. With `ui_thread=True` the GIL is released
+        while waiting, so other Python threads keep running. Otherwise the event loop
+        runs on this thread and the GIL is held, as the plotter may only be used from it.
+        """
         self._plotter.start()
 
+    def start_async(self):
+        """Display the plots and return immediately, the event loop runs on the UI thread.
+
+        Requires the Plotter to be created with `ui_thread=True`. Plotter calls made
+        afterwards (e.g. `append_candles()`) update the displayed window. Can be called
+        again to re-open the window once it is closed.
+        """
+        self._plotter.start_async()
+
     def finish(self):
         """Ensure c++ side is completely cleared.
 
@@ -172,6 +433,126 @@ class Plotter:
     def resize(self, width: int, height: int):
         self._plotter.resize(width, height)
 
+    def render_to_image(self, width: int, height: int, dpi: int = 96) -> np.ndarray:
+        """Render the whole figure (all subplots) offscreen to an image.
+
+        The figure is laid out at the requested size for the render only,
+        the window size is not changed. Works in headless mode.
+
+        Parameters
+        ----------
+
+        width
+            Image width in pixels.
+        height
+            Image height in pixels.
+        dpi
+            Resolution stored in the image metadata (does not change the rendering).
+
+        Returns
+        -------
+
+        image
+            (height, width, 4) uint8 RGBA array, the first row is the top of the figure.
+        """
+        return self._plotter.render_to_image(width, height, dpi)
+
+    def save_png(
+        self,
+        filepath: str | Path,
+        width: int | None = None,
+        height: int | None = None,
+        dpi: int = 96
+    ):
+        """Render the whole figure offscreen and save it as a .png file.
+
+        Parameters
+        ----------
+
+        filepath
+            Path to the output .png file.
+        width
+            Image width in pixels. If `None`, the current window width is used.
+        height
+            Image height in pixels. If `None`, the current window height is used.
+        dpi
+            Resolution stored in the .png metadata.
+        """
+        self._plotter.save_png(str(filepath), width, height, dpi)
+
+    def enable_profiler(self, enabled: bool = True):
+        """Record the CPU and GPU time of each stage of every frame drawn (all subplots).
+
+        The last 512 frames drawn by each subplot are kept, see `profiler_stats()`
+        and `save_profiler_trace()`. Enabling clears the previously recorded frames.
+        GPU times are read a few frames after they are drawn, so the most recent
+        frames may not be included yet. When disabled (the default), the profiler
+        has no measurable cost.
+
+        Parameters
+        ----------
+
+        enabled
+            If `True` frames are recorded, otherwise recording is stopped
+            (the recorded frames are kept).
+        """
+        self._plotter.enable_profiler(enabled)
+
+    def profiler_stats(self) -> pd.DataFrame:
+        """Per-frame CPU and GPU time percentiles of each stage, for the active subplot.
+
+        Stages are "frame" (the whole frame), "plotLayer", "axes", "ticks",
+        "tickLabels", "candlestickPlot", "linePlot", "barPlot", "scatterPlot",
+        "drawLines", "legend", "pinnedYLimits" and "overlays" (crosshair and
+        hover popup). Only stages drawn in at least one recorded frame are
+        included. Stages drawn more than once per frame (e.g. the axes of
+        each linked subplot) are summed.
+
+        Returns
+        -------
+
+        stats
+            DataFrame with columns "stage", "num_frames" (frames in which the stage
+            was drawn), "cpu_p50_ms", "cpu_p95_ms", "cpu_p99_ms", "gpu_p50_ms",
+            "gpu_p95_ms" and "gpu_p99_ms".
+        """
+        return pd.DataFrame(self._plotter.profiler_stats())
+
+    def startup_stats(self) -> dict:
+        """Time to first frame of the plotter, from its construction.
+
+        Work not needed to draw the first frame (e.g. uploading the zoomed-in
+        levels of detail of large candlestick plots) is done after it is shown,
+        when the window is idle. The first frame of the last window shown is
+        reported, or (headless) the first frame rendered.
+
+        Returns
+        -------
+
+        stats
+            Dict of times in milliseconds from the construction of the plotter (NaN
+            if not yet reached): "application_ms" (Qt application constructed),
+            "window_setup_ms" (window and OpenGL context setup), "first_frame_ms"
+            (first frame drawn), "first_frame_draw_ms" (time to draw the first frame),
+            "deferred_work_ms" (total time of the work done after the first frame)
+            and "deferred_work_done_ms" (all deferred work done).
+        """
+        return self._plotter.startup_stats()
+
+    def save_profiler_trace(self, filepath: str | Path):
+        """Save the recorded frames of the active subplot in the Chrome trace event format.
+
+        The .json file can be opened in chrome://tracing or https://ui.perfetto.dev.
+        CPU stages are shown on the "CPU" thread and GPU stages on the "GPU" thread.
+
+        Parameters
+        ----------
+
+        filepath
+            Path to the output .json file.
+        """
+        self._plotter.save_profiler_trace(str(filepath))
+
     def set_background_color(self, color: Array):
         """Set the background color for the subplot.
 
@@ -623,7 +1004,8 @@ class Plotter:
         ----------
         label_names
             A list of label names for the legend. Must be the same length
-            as the number of plots in the linked subplot.
+            as the number of plots in the linked subplot. Any character in
+            the font may be used, e.g. currency symbols such as "€" or "£".
         linked_subplot_idx
             Linked subplot on which to add the legend.
         legend_size_scalar
@@ -903,7 +1285,7 @@ class Plotter:
         close = self._handle_data_array(close)
 
         if dates is not None:
-            dates : pythonBindings.DatetimeVector | pythonBindings.StringVector
+            dates : pythonBindings.DatetimeVector | pythonBindings.StringVector | pythonBindings.EpochNsDates
             dates = self._check_and_process_dates(dates)
 
         self._plotter.candlestick(
@@ -923,6 +1305,174 @@ class Plotter:
             line_mode_basic_line=line_mode_basic_line
         )
 
+    def candlestick_from_file(
+        self,
+        candle_file: CandleFile,
+        linked_subplot_idx: int = -1,
+        up_color: Array = (0.0314, 0.6, 0.506, 1.0),
+        down_color: Array = (0.957, 0.204, 0.266, 1.0),
+        mode: CandlestickMode = "no_caps",
+        candle_width_ratio: float = 0.75,
+        cap_width_ratio: float = 0.5,
+        line_mode_linewidth: float = 1.0,
+        line_mode_miter_limit: float = 3.0,
+        line_mode_basic_line: bool = False
+    ):
+        """
+        Add a candlestick plot of a columnar candle file to the linked subplot.
+
+        The data is plotted directly from the memory-mapped file without a copy, and
+        the file's zone maps are used to set up the y-axis range without scanning
+        the data. The dates stored in the file (if any) are used as x-axis labels.
+
+        Parameters
+        ----------
+        candle_file
+            The candle file, see `CandleFile` and `write_candle_file()`.
+        linked_subplot_idx
+           The index of the linked subplot on which to plot the candlesticks. By default, it is the most recently added linked subplot.
+        up_color
+            Color (array-like, length 1-4, RGBA) for candles when close price is higher than open price.
+        down_color
+            Color (array-like, length 1-4, RGBA) for candles when open price is lower than close price.
+        mode
+            Control how candles are displayed (see CandlestickMode).
+        candle_width_ratio
+            Ratio between candle and gap width, a float between (0, 1] e.g. 1 is no space between candles.
+        cap_width_ratio
+            Ratio between candle and cap width, a double between (0, 1] e.g. 1 the cap is the width of the candle.
+        line_mode_linewidth
+            Line width for open-line and close-line mode for the candlestick plot.
+        line_mode_miter_limit
+            Miter limit controls the maximum line-segment connection length, for open-line and close-line mode.
+        line_mode_basic_line
+            If `true`, a simple line plot with fixd width is used (`width` and `miterLimit` have no effect). This is much faster.
+        """
+        self._plotter.candlestick_from_file(
+            file=candle_file._file,
+            linked_subplot_idx=linked_subplot_idx,
+            up_color=self._to_list(up_color),
+            down_color=self._to_list(down_color),
+            mode=mode,
+            candle_width_ratio=candle_width_ratio,
+            cap_width_ratio=cap_width_ratio,
+            line_mode_linewidth=line_mode_linewidth,
+            line_mode_miter_limit=line_mode_miter_limit,
+            line_mode_basic_line=line_mode_basic_line
+        )
+
+    def append_candles(
+        self,
+        open: np.ndarray,
+        high: np.ndarray,
+        low: np.ndarray,
+        close: np.ndarray,
+        dates: Dates | None = None,
+        linked_subplot_idx: int = -1,
+    ):
+        """
+        Append candles to an existing candlestick plot, e.g. from a live data feed.
+
+        The candlestick plot must be the only plot on the linked subplot. The
+        appended data is copied, only the new candles are uploaded to the GPU.
+
+        Parameters
+        ----------
+        open
+           Vector of candle open prices to append.
+        high
+           Vector of candle high prices to append.
+        low
+           Vector of candle low prices to append.
+        close
+           Vector of candle close prices to append.
+        dates
+            Dates for the new candles. Must be passed if the plot was created with `dates`,
+            and be of the same type (string labels or UTC datetime).
+        linked_subplot_idx
+           The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+        """
+        open = self._handle_data_array(open)
+        high = self._handle_data_array(high)
+        low = self._handle_data_array(low)
+        close = self._handle_data_array(close)
+
+        if dates is not None:
+            dates : pythonBindings.DatetimeVector | pythonBindings.StringVector | pythonBindings.EpochNsDates
+            dates = self._check_and_process_dates(dates)
+
+        self._plotter.append_candles(
+            open=open,
+            high=high,
+            low=low,
+            close=close,
+            dates=dates,
+            linked_subplot_idx=linked_subplot_idx
+        )
+
+    def update_last_candle(
+        self,
+        open: float,
+        high: float,
+        low: float,
+        close: float,
+        linked_subplot_idx: int = -1,
+    ):
+        """
+        Overwrite the most recent candle of a candlestick plot (e.g. a live, not yet closed, bar).
+
+        Parameters
+        ----------
+        open
+           New open price.
+        high
+           New high price.
+        low
+           New low price.
+        close
+           New close price.
+        linked_subplot_idx
+           The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+        """
+        self._plotter.update_last_candle(
+            open=float(open),
+            high=float(high),
+            low=float(low),
+            close=float(close),
+            linked_subplot_idx=linked_subplot_idx
+        )
+
+    def candle_stream(
+        self,
+        linked_subplot_idx: int = -1,
+        backpressure: BackpressureType = "merge",
+    ) -> CandleStream:
+        """
+        Create a stream to feed candles to a candlestick plot from other threads.
+
+        Use this instead of `append_candles()` and `update_last_candle()`, which must be
+        called from the thread that created the Plotter. The candlestick plot must be the
+        only plot on the linked subplot, and have no dates or UTC datetime dates.
+
+        Parameters
+        ----------
+        linked_subplot_idx
+           The index of the linked subplot holding the candlestick plot. By default, it is the most recently added linked subplot.
+        backpressure
+            What to do when candles are pushed faster than they are drawn and the queue is
+            full. "drop" discards the candle, "merge" keeps it in an overflow buffer (merging
+            `update_last_candle()` calls, at most 2^22 candles are kept and later ones dropped),
+            "block" waits until the queue is drained (it raises if called from the plotter's
+            thread, which drains the queue).
+
+        Returns
+        -------
+        A `CandleStream`, its methods can be called from any thread.
+        """
+        return CandleStream(
+            self._plotter.candle_stream(linked_subplot_idx=linked_subplot_idx, backpressure=backpressure)
+        )
+
     def line(
         self,
         y: np.ndarray | pd.Series,
@@ -957,7 +1507,7 @@ class Plotter:
         y = self._handle_data_array(y)
 
         if dates is not None:
-            dates : pythonBindings.DatetimeVector | pythonBindings.StringVector
+            dates : pythonBindings.DatetimeVector | pythonBindings.StringVector | pythonBindings.EpochNsDates
             dates = self._check_and_process_dates(dates)
 
         self._plotter.line(
@@ -1001,7 +1551,7 @@ class Plotter:
         y = self._handle_data_array(y)
 
         if dates is not None:
-            dates : pythonBindings.DatetimeVector | pythonBindings.StringVector
+            dates : pythonBindings.DatetimeVector | pythonBindings.StringVector | pythonBindings.EpochNsDates
             dates = self._check_and_process_dates(dates)
 
         self._plotter.bar(
@@ -1031,7 +1581,8 @@ class Plotter:
         ----------
         x
             A numpy array of indexes, or list of string or datetimes (UTC) of x-axis position of the scatter points.
-            The type must match the current x tick label type.
+            The type must match the current x tick label type. Datetimes are placed at the last x-axis
+            date at or before them.
         y
             Vector of floats containing y-axis data. Must match x in length.
         linked_subplot_idx
@@ -1080,20 +1631,24 @@ class Plotter:
         """Handle a list of dates.
 
         Return a processed list of dates. Under the hood these are transferred to the C++
-        side with Pybind11, so must be converted to special C++-side vectors. This
-        requires a copy operation (numpy arrays used for actual data are not copied).
+        side with Pybind11, so must be converted to special C++-side vectors. Lists of
+        strings or datetimes require a copy operation. Datetime64 arrays, Series and
+        DatetimeIndex are passed as int64 nanoseconds since the epoch without copying
+        (numpy datetime64 arrays have no timezone and are assumed to be UTC).
         """
         if dates is None:
             return None
 
+        epoch_ns = _datetime64_to_epoch_ns(dates)
+
+        if epoch_ns is not None:
+            return pythonBindings.EpochNsDates(epoch_ns)
+
         if isinstance(dates, np.ndarray):
             dates = dates.tolist()
 
         if isinstance(dates, pd.Series):
-            if pd.api.types.is_datetime64_any_dtype(dates):
-                dates = dates.dt.to_pydatetime().tolist()
-            else:
-                dates = dates.astype(str).tolist()
+            dates = dates.astype(str).tolist()
 
         if isinstance(dates[0], datetime):
             if dates[0].tzinfo != timezone.utc:
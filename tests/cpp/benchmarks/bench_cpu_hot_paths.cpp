@@ -0,0 +1,475 @@
+// Micro-benchmarks for the CPU hot paths that do not need a GL context,
+// so they run on plain CI machines (no window, no GPU):
+//
+//   - JointPlotData::addPlot (recomputeMinMax, for one plot and for two
+//     plots, where the min / max vectors are combined)
+//   - JointPlotData::getMinMaxInViewRange over random view windows
+//   - SharedXData::handleNewXDataVector (timepoint and epoch ns dates)
+//   - SharedXData::getXTickLabelDatetime
+//   - AxisTickLabels::layoutTickLabelVertices (the CPU half of writeTextToBuffer)
+//   - CandlestickPlot::interleaveInstanceData (the instance buffer upload loop)
+//   - readCandleDataCSV (what Plotter::_readDataFromCSV calls)
+//
+// Each benchmark repeats the operation until a sample takes at least 10 ms
+// and reports the median time per operation over 5 samples. The
+// benchmarks link against internal classes, see CMakeLists.txt.
+//
+// Usage: benchCpuHotPaths [--sizes 10000,100000,1000000,10000000] [--json results.json]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Plotter.h"
+#include "../../../src/cpp/Configs.h"
+#include "../../../src/cpp/structure/JointPlotData.h"
+#include "../../../src/cpp/structure/SharedXData.h"
+#include "../../../src/cpp/charts/AxisTickLabels.h"
+#include "../../../src/cpp/charts/plots/CandlestickPlot.h"
+
+
+/* --------------------------------------------------------------
+    Plots without GL resources, only the data is used by JointPlotData
+ --------------------------------------------------------------*/
+
+class BenchCandlestickPlot : public FourValuePlot
+{
+public:
+    BenchCandlestickPlot(Configs& configs, const std::vector<float>& open, const std::vector<float>& high,
+                         const std::vector<float>& low, const std::vector<float>& close)
+        : m_plotData(configs, open.data(), open.size(), high.data(), high.size(),
+                     low.data(), low.size(), close.data(), close.size())
+    {
+    };
+
+    void draw(glm::mat4& NDCMatrix, Camera& camera) override {};
+    ProfileStage profileStage() const override { return ProfileStage::candlestickPlot; };
+
+    const CandlestickData& getPlotData() const override { return m_plotData; };
+    CandlestickColor getPlotColor() const override { return {}; };
+
+private:
+    CandlestickData m_plotData;
+};
+
+
+class BenchLinePlot : public OneValuePlot
+{
+public:
+    BenchLinePlot(Configs& configs, const std::vector<float>& y)
+        : m_plotData(configs, y.data(), y.size())
+    {
+    };
+
+    void draw(glm::mat4& NDCMatrix, Camera& camera) override {};
+    ProfileStage profileStage() const override { return ProfileStage::linePlot; };
+
+    const LineData& getPlotData() const override { return m_plotData; };
+    PlotColor getPlotColor() const override { return {}; };
+
+private:
+    LineData m_plotData;
+};
+
+
+/* --------------------------------------------------------------
+    Timing
+ --------------------------------------------------------------*/
+
+struct BenchResult
+{
+    std::string name;
+    std::size_t size;
+    double nsPerOp;
+};
+
+
+double medianNsPerOp(const std::function<void()>& operation)
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double minSampleNs = 10e6;
+    constexpr int numSamples = 5;
+
+    auto runNs = [&](std::size_t numOps)
+    {
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < numOps; i++)
+        {
+            operation();
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    // Calibrate the number of operations per sample
+    std::size_t numOps = 1;
+    double elapsedNs = runNs(numOps);
+
+    while (elapsedNs < minSampleNs)
+    {
+        numOps = std::max(numOps * 2, (std::size_t)(numOps * 1.2 * minSampleNs / std::max(elapsedNs, 1.0)));
+        elapsedNs = runNs(numOps);
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < numSamples; i++)
+    {
+        samples.push_back(runNs(numOps) / numOps);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    return samples[numSamples / 2];
+}
+
+
+/* --------------------------------------------------------------
+    Data
+ --------------------------------------------------------------*/
+
+struct OHLC
+{
+    std::vector<float> open, high, low, close;
+};
+
+
+OHLC randomWalkCandles(std::size_t size, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> step(0.0f, 1.0f);
+    std::uniform_real_distribution<float> spread(0.0f, 2.0f);
+
+    OHLC candles;
+    float price = 1000.0f;
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        float open = price;
+        price += step(rng);
+
+        candles.open.push_back(open);
+        candles.high.push_back(std::max(open, price) + spread(rng));
+        candles.low.push_back(std::min(open, price) - spread(rng));
+        candles.close.push_back(price);
+    }
+    return candles;
+}
+
+
+std::unordered_map<char32_t, Character> syntheticCharacters()
+/*
+    Glyph metrics roughly matching a 12 px font, laid
+    out along one row as in CharTextureAtlas.
+ */
+{
+    std::unordered_map<char32_t, Character> chars;
+    int xTexturePos = 0;
+
+    for (char32_t c = 32; c < 127; c++)
+    {
+        chars[c] = Character{glm::ivec2(7, 12), glm::ivec2(1, 10), 8 << 6, xTexturePos, 0};
+        xTexturePos += 8;
+    }
+    return chars;
+}
+
+
+bool writeCsv(const std::string& filepath, const OHLC& candles)
+{
+    std::FILE* file = std::fopen(filepath.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "Date,Open,High,Low,Close\n");
+
+    for (std::size_t i = 0; i < candles.open.size(); i++)
+    {
+        std::size_t minutes = i % 60, hours = (i / 60) % 24, days = i / 1440;
+
+        std::fprintf(
+            file, "%04zu-%02zu-%02zuT%02zu:%02zu:00Z,%.4f,%.4f,%.4f,%.4f\n",
+            2000 + days / 336, 1 + (days / 28) % 12, 1 + days % 28, hours, minutes,
+            candles.open[i], candles.high[i], candles.low[i], candles.close[i]
+        );
+    }
+    std::fclose(file);
+
+    return true;
+}
+
+
+/* --------------------------------------------------------------
+    Benchmarks
+ --------------------------------------------------------------*/
+
+void runSize(std::size_t size, Configs& configs, std::vector<BenchResult>& results)
+{
+    constexpr std::size_t maxCsvSize = 1'000'000;  // larger files are slow to write for little gain
+
+    double checksum = 0.0;
+
+    auto record = [&](const std::string& name, const std::function<void()>& operation)
+    {
+        results.push_back(BenchResult{name, size, medianNsPerOp(operation)});
+        std::printf("%-44s %12zu %16.1f\n", name.c_str(), size, results.back().nsPerOp);
+    };
+
+    OHLC candles = randomWalkCandles(size, 42);
+
+    // JointPlotData
+    record("JointPlotData::addPlot (1 plot)", [&]
+    {
+        JointPlotData jointPlotData;
+        jointPlotData.addPlot(std::make_unique<BenchCandlestickPlot>(configs, candles.open, candles.high, candles.low, candles.close));
+        checksum += jointPlotData.getDataMaxY();
+    });
+
+    record("JointPlotData::addPlot (2 plots)", [&]
+    {
+        JointPlotData jointPlotData;
+        jointPlotData.addPlot(std::make_unique<BenchCandlestickPlot>(configs, candles.open, candles.high, candles.low, candles.close));
+        jointPlotData.addPlot(std::make_unique<BenchLinePlot>(configs, candles.close));
+        checksum += jointPlotData.getDataMaxY();
+    });
+
+    {
+        JointPlotData jointPlotData;
+        jointPlotData.addPlot(std::make_unique<BenchCandlestickPlot>(configs, candles.open, candles.high, candles.low, candles.close));
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> border(0.0, 1.0);
+
+        std::vector<std::pair<double, double>> windows(4096);
+        for (auto& [left, right] : windows)
+        {
+            left = border(rng);
+            right = border(rng);
+            if (left > right)
+            {
+                std::swap(left, right);
+            }
+        }
+
+        std::size_t windowIdx = 0;
+        record("JointPlotData::getMinMaxInViewRange", [&]
+        {
+            const auto& [left, right] = windows[windowIdx++ % windows.size()];
+            auto [minY, maxY] = jointPlotData.getMinMaxInViewRange(left, right);
+            checksum += minY + maxY;
+        });
+    }
+
+    // SharedXData
+    std::vector<std::int64_t> epochNsDates(size);
+    std::vector<std::chrono::system_clock::time_point> timepointDates(size);
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        epochNsDates[i] = 946'684'800'000'000'000LL + (std::int64_t)i * 60'000'000'000LL;  // one per minute from 2000-01-01
+        timepointDates[i] = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(epochNsDates[i]))
+        );
+    }
+
+    record("SharedXData::handleNewXDataVector (ns)", [&]
+    {
+        SharedXData sharedXData;
+        sharedXData.handleNewXDataVector(EpochNsVector(epochNsDates.data(), epochNsDates.size()));
+        checksum += (double)sharedXData.xDataVersion();
+    });
+
+    record("SharedXData::handleNewXDataVector (timepoint)", [&]
+    {
+        SharedXData sharedXData;
+        sharedXData.handleNewXDataVector(std::cref(timepointDates));
+        checksum += (double)sharedXData.xDataVersion();
+    });
+
+    {
+        SharedXData sharedXData;
+        sharedXData.handleNewXDataVector(EpochNsVector(epochNsDates.data(), epochNsDates.size()));
+
+        // Ticks spread over the last tenth of the data, as when zoomed in
+        constexpr int numTicks = 12;
+        std::vector<int> tickIndices;
+        for (int i = 0; i < numTicks; i++)
+        {
+            tickIndices.push_back((int)(size - size / 10 + i * (size / 10 - 1) / (numTicks - 1)));
+        }
+
+        record("SharedXData::getXTickLabelDatetime", [&]
+        {
+            checksum += (double)sharedXData.getXTickLabelDatetime(tickIndices).size();
+        });
+    }
+
+    // Candlestick instance data
+    {
+        std::unique_ptr<BenchCandlestickPlot> plot = std::make_unique<BenchCandlestickPlot>(
+            configs, candles.open, candles.high, candles.low, candles.close
+        );
+        std::vector<float> instanceData;
+
+        record("CandlestickPlot::interleaveInstanceData", [&]
+        {
+            CandlestickPlot::interleaveInstanceData(plot->getPlotData(), 0, size, instanceData);
+            checksum += instanceData.back();
+        });
+    }
+
+    // .csv reading
+    if (size <= maxCsvSize)
+    {
+        std::string filepath = "bench_cpu_hot_paths_tmp.csv";
+
+        if (writeCsv(filepath, candles))
+        {
+            record("readCandleDataCSV", [&]
+            {
+                checksum += readCandleDataCSV(filepath).close.back();
+            });
+        }
+        std::remove(filepath.c_str());
+    }
+
+    if (checksum == 0.123)  // keep the results live
+    {
+        std::printf("\n");
+    }
+}
+
+
+void runTickLabels(std::vector<BenchResult>& results)
+/*
+    Tick label layout does not depend on the data size,
+    only on the number of ticks (and characters per tick).
+ */
+{
+    std::unordered_map<char32_t, Character> chars = syntheticCharacters();
+
+    for (int numTicks : {10, 25})
+    {
+        std::vector<std::string> xTickText, yTickText;
+        for (int i = 0; i < numTicks; i++)
+        {
+            xTickText.push_back("Jan " + std::to_string(1 + i) + " 12:" + std::to_string(10 + i % 50));
+            yTickText.push_back(std::to_string(1000 + 7 * i) + ".25");
+        }
+
+        std::vector<float> vertices;
+
+        for (bool isXAxis : {true, false})
+        {
+            std::string name = isXAxis ? "AxisTickLabels::layout (x axis)" : "AxisTickLabels::layout (y axis)";
+            const std::vector<std::string>& tickText = isXAxis ? xTickText : yTickText;
+
+            double nsPerOp = medianNsPerOp([&]
+            {
+                vertices.clear();
+                AxisTickLabels::layoutTickLabelVertices(tickText, chars, 12, isXAxis, true, vertices);
+            });
+
+            results.push_back(BenchResult{name, (std::size_t)numTicks, nsPerOp});
+            std::printf("%-44s %12d %16.1f\n", name.c_str(), numTicks, nsPerOp);
+        }
+    }
+}
+
+
+std::vector<std::size_t> parseSizes(const std::string& sizesArg)
+{
+    std::vector<std::size_t> sizes;
+    std::stringstream stream(sizesArg);
+    std::string size;
+
+    while (std::getline(stream, size, ','))
+    {
+        sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+    }
+    return sizes;
+}
+
+
+bool writeJson(const std::string& filepath, const std::vector<BenchResult>& results)
+{
+    std::FILE* file = std::fopen(filepath.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "{\n  \"schema\": 1,\n  \"benchmarks\": [\n");
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        std::fprintf(
+            file, "    {\"name\": \"%s\", \"size\": %zu, \"nsPerOp\": %.3f}%s\n",
+            results[i].name.c_str(), results[i].size, results[i].nsPerOp, i + 1 < results.size() ? "," : ""
+        );
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> sizes = {10'000, 100'000, 1'000'000, 10'000'000};
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc)
+        {
+            sizes = parseSizes(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else
+        {
+            std::printf("Usage: benchCpuHotPaths [--sizes 10000,100000,...] [--json results.json]\n");
+            return 1;
+        }
+    }
+
+    // Only the plot options are used by the data classes
+    Configs configs(PlotOptions{ColorMode::light, Font::arial, 12, true, 0, 0, 800, 600});
+
+    std::vector<BenchResult> results;
+
+    std::printf("%-44s %12s %16s\n", "benchmark", "size", "time / op (ns)");
+
+    for (std::size_t size : sizes)
+    {
+        if (size < 100)
+        {
+            std::printf("Sizes must be at least 100, skipping %zu\n", size);
+            continue;
+        }
+        runSize(size, configs, results);
+    }
+
+    runTickLabels(results);
+
+    if (!jsonPath.empty() && !writeJson(jsonPath, results))
+    {
+        std::printf("Could not write %s\n", jsonPath.c_str());
+        return 1;
+    }
+
+    return 0;
+}
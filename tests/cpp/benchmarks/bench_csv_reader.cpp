@@ -0,0 +1,134 @@
+// Benchmark for reading OHLC .csv files. Writes a temporary file with ISO-8601
+// dates and compares the previous row-by-row reader (fast-cpp-csv-parser,
+// growing the columns with push_back) against readCandleDataCSV with one
+// thread and with all hardware threads. The values read are checked to match.
+//
+// Usage: benchCsvReader [numRows]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <csv.h>
+#include "Plotter.h"
+
+
+CandleDataCSV readWithCsvParser(const std::string& filepath)
+{
+    CandleDataCSV candleData;
+
+    float open, close, low, high;
+    std::string dates;
+
+    io::CSVReader<5> in(filepath);
+    in.read_header(io::ignore_extra_column, "Open", "Close", "Low", "High", "Date");
+
+    while (in.read_row(open, close, low, high, dates))
+    {
+        candleData.open.push_back(open);
+        candleData.close.push_back(close);
+        candleData.low.push_back(low);
+        candleData.high.push_back(high);
+        candleData.dates.push_back(dates);
+    }
+    return candleData;
+}
+
+
+bool columnsMatch(const std::vector<float>& expected, const std::vector<float>& actual)
+{
+    if (expected.size() != actual.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        if (std::abs(expected[i] - actual[i]) > 1e-6f * std::abs(expected[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template <typename Function>
+double timeMs(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::size_t numRows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5'000'000;
+
+    std::string filepath = "bench_csv_reader_tmp.csv";
+
+    // Random walk OHLC data, one row per minute
+    std::FILE* file = std::fopen(filepath.c_str(), "w");
+    if (!file)
+    {
+        std::printf("Could not write %s\n", filepath.c_str());
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> step(0.0f, 1.0f);
+    std::uniform_real_distribution<float> spread(0.0f, 2.0f);
+
+    std::fprintf(file, "Date,Open,High,Low,Close,Volume\n");
+
+    float price = 1000.0f;
+    for (std::size_t i = 0; i < numRows; i++)
+    {
+        std::size_t minutes = i % 60, hours = (i / 60) % 24, days = i / 1440;
+
+        float open = price;
+        price += step(rng);
+
+        std::fprintf(
+            file, "%04zu-%02zu-%02zuT%02zu:%02zu:00Z,%.4f,%.4f,%.4f,%.4f,%zu\n",
+            2000 + days / 336, 1 + (days / 28) % 12, 1 + days % 28, hours, minutes,
+            open, std::max(open, price) + spread(rng), std::min(open, price) - spread(rng), price, i
+        );
+    }
+    std::fclose(file);
+
+    CandleDataCSV expected, singleThread, multiThread;
+    unsigned int numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    double csvParserMs = timeMs([&]() { expected = readWithCsvParser(filepath); });
+    double singleThreadMs = timeMs([&]() { singleThread = readCandleDataCSV(filepath, 1); });
+    double multiThreadMs = timeMs([&]() { multiThread = readCandleDataCSV(filepath, numThreads); });
+
+    std::remove(filepath.c_str());
+
+    std::printf("rows: %zu\n\n", numRows);
+    std::printf("%32s %12s %10s\n", "reader", "time (ms)", "speedup");
+    std::printf("%32s %12.1f %10.2f\n", "fast-cpp-csv-parser", csvParserMs, 1.0);
+    std::printf("%32s %12.1f %10.2f\n", "readCandleDataCSV (1 thread)", singleThreadMs, csvParserMs / singleThreadMs);
+    std::printf("%29s %2u) %12.1f %10.2f\n", "readCandleDataCSV (threads:", numThreads, multiThreadMs, csvParserMs / multiThreadMs);
+
+    for (const CandleDataCSV* result : {&singleThread, &multiThread})
+    {
+        if (!columnsMatch(expected.open, result->open) || !columnsMatch(expected.high, result->high) ||
+            !columnsMatch(expected.low, result->low) || !columnsMatch(expected.close, result->close) ||
+            result->datesEpochNs.size() != numRows || !result->dates.empty())
+        {
+            std::printf("\nERROR: readCandleDataCSV values do not match.\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
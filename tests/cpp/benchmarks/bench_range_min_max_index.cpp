@@ -0,0 +1,116 @@
+// Micro-benchmark for the visible-range min / max query used to pin the
+// y-axis (JointPlotData::getMinMaxInViewRange). Compares a linear scan over
+// the visible range (the previous implementation) against RangeMinMaxIndex
+// for a range of zoom levels. The index query time should be flat.
+//
+// Usage: benchRangeMinMaxIndex [numDatapoints]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../../../src/cpp/structure/RangeMinMaxIndex.h"
+
+
+double timeQueriesNs(
+    std::size_t numDatapoints, std::size_t viewWidth, int numQueries,
+    const std::vector<std::size_t>& startIndices, bool useIndex,
+    const std::vector<float>& lows, const std::vector<float>& highs,
+    const RangeMinMaxIndex& index, double& checksum
+)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < numQueries; i++)
+    {
+        std::size_t startIdx = startIndices[i] % (numDatapoints - viewWidth + 1);
+        std::size_t endIdx = startIdx + viewWidth;
+
+        if (useIndex)
+        {
+            std::pair<float, float> minMax = index.getMinMax(startIdx, endIdx);
+            checksum += minMax.first + minMax.second;
+        }
+        else
+        {
+            checksum += *std::min_element(lows.begin() + startIdx, lows.begin() + endIdx);
+            checksum += *std::max_element(highs.begin() + startIdx, highs.begin() + endIdx);
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / numQueries;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::size_t numDatapoints = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+
+    // Random walk OHLC-like data
+    std::mt19937 rng(42);
+    std::normal_distribution<float> step(0.0f, 1.0f);
+    std::uniform_real_distribution<float> spread(0.0f, 2.0f);
+
+    std::vector<float> lows(numDatapoints);
+    std::vector<float> highs(numDatapoints);
+
+    float price = 1000.0f;
+    for (std::size_t i = 0; i < numDatapoints; i++)
+    {
+        price += step(rng);
+        lows[i] = price - spread(rng);
+        highs[i] = price + spread(rng);
+    }
+
+    RangeMinMaxIndex index;
+
+    auto buildStart = std::chrono::steady_clock::now();
+    index.build(StdPtrVector<float>(lows.data(), lows.size()), StdPtrVector<float>(highs.data(), highs.size()));
+    auto buildEnd = std::chrono::steady_clock::now();
+
+    std::printf("datapoints: %zu, index build: %.2f ms\n\n", numDatapoints,
+                std::chrono::duration<double, std::milli>(buildEnd - buildStart).count());
+
+    std::printf("%14s %18s %18s\n", "view width", "linear scan (ns)", "index (ns)");
+
+    const int numQueries = 200;
+    std::vector<std::size_t> startIndices(numQueries);
+    for (std::size_t& startIdx : startIndices)
+    {
+        startIdx = rng();
+    }
+
+    double checksum = 0.0;
+
+    for (std::size_t viewWidth = 100; viewWidth <= numDatapoints; viewWidth *= 10)
+    {
+        double scanNs = timeQueriesNs(numDatapoints, viewWidth, numQueries, startIndices, false, lows, highs, index, checksum);
+        double indexNs = timeQueriesNs(numDatapoints, viewWidth, numQueries, startIndices, true, lows, highs, index, checksum);
+
+        std::printf("%14zu %18.1f %18.1f\n", viewWidth, scanNs, indexNs);
+    }
+
+    // Check the index against a linear scan
+    for (int i = 0; i < numQueries; i++)
+    {
+        std::size_t startIdx = startIndices[i] % numDatapoints;
+        std::size_t endIdx = std::min(numDatapoints, startIdx + 1 + startIndices[numQueries - 1 - i] % numDatapoints);
+
+        std::pair<float, float> minMax = index.getMinMax(startIdx, endIdx);
+
+        if (minMax.first != *std::min_element(lows.begin() + startIdx, lows.begin() + endIdx) ||
+            minMax.second != *std::max_element(highs.begin() + startIdx, highs.begin() + endIdx))
+        {
+            std::printf("\nERROR: index result does not match linear scan for [%zu, %zu).\n", startIdx, endIdx);
+            return 1;
+        }
+    }
+
+    std::printf("\n(checksum %.1f)\n", checksum);
+
+    return 0;
+}
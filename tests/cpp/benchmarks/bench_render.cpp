@@ -0,0 +1,572 @@
+// Headless rendering benchmark (the `rallyplot_bench` target). For each
+// plot type and dataset size a headless Plotter replays a scripted sequence
+// of camera operations, rendering one offscreen frame per operation:
+//
+//   static     full view redrawn (no camera change)
+//   wheelZoom  mouse wheel zoom in at the plot center
+//   panX       left mouse drag panning
+//   zoomX      zoom out about the view center (Camera::zoomX)
+//   pinnedPan  panning with the y-axis pinned to the data in view
+//
+// Reports the cold and warm time to first frame (and the warm startup breakdown,
+// see Plotter::startupStats()), the frame time distribution of each
+// phase (wall time of renderToImage(), so including the framebuffer
+// readback) and the per-stage frame profiler percentiles of each case as JSON.
+// The process peak RSS is reported once for the run, as it only ever grows (a
+// case after the heaviest one would report the heaviest's). Run each case in its
+// own process (--plots / --sizes) to measure their memory separately. Compare
+// two result files with compare_render_bench.py.
+//
+// By default rendering uses Mesa's llvmpipe software rasteriser (set
+// through LIBGL_ALWAYS_SOFTWARE / GALLIUM_DRIVER unless already set), so
+// results are comparable across machines without a GPU.
+//
+// The cold time to first frame is measured with an empty program binary
+// cache (all shaders compiled from source), the warm one with the binaries
+// stored by the cold run. The driver's own shader cache (e.g. Mesa's) may
+// still make cold starts faster than a first ever run.
+//
+// With --ttff-budget-ms the exit code is 3 if the warm time to first frame of any
+// case is over the budget, so startup regressions can fail a CI job.
+//
+// Usage: rallyplot_bench [--out results.json] [--plots candlestick,line,bar,scatter]
+//                        [--sizes 1e5,1e6,1e7,1e8] [--frames 60] [--width 1280]
+//                        [--height 720] [--hardware] [--program-cache-dir DIR]
+//                        [--ttff-budget-ms MS]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Plotter.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+struct Options
+{
+    std::string outPath = "rallyplot_bench.json";
+    std::vector<std::string> plots = {"candlestick", "line", "bar", "scatter"};
+    std::vector<std::size_t> sizes = {100'000, 1'000'000, 10'000'000, 100'000'000};
+    int framesPerPhase = 60;
+    int width = 1280;
+    int height = 720;
+    bool hardware = false;
+    std::string programCacheDir = (std::filesystem::temp_directory_path() / "rallyplot_bench_program_cache").string();
+    std::optional<double> ttffBudgetMs;
+};
+
+
+struct PhaseResult
+{
+    std::string name;
+    std::vector<double> frameMs;
+};
+
+
+struct CaseResult
+{
+    std::string plot;
+    std::size_t numPoints;
+    double timeToFirstFrameColdMs;
+    double timeToFirstFrameMs;
+    StartupStats startup;
+    std::vector<PhaseResult> phases;
+    std::vector<ProfilerStageStats> stages;
+};
+
+
+using Clock = std::chrono::steady_clock;
+
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+
+double peakRssMb()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0);  // bytes on macOS
+#else
+    return usage.ru_maxrss / 1024.0;  // kilobytes on Linux
+#endif
+#endif
+}
+
+
+double percentile(std::vector<double> values, double p)
+{
+    std::sort(values.begin(), values.end());
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * values.size()));
+    return values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+}
+
+
+/* ----------------------------------------------------------------------------------------
+    Datasets
+ ---------------------------------------------------------------------------------------- */
+
+struct Dataset
+{
+    std::vector<float> open;
+    std::vector<float> high;
+    std::vector<float> low;
+    std::vector<float> close;
+};
+
+
+Dataset makeDataset(const std::string& plot, std::size_t numPoints)
+/*
+    A seeded random walk, so every run draws the same data. Only the
+    close is generated for the one-value plots.
+ */
+{
+    Dataset data;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> step(0.0f, 1.0f);
+    std::uniform_real_distribution<float> wick(0.0f, 0.5f);
+
+    bool isCandlestick = (plot == "candlestick");
+
+    data.close.resize(numPoints);
+    if (isCandlestick)
+    {
+        data.open.resize(numPoints);
+        data.high.resize(numPoints);
+        data.low.resize(numPoints);
+    }
+
+    float price = 1000.0f;
+
+    for (std::size_t i = 0; i < numPoints; i++)
+    {
+        float open = price;
+        price = std::max(price + step(rng), 1.0f);
+        data.close[i] = price;
+
+        if (isCandlestick)
+        {
+            data.open[i] = open;
+            data.high[i] = std::max(open, price) + wick(rng);
+            data.low[i] = std::min(open, price) - wick(rng);
+        }
+    }
+
+    return data;
+}
+
+
+void addPlot(Plotter& plotter, const std::string& plot, const Dataset& data)
+{
+    std::size_t n = data.close.size();
+
+    if (plot == "candlestick")
+    {
+        plotter.candlestick(data.open.data(), n, data.high.data(), n, data.low.data(), n, data.close.data(), n);
+    }
+    else if (plot == "line")
+    {
+        plotter.line(data.close.data(), n);
+    }
+    else if (plot == "bar")
+    {
+        plotter.bar(data.close.data(), n);
+    }
+    else if (plot == "scatter")
+    {
+        std::vector<int> x(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            x[i] = static_cast<int>(i);
+        }
+        plotter.scatter(x, data.close);
+    }
+    else
+    {
+        throw std::invalid_argument("Plot type " + plot + " not recognised, use candlestick, line, bar or scatter.");
+    }
+}
+
+
+void clearProgramCache(const std::string& directory)
+// Only the program binaries are removed, in case the directory is shared.
+{
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".bin")
+        {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+}
+
+
+/* ----------------------------------------------------------------------------------------
+    Replay
+ ---------------------------------------------------------------------------------------- */
+
+CaseResult runCase(const std::string& plot, std::size_t numPoints, const Options& options)
+{
+    CaseResult result{plot, numPoints, 0.0, 0.0, {}, {}, {}};
+
+    Dataset data = makeDataset(plot, numPoints);
+
+    PlotterArgs args;
+    args.width = options.width;
+    args.height = options.height;
+    args.headless = true;
+    args.programBinaryCacheDir = options.programCacheDir;
+
+    // Time to first frame: from creating the figure to the first rendered image.
+    // Cold, all shaders are compiled from source (and their binaries stored).
+    clearProgramCache(options.programCacheDir);
+    {
+        Clock::time_point start = Clock::now();
+
+        Plotter coldPlotter(args);
+        addPlot(coldPlotter, plot, data);
+        coldPlotter.renderToImage(options.width, options.height);
+
+        result.timeToFirstFrameColdMs = elapsedMs(start);
+    }
+
+    // Warm, programs are loaded from the binaries
+    Clock::time_point start = Clock::now();
+
+    Plotter plotter(args);
+    addPlot(plotter, plot, data);
+    plotter.renderToImage(options.width, options.height);
+
+    result.timeToFirstFrameMs = elapsedMs(start);
+    result.startup = plotter.startupStats();
+
+    plotter.enableProfiler();
+
+    auto runPhase = [&](const std::string& name, auto&& moveCamera)
+    {
+        PhaseResult phase{name, {}};
+        phase.frameMs.reserve(options.framesPerPhase);
+
+        for (int i = 0; i < options.framesPerPhase; i++)
+        {
+            Clock::time_point frameStart = Clock::now();
+
+            moveCamera(i);
+            plotter.renderToImage(options.width, options.height);
+
+            phase.frameMs.push_back(elapsedMs(frameStart));
+        }
+        result.phases.push_back(std::move(phase));
+    };
+
+    runPhase("static", [&](int) {});
+    runPhase("wheelZoom", [&](int) { plotter._moveCamera(CameraOperation::wheelZoom, 120.0); });
+    runPhase("panX", [&](int i) { plotter._moveCamera(CameraOperation::panX, (i % 20 < 10) ? 40.0 : -40.0); });
+    runPhase("zoomX", [&](int) { plotter._moveCamera(CameraOperation::zoomX, 0.9); });
+
+    plotter.pinYAxis(true);
+    runPhase("pinnedPan", [&](int i) { plotter._moveCamera(CameraOperation::panX, (i % 20 < 10) ? 40.0 : -40.0); });
+
+    result.stages = plotter.profilerStats();
+
+    return result;
+}
+
+
+/* ----------------------------------------------------------------------------------------
+    Output
+ ---------------------------------------------------------------------------------------- */
+
+std::string jsonNumber(double value)
+// NaN (e.g. a startup time not reached) is not valid JSON
+{
+    if (std::isnan(value))
+    {
+        return "null";
+    }
+    std::ostringstream number;
+    number.precision(4);
+    number << std::fixed << value;
+    return number.str();
+}
+
+
+std::string toJson(const std::vector<CaseResult>& results, const Options& options, double runPeakRssMb)
+{
+    std::ostringstream json;
+    json.precision(4);
+    json << std::fixed;
+
+    json << "{\n"
+         << "  \"schema\": 1,\n"
+         << "  \"renderer\": \"" << (options.hardware ? "hardware" : "llvmpipe") << "\",\n"
+         << "  \"width\": " << options.width << ",\n"
+         << "  \"height\": " << options.height << ",\n"
+         << "  \"framesPerPhase\": " << options.framesPerPhase << ",\n"
+         << "  \"peakRssMb\": " << runPeakRssMb << ",\n"
+         << "  \"cases\": [";
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const CaseResult& result = results[i];
+
+        json << (i == 0 ? "\n" : ",\n")
+             << "    {\n"
+             << "      \"name\": \"" << result.plot << "_" << result.numPoints << "\",\n"
+             << "      \"plot\": \"" << result.plot << "\",\n"
+             << "      \"numPoints\": " << result.numPoints << ",\n"
+             << "      \"timeToFirstFrameColdMs\": " << result.timeToFirstFrameColdMs << ",\n"
+             << "      \"timeToFirstFrameMs\": " << result.timeToFirstFrameMs << ",\n"
+             << "      \"startup\": {"
+             << "\"applicationMs\": " << jsonNumber(result.startup.applicationMs)
+             << ", \"windowSetupMs\": " << jsonNumber(result.startup.windowSetupMs)
+             << ", \"firstFrameMs\": " << jsonNumber(result.startup.firstFrameMs)
+             << ", \"firstFrameDrawMs\": " << jsonNumber(result.startup.firstFrameDrawMs)
+             << ", \"deferredWorkMs\": " << jsonNumber(result.startup.deferredWorkMs)
+             << ", \"deferredWorkDoneMs\": " << jsonNumber(result.startup.deferredWorkDoneMs) << "},\n"
+             << "      \"phases\": {";
+
+        for (std::size_t j = 0; j < result.phases.size(); j++)
+        {
+            const std::vector<double>& frameMs = result.phases[j].frameMs;
+            double mean = 0.0;
+            for (double ms : frameMs)
+            {
+                mean += ms / frameMs.size();
+            }
+
+            json << (j == 0 ? "\n" : ",\n")
+                 << "        \"" << result.phases[j].name << "\": {"
+                 << "\"frames\": " << frameMs.size()
+                 << ", \"meanMs\": " << mean
+                 << ", \"p50Ms\": " << percentile(frameMs, 50.0)
+                 << ", \"p95Ms\": " << percentile(frameMs, 95.0)
+                 << ", \"p99Ms\": " << percentile(frameMs, 99.0)
+                 << ", \"maxMs\": " << *std::max_element(frameMs.begin(), frameMs.end()) << "}";
+        }
+
+        json << "\n      },\n"
+             << "      \"stages\": {";
+
+        for (std::size_t j = 0; j < result.stages.size(); j++)
+        {
+            const ProfilerStageStats& stage = result.stages[j];
+
+            json << (j == 0 ? "\n" : ",\n")
+                 << "        \"" << stage.stage << "\": {"
+                 << "\"frames\": " << stage.numFrames
+                 << ", \"cpuP50Ms\": " << stage.cpuP50Ms
+                 << ", \"cpuP95Ms\": " << stage.cpuP95Ms
+                 << ", \"cpuP99Ms\": " << stage.cpuP99Ms
+                 << ", \"gpuP50Ms\": " << stage.gpuP50Ms
+                 << ", \"gpuP95Ms\": " << stage.gpuP95Ms
+                 << ", \"gpuP99Ms\": " << stage.gpuP99Ms << "}";
+        }
+
+        json << "\n      }\n"
+             << "    }";
+    }
+
+    json << "\n  ]\n}\n";
+
+    return json.str();
+}
+
+
+/* ----------------------------------------------------------------------------------------
+    Main
+ ---------------------------------------------------------------------------------------- */
+
+std::vector<std::string> splitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        auto value = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument(arg + " requires a value.");
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--out")
+        {
+            options.outPath = value();
+        }
+        else if (arg == "--plots")
+        {
+            options.plots = splitList(value());
+        }
+        else if (arg == "--sizes")
+        {
+            options.sizes.clear();
+            for (const std::string& size : splitList(value()))
+            {
+                options.sizes.push_back(static_cast<std::size_t>(std::stod(size)));  // allows e.g. 1e6
+            }
+        }
+        else if (arg == "--frames")
+        {
+            options.framesPerPhase = std::stoi(value());
+        }
+        else if (arg == "--width")
+        {
+            options.width = std::stoi(value());
+        }
+        else if (arg == "--height")
+        {
+            options.height = std::stoi(value());
+        }
+        else if (arg == "--program-cache-dir")
+        {
+            options.programCacheDir = value();
+        }
+        else if (arg == "--ttff-budget-ms")
+        {
+            options.ttffBudgetMs = std::stod(value());
+        }
+        else if (arg == "--hardware")
+        {
+            options.hardware = true;
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown argument " + arg + ".");
+        }
+    }
+
+    if (options.framesPerPhase < 1)
+    {
+        throw std::invalid_argument("--frames must be at least 1.");
+    }
+
+    return options;
+}
+
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+#if !defined(_WIN32)
+    if (!options.hardware)
+    {
+        setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+        setenv("GALLIUM_DRIVER", "llvmpipe", 0);
+    }
+#endif
+
+    std::vector<CaseResult> results;
+
+    for (const std::string& plot : options.plots)
+    {
+        for (std::size_t numPoints : options.sizes)
+        {
+            CaseResult result = runCase(plot, numPoints, options);
+
+            std::printf(
+                "%-12s %11zu points  first frame cold %9.1f ms warm %9.1f ms  static p50 %7.2f ms  pinnedPan p95 %7.2f ms\n",
+                plot.c_str(), numPoints, result.timeToFirstFrameColdMs, result.timeToFirstFrameMs,
+                percentile(result.phases.front().frameMs, 50.0),
+                percentile(result.phases.back().frameMs, 95.0)
+            );
+            std::fflush(stdout);
+
+            results.push_back(std::move(result));
+        }
+    }
+
+    std::ofstream file(options.outPath);
+    if (!file)
+    {
+        std::cerr << "Could not open " << options.outPath << " for writing.\n";
+        return 1;
+    }
+    double runPeakRssMb = peakRssMb();
+    std::printf("Peak RSS of the run %.1f MB\n", runPeakRssMb);
+
+    file << toJson(results, options, runPeakRssMb);
+
+    std::printf("Results written to %s\n", options.outPath.c_str());
+
+    if (options.ttffBudgetMs.has_value())
+    {
+        bool overBudget = false;
+
+        for (const CaseResult& result : results)
+        {
+            if (result.timeToFirstFrameMs > options.ttffBudgetMs.value())
+            {
+                std::printf(
+                    "%s_%zu: warm time to first frame %.1f ms is over the budget of %.1f ms\n",
+                    result.plot.c_str(), result.numPoints, result.timeToFirstFrameMs, options.ttffBudgetMs.value()
+                );
+                overBudget = true;
+            }
+        }
+        if (overBudget)
+        {
+            return 3;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Benchmark for streaming candles from producer threads (CandleStream /
+// UpdateQueue). Producers push ticks (an overwrite of the last candle, with
+// an append every `ticksPerCandle` ticks) as fast as they can while the
+// consumer drains the queue once per 16 ms frame, as paintGL does. Reports
+// the sustained tick rate, the drain time per frame and the dropped ticks
+// for each backpressure policy.
+//
+// Usage: benchUpdateQueue [numProducers] [seconds]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../../../src/cpp/structure/UpdateQueue.h"
+
+
+void runPolicy(const char* name, BackpressurePolicy policy, int numProducers, double seconds)
+{
+    constexpr int ticksPerCandle = 100;
+
+    auto queue = std::make_shared<UpdateQueue>(UpdateQueue::defaultCapacity);
+
+    std::vector<std::shared_ptr<CandleStream>> streams;
+    for (int i = 0; i < numProducers; i++)
+    {
+        streams.push_back(std::make_shared<CandleStream>(queue, i, false, CandleStreamSettings{policy}));
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> numPushed{0};
+    std::vector<std::thread> producers;
+
+    for (int i = 0; i < numProducers; i++)
+    {
+        producers.emplace_back([&, i]
+        {
+            std::size_t tick = 0;
+            float price = 100.0f;
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                price += (tick % 7 == 0) ? 0.01f : -0.001f;
+
+                if (tick % ticksPerCandle == 0)
+                {
+                    streams[i]->appendCandle(price, price, price, price);
+                }
+                else
+                {
+                    streams[i]->updateLastCandle(price - 0.5f, price + 1.0f, price - 1.0f, price);
+                }
+                tick++;
+            }
+            numPushed.fetch_add(tick);
+        });
+    }
+
+    std::map<int, CoalescedCandleUpdates> updatesBySeries;
+    std::size_t numDrained = 0;
+    std::size_t numCandles = 0;
+    double maxDrainUs = 0.0;
+    double totalDrainUs = 0.0;
+    int numFrames = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto frameEnd = start;
+
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < seconds)
+    {
+        frameEnd += std::chrono::milliseconds(16);
+        std::this_thread::sleep_until(frameEnd);
+
+        auto drainStart = std::chrono::steady_clock::now();
+
+        numDrained += queue->drain(updatesBySeries);
+
+        for (auto& [seriesId, updates] : updatesBySeries)
+        {
+            numCandles += updates.open.size();
+            updates.clear();
+        }
+
+        double drainUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - drainStart).count();
+        maxDrainUs = std::max(maxDrainUs, drainUs);
+        totalDrainUs += drainUs;
+        numFrames++;
+    }
+
+    stop.store(true);
+    queue->close();  // release blocked producers
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t numDropped = 0;
+    for (const std::shared_ptr<CandleStream>& stream : streams)
+    {
+        numDropped += stream->numDropped();
+    }
+
+    std::printf(
+        "%-6s %12.0f ticks/s  %10zu drained  %8zu candles  %10zu dropped  drain mean %8.1f us  max %8.1f us\n",
+        name, numPushed.load() / elapsed, numDrained, numCandles, numDropped,
+        totalDrainUs / std::max(numFrames, 1), maxDrainUs
+    );
+}
+
+
+int main(int argc, char* argv[])
+{
+    int numProducers = argc > 1 ? std::atoi(argv[1]) : 4;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+
+    std::printf("%d producers, %.1f s per policy\n", numProducers, seconds);
+
+    runPolicy("drop", BackpressurePolicy::drop, numProducers, seconds);
+    runPolicy("merge", BackpressurePolicy::merge, numProducers, seconds);
+    runPolicy("block", BackpressurePolicy::block, numProducers, seconds);
+
+    return 0;
+}
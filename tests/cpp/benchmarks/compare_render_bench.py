@@ -0,0 +1,146 @@
+"""
+Compare two `rallyplot_bench` result files, e.g. a stored baseline and the current build.
+
+A case regresses if its (cold or warm) time to first frame or a phase p50 / p95 frame time is
+slower than the baseline by more than the tolerance. Small absolute differences (below
+`--min-diff-ms`) are ignored as noise. The peak RSS is of the whole run, so it is only
+compared if both files ran the same cases.
+
+`benchCpuHotPaths --json` results are also accepted, each benchmark (name and size)
+regresses if its time per operation is slower by more than the tolerance and `--min-diff-ns`.
+Several runs of the same build can be passed comma separated, each benchmark is then
+compared on its fastest run.
+
+Usage:
+    python compare_render_bench.py baseline.json results.json [--tolerance 0.15] [--min-diff-ms 0.5]
+    python compare_render_bench.py base_1.json,base_2.json,base_3.json pr_1.json,pr_2.json,pr_3.json
+
+Exits with status 1 if any case regressed.
+"""
+import argparse
+import json
+import sys
+
+
+def load_cases(path):
+    with open(path) as f:
+        results = json.load(f)
+
+    if "benchmarks" in results:
+        return results, {f"{bench['name']} [{bench['size']}]": bench for bench in results["benchmarks"]}
+
+    return results, {case["name"]: case for case in results["cases"]}
+
+
+def load_runs(paths):
+    """
+    Load a result file, or several comma separated runs of the same build. Noise on a
+    shared machine only slows a run down, so each benchmark keeps its fastest run.
+    """
+    paths = paths.split(",")
+    results, cases = load_cases(paths[0])
+
+    for path in paths[1:]:
+        run_results, run_cases = load_cases(path)
+
+        if "benchmarks" not in results or "benchmarks" not in run_results:
+            sys.exit("Several runs can only be compared for `benchCpuHotPaths` results.")
+
+        for name, bench in run_cases.items():
+            if name not in cases or bench["nsPerOp"] < cases[name]["nsPerOp"]:
+                cases[name] = bench
+
+    return results, cases
+
+
+def compare(baseline_value, value, tolerance, min_diff):
+    """Return the relative change and whether it is a regression."""
+    change = (value - baseline_value) / baseline_value if baseline_value > 0 else 0.0
+    regressed = change > tolerance and (value - baseline_value) > min_diff
+    return change, regressed
+
+
+def case_metrics(base, case, min_diff_ms):
+    """(metric, baseline value, value, minimum difference) of a rendering case."""
+    metrics = [("timeToFirstFrameMs", base["timeToFirstFrameMs"], case["timeToFirstFrameMs"], min_diff_ms)]
+
+    # Older result files have no cold start
+    if "timeToFirstFrameColdMs" in base and "timeToFirstFrameColdMs" in case:
+        metrics.insert(0, ("timeToFirstFrameColdMs", base["timeToFirstFrameColdMs"], case["timeToFirstFrameColdMs"], min_diff_ms))
+
+    # Older result files have no startup breakdown
+    if "startup" in base and "startup" in case:
+        for stat in ["windowSetupMs", "firstFrameDrawMs"]:
+            if base["startup"][stat] is not None and case["startup"][stat] is not None:
+                metrics.append((f"startup.{stat}", base["startup"][stat], case["startup"][stat], min_diff_ms))
+
+    for phase, stats in case["phases"].items():
+        if phase in base["phases"]:
+            for stat in ["p50Ms", "p95Ms"]:
+                metrics.append((f"{phase}.{stat}", base["phases"][phase][stat], stats[stat], min_diff_ms))
+
+    return metrics
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("results")
+    parser.add_argument("--tolerance", type=float, default=0.15, help="Allowed relative slowdown (default 0.15).")
+    parser.add_argument("--min-diff-ms", type=float, default=0.5, help="Ignore differences smaller than this (default 0.5 ms).")
+    parser.add_argument("--min-diff-ns", type=float, default=20.0, help="Ignore per-operation differences smaller than this (default 20 ns).")
+    args = parser.parse_args()
+
+    baseline, baseline_cases = load_runs(args.baseline)
+    results, cases = load_runs(args.results)
+
+    for key in ["renderer", "width", "height"]:
+        if baseline.get(key) != results.get(key):
+            print(f"WARNING: `{key}` differs ({baseline.get(key)} vs. {results.get(key)}), results may not be comparable.")
+
+    regressions = []
+
+    for name, case in cases.items():
+        if name not in baseline_cases:
+            print(f"{name}: not in the baseline, skipped.")
+            continue
+
+        base = baseline_cases[name]
+
+        if "nsPerOp" in case:
+            metrics = [("nsPerOp", base["nsPerOp"], case["nsPerOp"], args.min_diff_ns)]
+        else:
+            metrics = case_metrics(base, case, args.min_diff_ms)
+
+        for metric, baseline_value, value, min_diff in metrics:
+            change, regressed = compare(baseline_value, value, args.tolerance, min_diff)
+            flag = "REGRESSION" if regressed else ""
+            print(f"{name:<40} {metric:<24} {baseline_value:12.3f} -> {value:12.3f} ({change:+7.1%}) {flag}")
+
+            if regressed:
+                regressions.append(f"{name} {metric}")
+
+    for name in baseline_cases.keys() - cases.keys():
+        print(f"{name}: in the baseline but not in the results.")
+
+    # Older result files report the peak RSS per case
+    if "peakRssMb" in baseline and "peakRssMb" in results:
+        if baseline_cases.keys() == cases.keys():
+            change, regressed = compare(baseline["peakRssMb"], results["peakRssMb"], args.tolerance, 1.0)
+            flag = "REGRESSION" if regressed else ""
+            print(f"{'run':<40} {'peakRssMb':<24} {baseline['peakRssMb']:12.3f} -> {results['peakRssMb']:12.3f} ({change:+7.1%}) {flag}")
+
+            if regressed:
+                regressions.append("run peakRssMb")
+        else:
+            print("peakRssMb: the runs have different cases, not compared.")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s):\n  " + "\n  ".join(regressions))
+        sys.exit(1)
+
+    print("\nNo regressions.")
+
+
+if __name__ == "__main__":
+    main()
@@ -24,7 +24,6 @@
 // - texture are created for every single subplot!! not necesarry...
 // - an option to switch between keys moving all suplots vs. a specific subplot
 // - Fast mouse protection: fast mouse move protection is not good...  it would be nice to remove it and find a better way to handle the issue with axis, while loop etc!
-// - axis ticks slow to update for ~10m
 // - scaler the miter limit by zoom
 // - zoom out, at edges it goes weirdly lagging...
 // - different subplot y-axis labels for linked subplots
@@ -36,9 +35,8 @@
 // - plot names! (1) add plot name argument, 2) interacive with legend (add legend name to plot) 3) use name for hover
 // - extend draw mode
 // - currently not possible to set line color from python, read directly from plot...
-// - Precision issues: Maximum precision is around 11 million (add to docs!). Different dragging behaviour between axis vs. plot. Note that scatter and line go out of alignment
-//   (reduce range to -0.5, 0.5 or whatever. m_firstXTick will be key for redoing these calculations. Check what is happening at the shader level!
-//   ALONG WITH FLOAT, CHECK ALL METHODS OF COMPUTING POSITION FOR PLOT OVERLAYS (E.G. CROSSHAIR, HOVER) USE THE SAME METHOD AND MATCH EXACTLY!
+// - Precision: x positions are relative to the first drawn index with the offset computed in double (see CandlestickPlot::draw()),
+//   tested to 100 million+ datapoints. Different dragging behaviour between axis vs. plot.
 // - const is used so intermiddetly
 // scale line padding for hover mouse my pproportion! i.e. when u hover your mouse over a line and it shows the popup, this width is not scaled by proprortion
 
@@ -0,0 +1,33 @@
+"""
+Fixtures shared by the tests. The tests are run as scripts, so their
+directory is on the path and this is imported as `helpers`.
+"""
+from rallyplot import Plotter, get_toy_candlestick_data
+import numpy as np
+
+
+def toy_ohlc(num_candles, seed=42):
+    """
+    The open, high, low and close of the toy candlestick data, as float32 arrays.
+    """
+    data_df, _, _ = get_toy_candlestick_data(num_candles, seed=seed)
+
+    return tuple(data_df[column].to_numpy(dtype=np.float32) for column in ["open", "high", "low", "close"])
+
+
+def render_headless(plot, width=640, height=480, **plotter_kwargs):
+    """
+    Render a headless plotter after `plot(plotter)` has added its plots, and finish it.
+    """
+    plotter = Plotter(headless=True, **plotter_kwargs)
+    plot(plotter)
+
+    image = plotter.render_to_image(width, height)
+    plotter.finish()
+
+    return image
+
+
+def assert_images_equal(image, expected, message="The images differ."):
+    assert image.shape == expected.shape, f"{message} Shapes {image.shape} and {expected.shape}."
+    assert np.array_equal(image, expected), f"{message} {np.count_nonzero(image != expected)} values differ."
@@ -0,0 +1,49 @@
+from rallyplot import CandleFile, write_candle_file, get_toy_candlestick_data
+from helpers import render_headless, assert_images_equal
+import numpy as np
+import pandas as pd
+import tempfile
+from pathlib import Path
+
+def test_candle_file():
+    """
+    Check a written candle file reads back without a copy (including dates
+    and the per-block min / max zone maps), and plots the same as the data.
+    """
+    data_df, volume, _ = get_toy_candlestick_data(10_000, seed=42)
+    dates = pd.Series(pd.date_range("2024-01-02 09:30", periods=len(data_df), freq="min", tz="UTC"))
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        filepath = Path(tmp_dir) / "candles.rcf"
+
+        write_candle_file(filepath, data_df, volume=volume, dates=dates)
+
+        candle_file = CandleFile(filepath)
+
+        assert len(candle_file) == len(data_df)
+        assert candle_file.has_column("volume")
+
+        for column in ["open", "high", "low", "close"]:
+            values = candle_file.column(column)
+            assert not values.flags.writeable
+            assert np.array_equal(values, data_df[column].to_numpy(dtype=np.float32))
+
+            num_blocks = -(-len(values) // candle_file.block_size)
+            padded = np.full(num_blocks * candle_file.block_size, np.nan, dtype=np.float32)
+            padded[:len(values)] = values
+            assert np.array_equal(candle_file.block_min(column), np.nanmin(padded.reshape(num_blocks, -1), axis=1))
+            assert np.array_equal(candle_file.block_max(column), np.nanmax(padded.reshape(num_blocks, -1), axis=1))
+
+        assert (candle_file.dates == dates).all()
+
+        # The file plots the same as the arrays
+        from_file = render_headless(lambda plotter: plotter.candlestick_from_file(candle_file))
+        from_df = render_headless(lambda plotter: plotter.candlestick_from_df(data_df, dates=dates))
+
+        assert_images_equal(from_file, from_df)
+
+        del candle_file
+
+    print("Successfully run `test_candle_file`.")
+
+test_candle_file()
@@ -0,0 +1,47 @@
+from rallyplot import Plotter
+from helpers import assert_images_equal
+import numpy as np
+
+def test_chunked_upload():
+    """
+    Check candles uploaded a chunk at a time, as they come into view, render
+    the same as candles streamed into a plot already drawn (written only into
+    the chunks already uploaded), for the candles and the line mode, zoomed
+    out (LOD levels) and in. The zoomed view straddles the first chunk
+    boundary (2^20 candles).
+    """
+    rng = np.random.default_rng(42)
+    num_candles = 1_500_000
+
+    close = (100 + np.cumsum(rng.normal(0, 0.1, num_candles))).astype(np.float32)
+    open = np.roll(close, 1)
+    open[0] = close[0]
+    high = np.maximum(open, close) + 0.05
+    low = np.minimum(open, close) - 0.05
+
+    for mode in ["no_caps", "line_close"]:
+        images = []
+        for streamed in [False, True]:
+            plotter = Plotter(headless=True)
+
+            if streamed:
+                plotter.candlestick(open[:1000], high[:1000], low[:1000], close[:1000], mode=mode)
+                plotter.render_to_image(640, 480)
+                plotter.append_candles(open[1000:], high[1000:], low[1000:], close[1000:])
+            else:
+                plotter.candlestick(open, high, low, close, mode=mode)
+
+            plotter.set_x_limits(None, None)
+            full_view = plotter.render_to_image(640, 480)
+
+            plotter.set_x_limits(2**20 - 150, 2**20 + 150)
+            images.append((full_view, plotter.render_to_image(640, 480)))
+
+            plotter.finish()
+
+        assert_images_equal(images[0][0], images[1][0], f"mode {mode} differs zoomed out.")
+        assert_images_equal(images[0][1], images[1][1], f"mode {mode} differs zoomed in.")
+
+    print("Successfully run `test_chunked_upload`.")
+
+test_chunked_upload()
@@ -0,0 +1,42 @@
+from rallyplot import Plotter
+import numpy as np
+
+def render_grid(labels):
+    """
+    Render a 2x2 grid with a linked subplot and a legend in each subplot. All axis
+    tick labels and legends share the glyph atlases of their font and size.
+    """
+    plotter = Plotter(headless=True)
+
+    rng = np.random.default_rng(42)
+
+    for idx, (row, col) in enumerate([(0, 0), (0, 1), (1, 0), (1, 1)]):
+        if idx > 0:
+            plotter.add_subplot(row, col, 1, 1)
+
+        plotter.line(np.cumsum(rng.normal(size=1_000)))
+        plotter.set_legend([labels[0]], linked_subplot_idx=0)
+
+        plotter.add_linked_subplot(0.25)
+        plotter.line(np.cumsum(rng.normal(size=1_000)), linked_subplot_idx=1)
+        plotter.set_legend([labels[1]], linked_subplot_idx=1, font_size=20)
+
+    image = plotter.render_to_image(800, 600)
+    plotter.finish()
+
+    return image
+
+def test_glyph_atlas():
+    """
+    Check non-ASCII legend labels (added to the atlas on first use)
+    are drawn, and that rendering is deterministic with shared atlases.
+    """
+    currency = render_grid(["Price €", "Volume £¥"])
+    ascii = render_grid(["Price E", "Volume LY"])
+
+    assert not np.array_equal(currency, ascii), "Non-ASCII glyphs were not drawn."
+    assert np.array_equal(currency, render_grid(["Price €", "Volume £¥"]))
+
+    print("Successfully run `test_glyph_atlas`.")
+
+test_glyph_atlas()
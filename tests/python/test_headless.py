@@ -0,0 +1,30 @@
+from rallyplot import Plotter
+import numpy as np
+import tempfile
+from pathlib import Path
+
+def test_headless_render():
+    """
+    Check a headless plotter renders the figure to an image and
+    .png file without a display, at the requested size.
+    """
+    plotter = Plotter(headless=True)
+
+    plotter.line(np.cumsum(np.random.normal(size=10_000)))
+
+    image = plotter.render_to_image(640, 480)
+
+    assert image.shape == (480, 640, 4)
+    assert image.dtype == np.uint8
+    assert np.unique(image.reshape(-1, 4), axis=0).shape[0] > 1, "Image has a single color."
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        filepath = Path(tmp_dir) / "figure.png"
+        plotter.save_png(filepath, 320, 240, dpi=150)
+
+        with open(filepath, "rb") as f:
+            assert f.read(8) == b"\x89PNG\r\n\x1a\n"
+
+    print("Successfully run `test_headless_render`.")
+
+test_headless_render()
@@ -0,0 +1,62 @@
+from rallyplot import Plotter
+from helpers import toy_ohlc, assert_images_equal
+import json
+import tempfile
+from pathlib import Path
+
+def test_profiler():
+    """
+    Check the frame profiler records the drawn stages, and that rendering
+    with the profiler enabled is the same as without it.
+    """
+    open, high, low, close = toy_ohlc(2_000)
+
+    plotter = Plotter(headless=True)
+    plotter.candlestick(open, high, low, close)
+    plotter.line(close, linked_subplot_idx=0)
+
+    expected = plotter.render_to_image(640, 480)
+
+    assert plotter.profiler_stats().empty
+
+    plotter.enable_profiler()
+
+    # GPU timings are read a few frames after they are drawn
+    for _ in range(20):
+        image = plotter.render_to_image(640, 480)
+
+    assert_images_equal(image, expected)
+
+    stats = plotter.profiler_stats().set_index("stage")
+
+    for stage in ["frame", "plotLayer", "axes", "ticks", "tickLabels", "candlestickPlot", "linePlot"]:
+        assert stage in stats.index, f"stage {stage} was not recorded."
+
+    assert "barPlot" not in stats.index
+
+    assert stats.loc["frame", "num_frames"] > 0
+    assert (stats["cpu_p50_ms"] <= stats["cpu_p95_ms"]).all()
+    assert (stats["cpu_p95_ms"] <= stats["cpu_p99_ms"]).all()
+    assert (stats["gpu_p50_ms"] >= 0).all()
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        trace_path = Path(tmp_dir) / "trace.json"
+        plotter.save_profiler_trace(trace_path)
+
+        with open(trace_path) as f:
+            trace = json.load(f)
+
+    events = [event for event in trace["traceEvents"] if event["ph"] == "X"]
+    assert {event["tid"] for event in events} == {1, 2}
+    assert sum(event["name"] == "frame" and event["tid"] == 1 for event in events) == stats.loc["frame", "num_frames"]
+
+    # Re-enabling clears the recorded frames
+    plotter.enable_profiler(False)
+    plotter.enable_profiler()
+    assert plotter.profiler_stats().empty
+
+    plotter.finish()
+
+    print("Successfully run `test_profiler`.")
+
+test_profiler()
@@ -0,0 +1,44 @@
+from helpers import toy_ohlc, render_headless, assert_images_equal
+import tempfile
+from pathlib import Path
+
+def render(cache_dir, program_binary_cache=True):
+    open, high, low, close = toy_ohlc(1_000)
+
+    def plot(plotter):
+        plotter.candlestick(open, high, low, close)
+        plotter.line(close, linked_subplot_idx=0)
+        plotter.bar(open)
+        plotter.set_legend(["candles", "close", "open"])
+
+    return render_headless(plot, program_binary_cache=program_binary_cache, program_binary_cache_dir=cache_dir)
+
+def test_program_binary_cache():
+    """
+    Check rendering is the same with programs compiled from source, stored
+    to and loaded from the binary cache, and with a corrupt cache.
+    """
+    with tempfile.TemporaryDirectory() as cache_dir:
+        expected = render(cache_dir, program_binary_cache=False)
+        assert not list(Path(cache_dir).glob("*.bin"))
+
+        cold = render(cache_dir)
+        binaries = list(Path(cache_dir).glob("*.bin"))
+
+        if not binaries:
+            print("The driver does not support program binaries, only the fallback is tested.")
+
+        warm = render(cache_dir)
+
+        for binary in binaries:
+            binary.write_bytes(b"RPPB" + b"\x00" * 64)
+
+        corrupt = render(cache_dir)
+
+        assert_images_equal(cold, expected, "Storing the binaries changed the rendering.")
+        assert_images_equal(warm, expected, "Loading the binaries changed the rendering.")
+        assert_images_equal(corrupt, expected, "A corrupt cache changed the rendering.")
+
+    print("Successfully run `test_program_binary_cache`.")
+
+test_program_binary_cache()
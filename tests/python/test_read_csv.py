@@ -0,0 +1,48 @@
+from rallyplot import read_csv
+import numpy as np
+import pandas as pd
+import tempfile
+from pathlib import Path
+
+def test_read_csv():
+    """
+    Check the parallel .csv reader matches pandas, with ISO-8601 dates
+    (returned as UTC datetimes) and with other date strings (returned as is).
+    """
+    N = 50_000
+    rng = np.random.default_rng(42)
+    close = 1000 + np.cumsum(rng.normal(size=N))
+
+    expected = pd.DataFrame({
+        "Date": pd.date_range("2024-01-02 09:30", periods=N, freq="min", tz="UTC"),
+        "Open": close + rng.normal(size=N),
+        "High": close + 2,
+        "Low": close - 2,
+        "Close": close,
+        "Volume": rng.integers(0, 1000, size=N),
+    })
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        filepath = Path(tmp_dir) / "data.csv"
+
+        expected.to_csv(filepath, index=False, date_format="%Y-%m-%dT%H:%M:%SZ")
+
+        for num_threads in [1, 4]:
+            data_df, dates = read_csv(filepath, num_threads=num_threads)
+
+            assert all(data_df.columns == ["open", "high", "low", "close"])
+            for column in ["Open", "High", "Low", "Close"]:
+                assert np.allclose(data_df[column.lower()], expected[column], rtol=1e-6)
+
+            assert (dates == expected["Date"]).all()
+
+        expected["Date"] = expected["Date"].dt.strftime("%d/%m/%Y %H:%M")
+        expected.to_csv(filepath, index=False)
+
+        _, dates = read_csv(filepath)
+
+        assert dates == list(expected["Date"])
+
+    print("Successfully run `test_read_csv`.")
+
+test_read_csv()
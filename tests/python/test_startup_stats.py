@@ -0,0 +1,49 @@
+from rallyplot import Plotter
+from helpers import toy_ohlc, assert_images_equal
+import numpy as np
+import math
+
+
+def test_startup_stats():
+    """
+    Check the time to first frame is reported, in order, and that
+    the work deferred until after the first frame (uploading the
+    candlestick LOD levels not drawn) does not change the rendering.
+    """
+    open, high, low, close = toy_ohlc(200_000)
+
+    plotter = Plotter(headless=True)
+
+    stats = plotter.startup_stats()
+    assert math.isnan(stats["first_frame_ms"])
+    assert 0 <= stats["application_ms"] <= stats["window_setup_ms"]
+
+    plotter.candlestick(open, high, low, close)
+    plotter.scatter(np.arange(0, 200_000, 1000), close[::1000], linked_subplot_idx=0)
+
+    full_view = plotter.render_to_image(640, 480)
+
+    stats = plotter.startup_stats()
+    assert set(stats) == {
+        "application_ms", "window_setup_ms", "first_frame_ms",
+        "first_frame_draw_ms", "deferred_work_ms", "deferred_work_done_ms"
+    }
+    assert stats["window_setup_ms"] <= stats["first_frame_ms"]
+    assert 0 < stats["first_frame_draw_ms"] <= stats["first_frame_ms"]
+
+    # The finer levels are uploaded when first drawn if not yet uploaded
+    plotter.set_x_limits(1_000, 1_200)
+    zoomed = plotter.render_to_image(640, 480)
+    assert not np.array_equal(zoomed, full_view)
+
+    assert_images_equal(plotter.render_to_image(640, 480), zoomed)
+
+    # The first frame is only recorded once
+    assert plotter.startup_stats()["first_frame_ms"] == stats["first_frame_ms"]
+
+    plotter.finish()
+
+    print("Successfully run `test_startup_stats`.")
+
+
+test_startup_stats()
@@ -0,0 +1,43 @@
+from rallyplot import Plotter
+from helpers import toy_ohlc, render_headless, assert_images_equal
+import threading
+
+def test_ui_thread():
+    """
+    Check a plotter running its event loop on a UI thread can be called
+    from several Python threads, and renders the same as a plotter on
+    the calling thread.
+    """
+    open, high, low, close = toy_ohlc(2_000)
+
+    expected = render_headless(lambda plotter: plotter.candlestick(open, high, low, close))
+
+    plotter = Plotter(headless=True, ui_thread=True)
+
+    split = 1_000
+    plotter.candlestick(open[:split], high[:split], low[:split], close[:split])
+
+    def append(start, stop):
+        for i in range(start, stop, 100):
+            plotter.append_candles(open[i:i + 100], high[i:i + 100], low[i:i + 100], close[i:i + 100])
+
+    # Plotter calls from another thread run on the UI thread, in order
+    feed = threading.Thread(target=append, args=(split, open.size))
+    feed.start()
+    feed.join()
+
+    image = plotter.render_to_image(640, 480)
+
+    assert_images_equal(image, expected)
+
+    try:
+        plotter.start_async()
+        assert False, "start_async() did not raise on a headless plotter."
+    except ValueError as e:
+        assert "cannot be called on a headless Plotter" in str(e)
+
+    plotter.finish()
+
+    print("Successfully run `test_ui_thread`.")
+
+test_ui_thread()